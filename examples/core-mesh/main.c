@@ -0,0 +1,140 @@
+#define _GNU_SOURCE
+
+#include "stdio.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "pthread.h"
+#include "sched.h"
+#include "time.h"
+
+#include "../../src/active_object/active_object.h"
+#include "../../src/mailbox/mailbox.h"
+
+/* Shared-nothing runtime: every core runs its own Active Objects on a pinned thread,
+ * cores talk only through SPSC mailboxes. Measures core-to-core ping-pong round trip. */
+
+#define CORES_MAX               (2)
+#define MAILBOX_CAPACITY        (64)
+#define QUEUE_MAX_CAPACITY      (16)
+#define ROUND_TRIPS_MAX         (100000)
+
+typedef enum {
+    NO_SIG,
+    PING_SIG,
+    PONG_SIG,
+} PING_PONG_SIG;
+
+typedef struct {
+    uint32_t core;
+    int cpu;
+} CORE_CONTEXT;
+
+TMailbox mailboxes[CORES_MAX * CORES_MAX];
+TMailboxMessage messages[CORES_MAX * CORES_MAX * MAILBOX_CAPACITY];
+TMailboxMesh mesh;
+
+TEvent eventArrays[CORES_MAX][QUEUE_MAX_CAPACITY];
+TActiveObject activeObjects[CORES_MAX]; // one Active Object per core, owned by its thread
+
+uint64_t roundTrips[ROUND_TRIPS_MAX];
+uint32_t isRunning = 1;
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void pinToCpu(int cpu) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+
+    if (0 != pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)) {
+        printf("Can't pin to CPU %d, running unpinned\n", cpu);
+    }
+}
+
+static int compareU64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void *runCore(void *arg) {
+    CORE_CONTEXT *context = (CORE_CONTEXT *)arg;
+    const uint32_t core = context->core;
+    const uint32_t peer = (core + 1) % CORES_MAX;
+    TActiveObject *self = &activeObjects[core];
+    uint32_t roundTrip = 0;
+    uint64_t sentAt = 0;
+
+    pinToCpu(context->cpu);
+
+    // core 0 starts the game
+    if (0 == core) {
+        sentAt = nowNs();
+        MailboxMesh_Send(&mesh, core, peer, &activeObjects[peer], (TEvent){.sig = PING_SIG});
+    }
+
+    while (__atomic_load_n(&isRunning, __ATOMIC_RELAXED)) {
+        // Give the CPU away when idle, matters only if cores are oversubscribed
+        if (0 == MailboxMesh_Poll(&mesh, core) && EventQueue_IsEmpty(&self->queue)) {
+            sched_yield();
+            continue;
+        }
+
+        while (!EventQueue_IsEmpty(&self->queue)) {
+            TEvent event = ActiveObject_ProcessQueue(self);
+
+            if (PING_SIG == event.sig) {
+                MailboxMesh_Send(&mesh, core, peer, &activeObjects[peer], (TEvent){.sig = PONG_SIG});
+            } else if (PONG_SIG == event.sig) {
+                uint64_t now = nowNs();
+                roundTrips[roundTrip++] = now - sentAt;
+
+                if (ROUND_TRIPS_MAX == roundTrip) {
+                    __atomic_store_n(&isRunning, 0, __ATOMIC_RELAXED);
+                    break;
+                }
+
+                sentAt = now;
+                MailboxMesh_Send(&mesh, core, peer, &activeObjects[peer], (TEvent){.sig = PING_SIG});
+            }
+        }
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    pthread_t threads[CORES_MAX];
+    CORE_CONTEXT contexts[CORES_MAX];
+
+    MailboxMesh_Initialize(&mesh, mailboxes, messages, CORES_MAX, MAILBOX_CAPACITY);
+
+    printf("Starting core mesh ping-pong, %d round trips\n", ROUND_TRIPS_MAX);
+
+    for (uint32_t core = 0; core < CORES_MAX; core++) {
+        ActiveObject_Initialize(&activeObjects[core], core, eventArrays[core], QUEUE_MAX_CAPACITY);
+        // CPUs may be passed as args: ./core-mesh 2 6
+        contexts[core] = (CORE_CONTEXT){.core = core, .cpu = argc > (int)core + 1 ? atoi(argv[core + 1]) : (int)core};
+    }
+
+    for (uint32_t core = 0; core < CORES_MAX; core++) {
+        pthread_create(&threads[core], NULL, runCore, &contexts[core]);
+    }
+
+    for (uint32_t core = 0; core < CORES_MAX; core++) {
+        pthread_join(threads[core], NULL);
+    }
+
+    qsort(roundTrips, ROUND_TRIPS_MAX, sizeof(uint64_t), compareU64);
+
+    printf("Round trip, ns: p50 %llu, p99 %llu, p999 %llu, max %llu\n",
+           (unsigned long long)roundTrips[ROUND_TRIPS_MAX / 2],
+           (unsigned long long)roundTrips[ROUND_TRIPS_MAX * 99 / 100],
+           (unsigned long long)roundTrips[ROUND_TRIPS_MAX * 999 / 1000],
+           (unsigned long long)roundTrips[ROUND_TRIPS_MAX - 1]);
+
+    return 0;
+}
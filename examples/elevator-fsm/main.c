@@ -62,7 +62,7 @@ ELEVATOR_STATE handleMovingDown(Elevator *const elevator, ELEVATOR_EVENT event)
 }
 
 // Transition table
-ELEVATOR_EVENT_HANDLE_F transitionTable[STATES_MAX][EVENTS_MAX] = {
+const ELEVATOR_EVENT_HANDLE_F transitionTable[STATES_MAX][EVENTS_MAX] = {
         [IDLE][BUTTON_UP_PRESSED] = handleIdle,
         [IDLE][BUTTON_DOWN_PRESSED] = handleIdle,
         [MOVING_UP][BUTTON_UP_PRESSED] = handleMovingUp,
@@ -0,0 +1,143 @@
+#define _GNU_SOURCE
+
+#include "stdio.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+#ifndef NO_LIBNUMA
+#include "numa.h"
+#endif
+
+#include "../../src/active_object/active_object.h"
+#include "../../src/numa_placement/numa_placement.h"
+
+/* Local vs remote NUMA placement: a worker pinned to node 0 processes events of objects whose structs,
+ * rings and payloads live on node 0 (local) or on the last node (remote).
+ * Storages come from libnuma (numa_alloc_onnode, mbind underneath), build with -DNO_LIBNUMA
+ * or run on a single node machine to fall back to plain memory on node 0. */
+
+#define NODES_MAX               (64)
+#define OBJECTS_MAX             (16384)
+#define QUEUE_CAPACITY          (16)
+#define PAYLOADS_MAX            (OBJECTS_MAX * 4)
+#define EVENTS_MAX              (8000000)
+
+typedef enum {
+    NO_SIG,
+    SAMPLE_SIG,
+} NUMA_SIG;
+
+typedef struct {
+    uint64_t values[8];     /**< One cache line of data read by the handler */
+} SAMPLE_PAYLOAD;
+
+TNumaNode nodes[NODES_MAX];
+uint64_t dispatchCounts[NODES_MAX * NODES_MAX];
+TNumaPlacement placement;
+TActiveObject *objects[OBJECTS_MAX];
+uint64_t randomState = 0x9E3779B97F4A7C15ull;
+volatile uint64_t sink;
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t nextRandom(uint32_t bound) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return (uint32_t)((randomState >> 32) * bound >> 32);
+}
+
+static uint32_t getNodesCount(void) {
+#ifndef NO_LIBNUMA
+    if (numa_available() >= 0) {
+        uint32_t count = (uint32_t)numa_max_node() + 1;
+        return count < NODES_MAX ? count : NODES_MAX;
+    }
+#endif
+    return 1;
+}
+
+static void *allocateOnNode(size_t size, uint32_t node) {
+#ifndef NO_LIBNUMA
+    if (numa_available() >= 0) return numa_alloc_onnode(size, (int)node);
+#endif
+    return calloc(1, size);
+}
+
+static void runOnNode(uint32_t node) {
+#ifndef NO_LIBNUMA
+    if (numa_available() >= 0) numa_run_on_node((int)node);
+#endif
+}
+
+/* Random object of the node receives an event with a payload of the same node, then the worker processes it */
+static double run(uint32_t node) {
+    uint32_t objectsCount = 0;
+
+    for (uint32_t i = 0; i < OBJECTS_MAX; i++) {
+        objects[i] = NumaPlacement_CreateObject(&placement, node, i);
+        if (objects[i]) objectsCount++;
+    }
+
+    uint64_t sum = 0;
+    uint64_t start = nowNs();
+
+    for (uint32_t i = 0; i < EVENTS_MAX; i++) {
+        TActiveObject *object = objects[nextRandom(objectsCount)];
+        SAMPLE_PAYLOAD *sample = NumaPlacement_AllocatePayload(&placement, node);
+
+        sample->values[0] = i;
+        NumaPlacement_Dispatch(&placement, 0, object, (TEvent){.sig = SAMPLE_SIG, .payload = sample, .size = sizeof(*sample)});
+
+        TEvent event = ActiveObject_ProcessQueue(object);
+        sum += ((SAMPLE_PAYLOAD *)event.payload)->values[0];
+        NumaPlacement_ReleasePayload(&placement, event.payload);
+    }
+
+    double nsPerEvent = (double)(nowNs() - start) / EVENTS_MAX;
+
+    for (uint32_t i = 0; i < objectsCount; i++) NumaPlacement_DestroyObject(&placement, objects[i]);
+
+    sink = sum;
+    return nsPerEvent;
+}
+
+int main(void) {
+    uint32_t nodesCount = getNodesCount();
+    uint32_t remoteNode = nodesCount - 1;
+    size_t objectsSize = ACTIVE_OBJECT_POOL_STORAGE_UNITS(TActiveObject, QUEUE_CAPACITY, OBJECTS_MAX) * sizeof(TActiveObjectPoolUnit);
+    size_t payloadsSize = PAYLOADS_MAX * NUMA_PLACEMENT_PAYLOAD_BLOCK_SIZE(sizeof(SAMPLE_PAYLOAD));
+
+    NumaPlacement_Initialize(&placement, nodes, nodesCount, dispatchCounts);
+
+    for (uint32_t node = 0; node < nodesCount; node += remoteNode ? remoteNode : 1) {
+        void *objectsStorage = allocateOnNode(objectsSize, node);
+        void *payloadsStorage = allocateOnNode(payloadsSize, node);
+
+        if (!objectsStorage || !payloadsStorage
+            || !NumaPlacement_AddNode(&placement, node, objectsStorage, objectsSize, sizeof(TActiveObject), QUEUE_CAPACITY,
+                                      payloadsStorage, payloadsSize, sizeof(SAMPLE_PAYLOAD))) {
+            fprintf(stderr, "Failed to allocate node %u storages\n", node);
+            return 1;
+        }
+    }
+
+    runOnNode(0);
+
+    if (0 == remoteNode) printf("Single NUMA node (or no libnuma): remote placement equals local\n");
+
+    double localNs = run(0);
+    double remoteNs = run(remoteNode);
+
+    printf("{\"nodes\": %u, \"objects\": %u, \"events\": %u, \"localNs\": %.2f, \"remoteNs\": %.2f, "
+           "\"localDispatches\": %llu, \"crossNodeDispatches\": %llu}\n",
+           nodesCount, OBJECTS_MAX, EVENTS_MAX, localNs, remoteNs,
+           (unsigned long long)dispatchCounts[0], (unsigned long long)placement.crossNodeCount);
+    return 0;
+}
@@ -1,8 +1,8 @@
 #include "stdio.h"
 #include "stdint.h"
 
-#include "../../src/active-object/active_object.h"
-#include "../../src/active-object/active_object_impl.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/active_object/active_object_impl.h"
 #include "../../src/fsm/fsm.h"
 #include "../../src/fsm/fsm_impl.h"
 
@@ -60,10 +60,10 @@ REQUEST_STATE requestError(REQUEST_AO *const activeObject, REQUEST_EVENT event);
 REQUEST_STATE requestSuccess(REQUEST_AO *const activeObject, REQUEST_EVENT event);
 REQUEST_STATE processEventToNextState(REQUEST_AO *const activeObject, REQUEST_EVENT event);
 
-DECLARE_GUARD(REQUEST_AO, REQUEST_EVENT, canRetry, performRequest, requestError);
+DECLARE_TYPED_GUARD(REQUEST_AO, REQUEST_EVENT, canRetry, performRequest, requestError);
 
 // state transitions table, [state][event] => event handler f pointer
-REQUEST_EVENT_HANDLE_F requestTransitionTable[REQUEST_ST_MAX][REQUEST_SIG_MAX] = {
+const REQUEST_EVENT_HANDLE_F requestTransitionTable[REQUEST_ST_MAX][REQUEST_SIG_MAX] = {
         [REQUEST_NO_ST]=    {[MAKE_REQUEST_SIG]=performRequest},
         [PENDING_ST]=       {[REQUEST_SUCCESS_SIG]=requestSuccess, [REQUEST_ERROR_SIG]=GUARD(canRetry, performRequest, requestError), [TIMEOUT_SIG]=GUARD(canRetry, performRequest, requestError)}
 };
@@ -1,9 +1,10 @@
 #include "stdio.h"
 #include "stdint.h"
 
-#include "../../src/active-object/active_object.h"
-#include "../../src/active-object/active_object_impl.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/active_object/active_object_impl.h"
 #include "../../src/fsm/fsm.h"
+#include "../../src/fsm/fsm_impl.h"
 
 #define REQUEST_AO                      REQUEST_AO
 #define REQUEST_AO_ID                   (0)
@@ -46,6 +47,7 @@ typedef struct {
 DECLARE_ACTIVE_OBJECT(REQUEST_AO, REQUEST_EVENT, REQUEST_STATE, REQUEST_AO_FIELDS, REQUEST_QUEUE_MAX_CAPACITY);
 ACTIVE_OBJECT_IMPLEMENTATION(REQUEST_AO, REQUEST_EVENT, REQUEST_STATE, REQUEST_AO_FIELDS, REQUEST_QUEUE_MAX_CAPACITY);
 DECLARE_FSM(REQUEST_AO, REQUEST_EVENT, REQUEST_STATE, REQUEST_SIG_MAX, REQUEST_ST_MAX);
+FSM_IMPLEMENTATION(REQUEST_AO, REQUEST_EVENT, REQUEST_STATE, REQUEST_SIG_MAX, REQUEST_ST_MAX);
 
 /**
  * Application and local declarations
@@ -58,12 +60,12 @@ REQUEST_STATE performRequest(REQUEST_AO *const activeObject, REQUEST_EVENT event
 REQUEST_STATE waitForRetry(REQUEST_AO *const activeObject, REQUEST_EVENT event);
 REQUEST_STATE requestError(REQUEST_AO *const activeObject, REQUEST_EVENT event);
 REQUEST_STATE requestSuccess(REQUEST_AO *const activeObject, REQUEST_EVENT event);
-//REQUEST_STATE processEventToNextState(REQUEST_AO *const activeObject, REQUEST_EVENT event);
+REQUEST_STATE processEventToNextState(REQUEST_AO *const activeObject, REQUEST_EVENT event);
 
-DECLARE_GUARD(REQUEST_AO, REQUEST_EVENT, canRetry, waitForRetry, requestError);
+DECLARE_TYPED_GUARD(REQUEST_AO, REQUEST_EVENT, canRetry, waitForRetry, requestError);
 
 // state transitions table, [state][event] => state handler f pointer
-REQUEST_EVENT_HANDLE_F requestTransitionTable[REQUEST_ST_MAX][REQUEST_SIG_MAX] = {
+const REQUEST_EVENT_HANDLE_F requestTransitionTable[REQUEST_ST_MAX][REQUEST_SIG_MAX] = {
         [REQUEST_NO_ST]=    {[MAKE_REQUEST_SIG]=performRequest},
         [PENDING_ST]=       {[REQUEST_SUCCESS_SIG]=requestSuccess, [REQUEST_ERROR_SIG]=GUARD(canRetry, waitForRetry, requestError), [TIMEOUT_SIG]=GUARD(canRetry, waitForRetry, requestError)},
         [RETRY_WAIT_ST]=    {[MAKE_REQUEST_SIG]=performRequest}
@@ -72,9 +74,63 @@ REQUEST_EVENT_HANDLE_F requestTransitionTable[REQUEST_ST_MAX][REQUEST_SIG_MAX] =
 int main(void) {
     printf("Starting Request with retry FSM\n\n");
 
+    printf("Initializing Request Active Object\n\n");
+    REQUEST_AO_Ctor(&requestActiveObject, REQUEST_AO_ID, REQUEST_NO_ST, (REQUEST_AO_FIELDS){.maxRetries = MAX_RETRIES});
+
+    printf("Dispatching MAKE REQUEST Event\n");
+    REQUEST_AO_Dispatch(&requestActiveObject, (REQUEST_EVENT){.sig=MAKE_REQUEST_SIG});
+    runTasks();
+    printf("REQUEST AO state is: %s \n\n", STATES_STRINGS[requestActiveObject.state]);
+
+    printf("Dispatching ERROR Event\n");
+    REQUEST_AO_Dispatch(&requestActiveObject, (REQUEST_EVENT){.sig=REQUEST_ERROR_SIG});
+    runTasks();
+    printf("REQUEST AO state is: %s \n\n", STATES_STRINGS[requestActiveObject.state]);
+
+    printf("Dispatching MAKE REQUEST Event (retry)\n");
+    REQUEST_AO_Dispatch(&requestActiveObject, (REQUEST_EVENT){.sig=MAKE_REQUEST_SIG});
+    runTasks();
+    printf("REQUEST AO state is: %s \n\n", STATES_STRINGS[requestActiveObject.state]);
+
+    printf("Dispatching TIMEOUT Event\n");
+    REQUEST_AO_Dispatch(&requestActiveObject, (REQUEST_EVENT){.sig=TIMEOUT_SIG});
+    runTasks();
+    printf("REQUEST AO state is: %s \n\n", STATES_STRINGS[requestActiveObject.state]);
+
+    // reinit, happy path
+
+    printf("Initializing Request Active Object\n\n");
+    REQUEST_AO_Ctor(&requestActiveObject, REQUEST_AO_ID, REQUEST_NO_ST, (REQUEST_AO_FIELDS){.maxRetries = MAX_RETRIES});
+
+    printf("Dispatching MAKE REQUEST Event\n");
+    REQUEST_AO_Dispatch(&requestActiveObject, (REQUEST_EVENT){.sig=MAKE_REQUEST_SIG});
+    runTasks();
+    printf("REQUEST AO state is: %s \n\n", STATES_STRINGS[requestActiveObject.state]);
+
+    printf("Dispatching SUCCESS Event\n");
+    REQUEST_AO_Dispatch(&requestActiveObject, (REQUEST_EVENT){.sig=REQUEST_SUCCESS_SIG});
+    runTasks();
+    printf("REQUEST AO state is: %s \n\n", STATES_STRINGS[requestActiveObject.state]);
+
     return 0;
 };
 
+void runTasks() {
+    REQUEST_AO_ProcessQueue(&requestActiveObject, processEventToNextState, REQUEST_AO_basicTransitionToNextState, NULL);
+};
+
+REQUEST_STATE processEventToNextState(REQUEST_AO *const activeObject, REQUEST_EVENT event) {
+    REQUEST_STATE nextState = REQUEST_AO_FSM_ProcessEventToNextStateFromTransitionTable(activeObject, event, requestTransitionTable);
+
+    return nextState;
+};
+
+REQUEST_STATE performRequest(REQUEST_AO *const activeObject, REQUEST_EVENT event) {
+    printf("(fake request)\n");
+
+    return PENDING_ST;
+}
+
 bool canRetry(REQUEST_AO *const activeObject, REQUEST_EVENT event) {
     if (activeObject->fields.maxRetries > NO_RETRIES_LEFT) return true;
     return false;
@@ -82,6 +138,19 @@ bool canRetry(REQUEST_AO *const activeObject, REQUEST_EVENT event) {
 
 REQUEST_STATE waitForRetry(REQUEST_AO *const activeObject, REQUEST_EVENT event) {
     printf("Waiting for retry (MAKE_REQUEST) event\n");
+    activeObject->fields.maxRetries--;
 
     return RETRY_WAIT_ST;
 };
+
+REQUEST_STATE requestError(REQUEST_AO *const activeObject, REQUEST_EVENT event) {
+    printf("Request error occurs, no retries left\n");
+
+    return ERROR_ST;
+};
+
+REQUEST_STATE requestSuccess(REQUEST_AO *const activeObject, REQUEST_EVENT event) {
+    printf("Request success occurs\n");
+
+    return SUCCESS_ST;
+}
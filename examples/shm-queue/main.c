@@ -0,0 +1,152 @@
+#define _GNU_SOURCE
+
+#include "stdio.h"
+#include "stdint.h"
+#include "string.h"
+#include "time.h"
+#include "unistd.h"
+#include "linux/futex.h"
+#include "sys/mman.h"
+#include "sys/socket.h"
+#include "sys/syscall.h"
+#include "sys/wait.h"
+
+#include "../../src/shared_queue/shared_queue.h"
+
+/* Inter-process events through shared memory queues (memfd + futex wakeup)
+ * compared to a Unix socket round trip. */
+
+#define QUEUE_CAPACITY          (64)
+#define PAYLOAD_MAX_SIZE        (64)
+#define ROUND_TRIPS_MAX         (100000)
+
+typedef enum {
+    NO_SIG,
+    PING_SIG,
+    PONG_SIG,
+    STOP_SIG,
+} PING_PONG_SIG;
+
+typedef struct {
+    uint64_t sequence;
+    uint8_t data[32];
+} PING_PAYLOAD;
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void futexWake(uint32_t *const address) {
+    syscall(SYS_futex, address, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+/** Blocks until the queue has an event, then returns it (payload valid until SharedQueue_Release) */
+static TEvent waitEvent(TSharedQueue *queue) {
+    uint32_t *address;
+    uint32_t expected;
+
+    while (SharedQueue_IsEmpty(queue)) {
+        if (SharedQueue_PrepareWait(queue, &address, &expected)) {
+            syscall(SYS_futex, address, FUTEX_WAIT, expected, NULL, NULL, 0);
+        }
+    }
+
+    return SharedQueue_Peek(queue);
+}
+
+static double benchmarkSharedQueue(void) {
+    size_t queueSize = SharedQueue_GetRegionSize(QUEUE_CAPACITY, PAYLOAD_MAX_SIZE);
+    int memfd = memfd_create("ao-shm-queue", 0);
+
+    if (memfd < 0 || 0 != ftruncate(memfd, (off_t)(2 * queueSize))) return -1.0;
+
+    uint8_t *region = mmap(NULL, 2 * queueSize, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    TSharedQueue pingQueue, pongQueue;
+
+    SharedQueue_Create(&pingQueue, region, queueSize, QUEUE_CAPACITY, PAYLOAD_MAX_SIZE);
+    SharedQueue_Create(&pongQueue, region + queueSize, queueSize, QUEUE_CAPACITY, PAYLOAD_MAX_SIZE);
+
+    if (0 == fork()) {
+        // Child maps the same memfd at its own address, queues are position independent
+        uint8_t *childRegion = mmap(NULL, 2 * queueSize, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+        TSharedQueue childPingQueue, childPongQueue;
+
+        SharedQueue_Attach(&childPingQueue, childRegion, queueSize);
+        SharedQueue_Attach(&childPongQueue, childRegion + queueSize, queueSize);
+        SharedQueue_SetWake(&childPongQueue, futexWake);
+
+        for (;;) {
+            TEvent event = waitEvent(&childPingQueue);
+            if (STOP_SIG == event.sig) _exit(0);
+
+            SharedQueue_Enqueue(&childPongQueue, (TEvent){.sig = PONG_SIG, .payload = event.payload, .size = event.size});
+            SharedQueue_Release(&childPingQueue);
+        }
+    }
+
+    SharedQueue_SetWake(&pingQueue, futexWake);
+    PING_PAYLOAD payload = {0};
+    uint64_t startedAt = nowNs();
+
+    for (uint32_t i = 0; i < ROUND_TRIPS_MAX; i++) {
+        payload.sequence = i;
+        SharedQueue_Enqueue(&pingQueue, (TEvent){.sig = PING_SIG, .payload = &payload, .size = sizeof(payload)});
+        waitEvent(&pongQueue);
+        SharedQueue_Release(&pongQueue);
+    }
+
+    double roundTripNs = (double)(nowNs() - startedAt) / ROUND_TRIPS_MAX;
+
+    SharedQueue_Enqueue(&pingQueue, (TEvent){.sig = STOP_SIG});
+    wait(NULL);
+    munmap(region, 2 * queueSize);
+    close(memfd);
+
+    return roundTripNs;
+}
+
+static double benchmarkUnixSocket(void) {
+    int sockets[2];
+    PING_PAYLOAD payload = {0};
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sockets)) return -1.0;
+
+    if (0 == fork()) {
+        PING_PAYLOAD childPayload;
+
+        close(sockets[0]);
+
+        while (sizeof(childPayload) == read(sockets[1], &childPayload, sizeof(childPayload))) {
+            if (sizeof(childPayload) != write(sockets[1], &childPayload, sizeof(childPayload))) break;
+        }
+        _exit(0);
+    }
+
+    close(sockets[1]);
+    uint64_t startedAt = nowNs();
+
+    for (uint32_t i = 0; i < ROUND_TRIPS_MAX; i++) {
+        payload.sequence = i;
+        if (sizeof(payload) != write(sockets[0], &payload, sizeof(payload))) return -1.0;
+        if (sizeof(payload) != read(sockets[0], &payload, sizeof(payload))) return -1.0;
+    }
+
+    double roundTripNs = (double)(nowNs() - startedAt) / ROUND_TRIPS_MAX;
+
+    close(sockets[0]);
+    wait(NULL);
+
+    return roundTripNs;
+}
+
+int main(void) {
+    printf("Inter-process ping-pong, %d round trips, %zu bytes payload\n", ROUND_TRIPS_MAX, sizeof(PING_PAYLOAD));
+    fflush(stdout); // don't duplicate buffered output in forked children
+    printf("Shared memory queue: %.0f ns per round trip\n", benchmarkSharedQueue());
+    fflush(stdout);
+    printf("Unix socket:         %.0f ns per round trip\n", benchmarkUnixSocket());
+
+    return 0;
+}
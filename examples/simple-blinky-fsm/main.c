@@ -1,8 +1,8 @@
 #include "stdio.h"
 #include "stdint.h"
 
-#include "../../src/active-object/active_object.h"
-#include "../../src/active-object/active_object_impl.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/active_object/active_object_impl.h"
 
 #define BLINKY_AO                   BLINKY_AO
 #define BLINKY_QUEUE_MAX_CAPACITY   (8)
@@ -0,0 +1,110 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "stdio.h"
+#include "stdint.h"
+#include "time.h"
+
+#include "../../src/active_object/active_object.h"
+#include "../../src/fsm/fsm.h"
+#include "../../src/simulation/simulation.h"
+
+/* Blinky machines with timer-driven periods run under the virtual clock: the simulation jumps
+ * from one timer to the next, so hours of blinking take milliseconds. Handlers and hooks are plain
+ * table and hook code, the timer service of the port is Simulation_Schedule here. */
+
+#define BLINKIES_MAX            (8)
+#define QUEUE_CAPACITY          (4)
+#define US_PER_SECOND           (1000000ull)
+#define BASE_PERIOD_US          (500000ull)
+#define SIMULATED_SECONDS       (24ull * 3600ull)
+
+typedef enum {
+    BLINKY_NO_SIG,
+    BLINKY_START_SIG,
+    BLINKY_TIMEOUT_SIG,
+    BLINKY_MAX_SIG,
+} BLINKY_SIG;
+
+typedef enum {
+    BLINKY_NO_ST,
+    BLINKY_LED_OFF_ST,
+    BLINKY_LED_ON_ST,
+    BLINKY_MAX_ST,
+} BLINKY_STATE;
+
+typedef struct {
+    TActiveObject super;
+    uint64_t periodUs;      /**< Half of the blinking period */
+    uint64_t flashesCount;  /**< Number of LED_ON entries */
+} TBlinky;
+
+bool startPeriod(TActiveObject *const activeObject, void *const ctx);
+bool flash(TActiveObject *const activeObject, void *const ctx);
+const TState *toggle(TActiveObject *const activeObject, TEvent event);
+
+const TState states[BLINKY_MAX_ST] = {
+        [BLINKY_NO_ST] = EMPTY_STATE,
+        [BLINKY_LED_OFF_ST] = {.name = BLINKY_LED_OFF_ST, .onEnter = startPeriod},
+        [BLINKY_LED_ON_ST] = {.name = BLINKY_LED_ON_ST, .onEnter = flash},
+};
+
+const TEventHandler transitionTable[BLINKY_MAX_ST][BLINKY_MAX_SIG] = {
+        [BLINKY_LED_OFF_ST] = {[BLINKY_START_SIG] = toggle, [BLINKY_TIMEOUT_SIG] = toggle},
+        [BLINKY_LED_ON_ST] = {[BLINKY_TIMEOUT_SIG] = toggle},
+};
+
+TSimulationEvent calendar[BLINKIES_MAX * 2];
+TSimulationObject objects[BLINKIES_MAX];
+TSimulation simulation;
+TEvent eventArrays[BLINKIES_MAX][QUEUE_CAPACITY];
+TBlinky blinkies[BLINKIES_MAX];
+
+bool startPeriod(TActiveObject *const activeObject, void *const ctx) {
+    TBlinky *blinky = (TBlinky *) activeObject;
+
+    return SIMULATION_INVALID_TIMER != Simulation_Schedule(&simulation, activeObject,
+                                                           (TEvent){.sig = BLINKY_TIMEOUT_SIG}, blinky->periodUs);
+}
+
+bool flash(TActiveObject *const activeObject, void *const ctx) {
+    ((TBlinky *) activeObject)->flashesCount++;
+    return startPeriod(activeObject, ctx);
+}
+
+const TState *toggle(TActiveObject *const activeObject, TEvent event) {
+    return &states[BLINKY_LED_ON_ST == activeObject->state->name ? BLINKY_LED_OFF_ST : BLINKY_LED_ON_ST];
+}
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int main(void) {
+    Simulation_Initialize(&simulation, calendar, BLINKIES_MAX * 2, objects, BLINKIES_MAX);
+
+    // Blinkies with co-prime-ish periods, so their timers interleave
+    for (uint32_t i = 0; i < BLINKIES_MAX; i++) {
+        TBlinky *blinky = &blinkies[i];
+
+        ActiveObject_Initialize(&blinky->super, i, eventArrays[i], QUEUE_CAPACITY);
+        blinky->super.state = &states[BLINKY_LED_OFF_ST];
+        blinky->periodUs = BASE_PERIOD_US + i * 1000ull;
+        blinky->flashesCount = 0;
+
+        Simulation_AddObject(&simulation, &blinky->super, BLINKY_MAX_ST, BLINKY_MAX_SIG, &transitionTable[0][0]);
+        Simulation_Schedule(&simulation, &blinky->super, (TEvent){.sig = BLINKY_START_SIG}, 0);
+    }
+
+    uint64_t start = nowNs();
+    uint64_t processedCount = Simulation_Run(&simulation, SIMULATED_SECONDS * US_PER_SECOND);
+    double realSeconds = (double)(nowNs() - start) / 1e9;
+
+    printf("{\"blinkies\": %u, \"simulatedSeconds\": %llu, \"events\": %llu, \"flashes0\": %llu, "
+           "\"realSeconds\": %.3f, \"simulatedSecondsPerSecond\": %.0f, \"eventsPerSecond\": %.0f}\n",
+           BLINKIES_MAX, SIMULATED_SECONDS, (unsigned long long)processedCount,
+           (unsigned long long)blinkies[0].flashesCount, realSeconds,
+           (double)SIMULATED_SECONDS / realSeconds, (double)processedCount / realSeconds);
+    return 0;
+}
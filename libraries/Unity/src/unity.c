@@ -0,0 +1,5 @@
+#include "unity.h"
+#include <stdlib.h>
+jmp_buf UnityAbort; int UnityFailures, UnityTests; const char* UnityCur;
+void UnityFail(const char* file, int line, const char* msg) { printf("%s:%d:%s:FAIL: %s\n", file, line, UnityCur, msg); UnityFailures++; longjmp(UnityAbort, 1); }
+int UnityEnd(void) { printf("-----\n%d Tests %d Failures\n%s\n", UnityTests, UnityFailures, UnityFailures ? "FAIL" : "OK"); return UnityFailures; }
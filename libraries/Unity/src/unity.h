@@ -0,0 +1,47 @@
+/* Local verification shim (not committed): minimal subset of Unity API. */
+#ifndef UNITY_SHIM_H
+#define UNITY_SHIM_H
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+extern jmp_buf UnityAbort; extern int UnityFailures, UnityTests; extern const char* UnityCur;
+void setUp(void); void tearDown(void);
+void UnityFail(const char* file, int line, const char* msg);
+int UnityEnd(void);
+#define UNITY_BEGIN() (UnityFailures = 0, UnityTests = 0)
+#define UNITY_END() UnityEnd()
+#define RUN_TEST(f) do { UnityCur = #f; UnityTests++; if (!setjmp(UnityAbort)) { setUp(); f(); tearDown(); printf("%s:PASS\n", #f);} } while (0)
+#define UASSERT(c, m) do { if (!(c)) UnityFail(__FILE__, __LINE__, m); } while (0)
+#define TEST_ASSERT(c) UASSERT((c), #c)
+#define TEST_ASSERT_TRUE(c) UASSERT((c), #c)
+#define TEST_ASSERT_FALSE(c) UASSERT(!(c), "!" #c)
+#define TEST_ASSERT_TRUE_MESSAGE(c, m) UASSERT((c), m)
+#define TEST_ASSERT_NULL(p) UASSERT((p) == NULL, #p " not NULL")
+#define TEST_ASSERT_NOT_NULL(p) UASSERT((p) != NULL, #p " NULL")
+#define TEST_ASSERT_EQUAL(a, b) UASSERT((long long)(a) == (long long)(b), #a " != " #b)
+#define TEST_ASSERT_NOT_EQUAL(a, b) UASSERT((long long)(a) != (long long)(b), #a " == " #b)
+#define TEST_ASSERT_EQUAL_INT(a, b) TEST_ASSERT_EQUAL(a, b)
+#define TEST_ASSERT_EQUAL_INT8(a, b) TEST_ASSERT_EQUAL(a, b)
+#define TEST_ASSERT_EQUAL_INT16(a, b) TEST_ASSERT_EQUAL(a, b)
+#define TEST_ASSERT_EQUAL_INT32(a, b) TEST_ASSERT_EQUAL(a, b)
+#define TEST_ASSERT_EQUAL_UINT(a, b) TEST_ASSERT_EQUAL(a, b)
+#define TEST_ASSERT_EQUAL_UINT8(a, b) TEST_ASSERT_EQUAL(a, b)
+#define TEST_ASSERT_EQUAL_UINT16(a, b) TEST_ASSERT_EQUAL(a, b)
+#define TEST_ASSERT_EQUAL_UINT32(a, b) TEST_ASSERT_EQUAL(a, b)
+#define TEST_ASSERT_EQUAL_UINT64(a, b) UASSERT((uint64_t)(a) == (uint64_t)(b), #a " != " #b)
+#define TEST_ASSERT_EQUAL_size_t(a, b) TEST_ASSERT_EQUAL_UINT64(a, b)
+#define TEST_ASSERT_EQUAL_PTR(a, b) UASSERT((const void*)(a) == (const void*)(b), #a " != " #b)
+#define TEST_ASSERT_NOT_EQUAL_PTR(a, b) UASSERT((const void*)(a) != (const void*)(b), #a " == " #b)
+#define TEST_ASSERT_EQUAL_STRING(a, b) UASSERT(strcmp((a), (b)) == 0, #a " != " #b)
+#define TEST_ASSERT_EQUAL_MEMORY(a, b, n) UASSERT(memcmp((a), (b), (n)) == 0, #a " != " #b)
+#define TEST_ASSERT_EQUAL_INT_ARRAY(a, b, n) do { for (size_t _i = 0; _i < (size_t)(n); _i++) UASSERT((a)[_i] == (b)[_i], #a "[] != " #b "[]"); } while (0)
+#define TEST_ASSERT_EQUAL_UINT8_ARRAY TEST_ASSERT_EQUAL_INT_ARRAY
+#define TEST_ASSERT_EQUAL_UINT32_ARRAY TEST_ASSERT_EQUAL_INT_ARRAY
+#define TEST_ASSERT_GREATER_THAN(t, a) UASSERT((long long)(a) > (long long)(t), #a " <= " #t)
+#define TEST_ASSERT_GREATER_OR_EQUAL(t, a) UASSERT((long long)(a) >= (long long)(t), #a " < " #t)
+#define TEST_ASSERT_LESS_THAN(t, a) UASSERT((long long)(a) < (long long)(t), #a " >= " #t)
+#define TEST_ASSERT_LESS_OR_EQUAL(t, a) UASSERT((long long)(a) <= (long long)(t), #a " > " #t)
+#define TEST_FAIL_MESSAGE(m) UnityFail(__FILE__, __LINE__, m)
+#define TEST_IGNORE() longjmp(UnityAbort, 2)
+#endif
@@ -1,19 +1,129 @@
 #include "./active_object.h"
 
-void ActiveObject_Initialize(TActiveObject* me, const uint8_t id, TEvent* events, uint32_t capacity) {
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+/** @brief Dispatches an event through the signal filter, kept off the unfiltered dispatch path */
+static TDispatchResult _dispatchFiltered(TActiveObject* me, TEvent event);
+
+/** @brief Checks the signal bit in the bitmap */
+static inline bool _isSignalSet(const TSignalMask *mask, uint32_t sig);
+
+/** @brief Checks if the current state has a handler for the signal, unknown states and signals pass */
+static inline bool _isAccepted(const TActiveObject* me, int sig);
+#endif
+
+void ActiveObject_Initialize(TActiveObject* me, const uint32_t id, TEvent* events, uint32_t capacity) {
     me->id = id;
     me->state = NULL;
+    me->resume = 0;
+    me->filter = NULL;
+    me->rejectedCount = 0;
     EventQueue_Initialize(&me->queue, events, capacity);
+    EventQueue_Initialize(&me->deferredQueue, NULL, 0);
+}
+
+bool ActiveObject_Dispatch(TActiveObject* me, TEvent event) {
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+    if (me->filter) {
+        TDispatchResult result = _dispatchFiltered(me, event);
+        return ACTIVE_OBJECT_DISPATCH_ENQUEUED == result || ACTIVE_OBJECT_DISPATCH_DEFERRED == result;
+    }
+#endif
+
+    return EventQueue_Enqueue(&me->queue, event);
+}
+
+TDispatchResult ActiveObject_Submit(TActiveObject* me, TEvent event) {
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+    if (me->filter) {
+        return _dispatchFiltered(me, event);
+    }
+#endif
+
+    return EventQueue_Enqueue(&me->queue, event) ? ACTIVE_OBJECT_DISPATCH_ENQUEUED : ACTIVE_OBJECT_DISPATCH_FULL;
 }
 
-void ActiveObject_Dispatch(TActiveObject* me, TEvent event) {
-    EventQueue_Enqueue(&me->queue, event);
+uint32_t ActiveObject_DispatchBulk(TActiveObject* me, const TEvent* events, uint32_t count) {
+    if (NULL == me->filter) {
+        return EventQueue_EnqueueBulk(&me->queue, events, count);
+    }
+
+    uint32_t i = 0;
+
+    // Stop on a full queue only, rejected events are taken
+    for (; i < count; i++) {
+        if (ACTIVE_OBJECT_DISPATCH_FULL == ActiveObject_Submit(me, events[i])) break;
+    }
+
+    return i;
+}
+
+bool ActiveObject_SetSignalFilter(TActiveObject* me, const TSignalFilter* filter) {
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+    me->filter = filter;
+    return true;
+#else
+    (void) me;
+    return NULL == filter;
+#endif
 }
 
 TEvent ActiveObject_ProcessQueue(TActiveObject* me) {
     if (EventQueue_IsEmpty(&me->queue)) {
-        return (TEvent){.sig = 0, .payload = NULL, .size = 0};
+        return EVENT_EMPTY;
     };
 
     return EventQueue_Dequeue(&me->queue);
 }
+
+void ActiveObject_InitializeDeferredQueue(TActiveObject* me, TEvent* events, uint32_t capacity) {
+    EventQueue_Initialize(&me->deferredQueue, events, capacity);
+}
+
+bool ActiveObject_Defer(TActiveObject* me, TEvent event) {
+    if (0 == me->deferredQueue.capacity) {
+        return false;
+    }
+
+    return EventQueue_Enqueue(&me->deferredQueue, event);
+}
+
+bool ActiveObject_RecallOne(TActiveObject* me) {
+    return 1 == EventQueue_MoveToFront(&me->queue, &me->deferredQueue, 1);
+}
+
+uint32_t ActiveObject_RecallAll(TActiveObject* me) {
+    return EventQueue_MoveToFront(&me->queue, &me->deferredQueue, EventQueue_GetSize(&me->deferredQueue));
+}
+
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+static TDispatchResult _dispatchFiltered(TActiveObject* me, TEvent event) {
+    if (_isAccepted(me, EVENT_SIG(event))) {
+        return EventQueue_Enqueue(&me->queue, event) ? ACTIVE_OBJECT_DISPATCH_ENQUEUED : ACTIVE_OBJECT_DISPATCH_FULL;
+    }
+
+    // Unhandled deferrable signals wait in the deferred queue for a state that handles them
+    if (me->filter->deferrable && _isSignalSet(me->filter->deferrable, (uint32_t) EVENT_SIG(event))
+        && ActiveObject_Defer(me, event)) {
+        return ACTIVE_OBJECT_DISPATCH_DEFERRED;
+    }
+
+    me->rejectedCount++;
+    return ACTIVE_OBJECT_DISPATCH_REJECTED;
+}
+
+static inline bool _isSignalSet(const TSignalMask *mask, uint32_t sig) {
+    return 0 != (mask[sig / 32u] & (1u << (sig % 32u)));
+}
+
+static inline bool _isAccepted(const TActiveObject* me, int sig) {
+    const TSignalFilter *filter = me->filter;
+
+    if (NULL == me->state || sig < 0 || (uint32_t) sig >= filter->eventsMax) return true;
+
+    const uint32_t stateName = (uint32_t) me->state->name;
+
+    if (stateName >= filter->statesMax) return true;
+
+    return _isSignalSet(&filter->accepted[stateName * ACTIVE_OBJECT_SIGNAL_MASK_WORDS(filter->eventsMax)], (uint32_t) sig);
+}
+#endif
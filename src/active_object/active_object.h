@@ -30,7 +30,7 @@
  * TState statesList[STATES_MAX] = { [STATE_1] = {.name = STATE_1, .onEnter = NULL, .onTraverse = NULL, .onExit = NULL} };
  * 
  * // sub Active Object constructor
- * void TSubActiveObject_Initialize(TSubActiveObject* me, const uint8_t id, TEvent* events, uint32_t capacity) {
+ * void TSubActiveObject_Initialize(TSubActiveObject* me, const uint32_t id, TEvent* events, uint32_t capacity) {
  *      ActiveObject_Initialize(&(me->super), id, events, capacity);
  *      me->additionalField = false;
  *  }} 
@@ -56,6 +56,28 @@
 
 typedef struct TActiveObject TActiveObject;
 
+/** @brief Signals bitmap word, bit (sig % 32) of word (sig / 32) stands for the signal */
+typedef uint32_t TSignalMask;
+
+/** @brief Number of bitmap words for signals [0, EVENTS_MAX) */
+#define ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX) (((EVENTS_MAX) + 31u) / 32u)
+
+/** @brief Dispatch-time signal filter, shared by the objects of the same machine. @see FSM_CompileAcceptedSignals */
+typedef struct {
+    const TSignalMask *accepted; /**< Signals with handlers, [state name][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(eventsMax)]. */
+    const TSignalMask *deferrable; /**< Signals deferred instead of rejected when unhandled, [ACTIVE_OBJECT_SIGNAL_MASK_WORDS(eventsMax)], may be NULL. */
+    uint32_t statesMax; /**< The maximum number of states. */
+    uint32_t eventsMax; /**< The maximum number of events. */
+} TSignalFilter;
+
+/** @brief Outcome of a dispatch through the signal filter. @see ActiveObject_Submit */
+typedef enum {
+    ACTIVE_OBJECT_DISPATCH_FULL, /**< Not taken, the queue is full: retry later. */
+    ACTIVE_OBJECT_DISPATCH_ENQUEUED, /**< Enqueued into the event queue. */
+    ACTIVE_OBJECT_DISPATCH_DEFERRED, /**< Unhandled deferrable signal, put into the deferred queue. */
+    ACTIVE_OBJECT_DISPATCH_REJECTED, /**< Unhandled signal, dropped and counted in rejectedCount: never retry. */
+} TDispatchResult;
+
 /** @brief Function pointer type for state hooks.
  *
  *  @param activeObject Pointer to the active object.
@@ -74,9 +96,13 @@ typedef struct {
 
 /** @brief Struct representing an active object. */
 struct TActiveObject {
-    uint8_t id; /**< Object ID. */
+    uint32_t id; /**< Object ID. */
     const TState *state; /**< Pointer to the current state. */
     TEventQueue queue; /**< Event queue. */
+    TEventQueue deferredQueue; /**< Deferred events queue, has no capacity until ActiveObject_InitializeDeferredQueue. */
+    uint32_t resume; /**< Resume point of a coroutine handler of the current state, 0 to start over. @see coroutine.h */
+    const TSignalFilter *filter; /**< Dispatch-time signal filter, NULL to enqueue every signal. */
+    uint32_t rejectedCount; /**< Number of events rejected by the filter. */
 };
 
 /** @brief Initialize an active object.
@@ -94,20 +120,79 @@ struct TActiveObject {
  *  ActiveObject_Initialize(&activeObject, 1, eventArray, 10);
  *  @endcode
  */
-void ActiveObject_Initialize(TActiveObject* me, const uint8_t id, TEvent* events, uint32_t capacity);
+void ActiveObject_Initialize(TActiveObject* me, const uint32_t id, TEvent* events, uint32_t capacity);
 
 /** @brief Dispatch an event to the active object.
+ *  @details With a signal filter set (ACTIVE_OBJECT_SIGNAL_FILTER builds), a signal the current state has no handler for
+ *  is not enqueued: a deferrable one goes to the deferred queue, any other one is rejected and counted in rejectedCount.
  *
  *  @param me Pointer to the active object.
  *  @param event The event to be dispatched.
+ *  @return true if the event was enqueued or deferred, false if the queue is full or the signal is rejected.
+ *  A caller keeping a not taken event for a retry should tell the two apart with ActiveObject_Submit.
  *
  *  ### Example:
  *  @code
- *  TEvent myEvent = {1, NULL, 0};
+ *  TEvent myEvent = EVENT_MAKE(1, NULL, 0);
  *  ActiveObject_Dispatch(&activeObject, myEvent);
  *  @endcode
  */
-void ActiveObject_Dispatch(TActiveObject* me, TEvent event);
+bool ActiveObject_Dispatch(TActiveObject* me, TEvent event);
+
+/** @brief Dispatch an event to the active object and report what happened to it.
+ *  @details Same as ActiveObject_Dispatch, without a signal filter the result is ENQUEUED or FULL.
+ *
+ *  @param me Pointer to the active object.
+ *  @param event The event to be dispatched.
+ *  @return ACTIVE_OBJECT_DISPATCH_FULL if the queue is full, the event may be dispatched again later,
+ *  ENQUEUED or DEFERRED if the event is taken, REJECTED if the current state doesn't handle the signal.
+ *
+ *  ### Example:
+ *  @code
+ *  // Keep the event for a retry on a full queue only, a rejected one would never be taken
+ *  if (ACTIVE_OBJECT_DISPATCH_FULL == ActiveObject_Submit(&activeObject, event)) return false;
+ *  @endcode
+ */
+TDispatchResult ActiveObject_Submit(TActiveObject* me, TEvent event);
+
+/** @brief Dispatch events to the active object in bulk, keeping their order.
+ *  @details With a signal filter set, the events are filtered one by one as by ActiveObject_Dispatch.
+ *
+ *  @param me Pointer to the active object.
+ *  @param events The events to be dispatched.
+ *  @param count Number of events.
+ *  @return Number of taken events (enqueued, deferred or rejected), less than count if the queue is full.
+ *
+ *  ### Example:
+ *  @code
+ *  TEvent samples[3] = {EVENT_MAKE(SAMPLE_SIG, &a, sizeof(a)), EVENT_MAKE(SAMPLE_SIG, &b, sizeof(b)), EVENT_MAKE(FLUSH_SIG, NULL, 0)};
+ *  ActiveObject_DispatchBulk(&activeObject, samples, 3);
+ *  @endcode
+ */
+uint32_t ActiveObject_DispatchBulk(TActiveObject* me, const TEvent* events, uint32_t count);
+
+/** @brief Set the dispatch-time signal filter of the active object.
+ *  @details The filter check is compiled in with ACTIVE_OBJECT_SIGNAL_FILTER defined for the library build only,
+ *  otherwise the unfiltered dispatch path stays a plain enqueue the compiler can fold into the caller loop.
+ *  @note The filter reads the current state at dispatch time, so an event accepted by the state
+ *  may still reach a NULL transition table cell after a state change in between.
+ *
+ *  @param me Pointer to the active object.
+ *  @param filter The filter, NULL to enqueue every signal.
+ *  @return true for success, false for a filter in a build without ACTIVE_OBJECT_SIGNAL_FILTER.
+ *
+ *  ### Example:
+ *  @code
+ *  TSignalMask accepted[STATES_MAX][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)];
+ *  TSignalMask deferrable[ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)] = {1u << MAKE_REQUEST_SIG};
+ *
+ *  FSM_CompileAcceptedSignals(STATES_MAX, EVENTS_MAX, NULL, transitionTable, accepted);
+ *  const TSignalFilter filter = {.accepted = &accepted[0][0], .deferrable = deferrable,
+ *                                .statesMax = STATES_MAX, .eventsMax = EVENTS_MAX};
+ *  ActiveObject_SetSignalFilter(&activeObject, &filter);
+ *  @endcode
+ */
+bool ActiveObject_SetSignalFilter(TActiveObject* me, const TSignalFilter* filter);
 
 /** @brief Process the queue of the active object and return an event.
  *
@@ -121,4 +206,53 @@ void ActiveObject_Dispatch(TActiveObject* me, TEvent event);
  */
 TEvent ActiveObject_ProcessQueue(TActiveObject* me);
 
+/** @brief Set up the deferred events queue of the active object.
+ *  @note The events array must be allocated by the user.
+ *
+ *  @param me Pointer to the active object.
+ *  @param events Pointer to the deferred events array.
+ *  @param capacity Capacity of the deferred events queue.
+ *
+ *  ### Example:
+ *  @code
+ *  TEvent deferredEventArray[4];
+ *  ActiveObject_InitializeDeferredQueue(&activeObject, deferredEventArray, 4);
+ *  @endcode
+ */
+void ActiveObject_InitializeDeferredQueue(TActiveObject* me, TEvent* events, uint32_t capacity);
+
+/** @brief Defer an event: keep it aside until recalled, e.g. after the current operation finishes.
+ *
+ *  @param me Pointer to the active object.
+ *  @param event The event to be deferred.
+ *  @return true if the event was deferred, false if the deferred queue is full or not set up.
+ *
+ *  ### Example:
+ *  @code
+ *  // MAKE_REQUEST_SIG arrives in PENDING_ST
+ *  ActiveObject_Defer(activeObject, event);
+ *  @endcode
+ */
+bool ActiveObject_Defer(TActiveObject* me, TEvent event);
+
+/** @brief Recall the oldest deferred event to the front of the active object queue.
+ *
+ *  @param me Pointer to the active object.
+ *  @return true if an event was recalled, false if there is nothing to recall or the queue is full.
+ */
+bool ActiveObject_RecallOne(TActiveObject* me);
+
+/** @brief Recall all deferred events to the front of the active object queue in bulk, keeping their order.
+ *
+ *  @param me Pointer to the active object.
+ *  @return Number of recalled events, limited by the queue free space.
+ *
+ *  ### Example:
+ *  @code
+ *  // onExit hook of PENDING_ST
+ *  ActiveObject_RecallAll(activeObject);
+ *  @endcode
+ */
+uint32_t ActiveObject_RecallAll(TActiveObject* me);
+
 #endif //ACTIVE_OBJECT_H
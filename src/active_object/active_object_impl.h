@@ -0,0 +1,143 @@
+/**
+ * @file active_object_impl.h
+ *
+ * @brief Type-specialized Active Object generator
+ * @see active_object.h for the generic Active Object.
+ *
+ * @details Generates an Active Object type, its event queue and operations
+ * for a user-defined event type, state enum and additional fields type.
+ * Compared to the generic TActiveObject:
+ * - queue slots are exactly sizeof(EVENT_TYPE) and live inside the object, no TEvent casts;
+ * - the state is a plain enum value, no TState* indirection;
+ * - all operations are static inline, so handlers passed to ProcessQueue
+ *   become direct calls once inlined.
+ *
+ * ### Example:
+ * @code
+ * #define BLINKY_AO BLINKY_AO
+ * typedef enum { BLINKY_NO_SIG, BLINKY_LED_ON_SIG, BLINKY_MAX_SIG } BLINKY_SIG;
+ * typedef enum { BLINKY_NO_ST, BLINKY_LED_ON_ST, BLINKY_MAX_ST } BLINKY_STATE;
+ * typedef struct { BLINKY_SIG sig; void* payload; } BLINKY_EVENT;
+ *
+ * DECLARE_ACTIVE_OBJECT(BLINKY_AO, BLINKY_EVENT, BLINKY_STATE, void*, BLINKY_QUEUE_MAX_CAPACITY);
+ * ACTIVE_OBJECT_IMPLEMENTATION(BLINKY_AO, BLINKY_EVENT, BLINKY_STATE, void*, BLINKY_QUEUE_MAX_CAPACITY);
+ *
+ * BLINKY_AO blinkyActiveObject;
+ *
+ * BLINKY_AO_Ctor(&blinkyActiveObject, AO_BLINKY_ID, BLINKY_NO_ST, NULL);
+ * BLINKY_AO_Dispatch(&blinkyActiveObject, (BLINKY_EVENT){.sig = BLINKY_LED_ON_SIG});
+ * BLINKY_AO_ProcessQueue(&blinkyActiveObject, processEventToNextState, BLINKY_AO_basicTransitionToNextState, NULL);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef ACTIVE_OBJECT_IMPL_H
+#define ACTIVE_OBJECT_IMPL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Active Object declaration macro: types and prototypes
+ * @details Declares:
+ * - AO_TYPE##_QUEUE: fixed-size circular queue of EVENT_TYPE;
+ * - AO_TYPE: the Active Object with id, state, fields and queue;
+ * - AO_TYPE##_PROCESS_EVENT_TO_NEXT_STATE_F: event => next state function type;
+ * - AO_TYPE##_TRANSITION_TO_NEXT_STATE_F: next state => transition function type.
+ */
+#define DECLARE_ACTIVE_OBJECT(AO_TYPE, EVENT_TYPE, STATE_TYPE, FIELDS_TYPE, QUEUE_CAPACITY) \
+    typedef struct { \
+        EVENT_TYPE events[QUEUE_CAPACITY]; /**< Events ring */ \
+        uint32_t front; /**< Index of the oldest event */ \
+        uint32_t size; /**< Number of events */ \
+    } AO_TYPE##_QUEUE; \
+    \
+    typedef struct AO_TYPE { \
+        uint32_t id; /**< Object ID */ \
+        STATE_TYPE state; /**< Current state */ \
+        FIELDS_TYPE fields; /**< User-defined fields */ \
+        AO_TYPE##_QUEUE queue; /**< Event queue */ \
+    } AO_TYPE; \
+    \
+    typedef STATE_TYPE (*AO_TYPE##_PROCESS_EVENT_TO_NEXT_STATE_F)(AO_TYPE *const activeObject, EVENT_TYPE event); \
+    typedef void (*AO_TYPE##_TRANSITION_TO_NEXT_STATE_F)(AO_TYPE *const activeObject, STATE_TYPE nextState, void *const ctx); \
+    \
+    static inline bool AO_TYPE##_QUEUE_IsEmpty(const AO_TYPE##_QUEUE *const queue); \
+    static inline bool AO_TYPE##_QUEUE_IsFull(const AO_TYPE##_QUEUE *const queue); \
+    static inline bool AO_TYPE##_QUEUE_Enqueue(AO_TYPE##_QUEUE *const queue, EVENT_TYPE event); \
+    static inline bool AO_TYPE##_QUEUE_Dequeue(AO_TYPE##_QUEUE *const queue, EVENT_TYPE *const event); \
+    static inline void AO_TYPE##_Ctor(AO_TYPE *const me, const uint32_t id, STATE_TYPE initialState, FIELDS_TYPE fields); \
+    static inline bool AO_TYPE##_Dispatch(AO_TYPE *const me, EVENT_TYPE event); \
+    static inline bool AO_TYPE##_ProcessQueue(AO_TYPE *const me, \
+                                              AO_TYPE##_PROCESS_EVENT_TO_NEXT_STATE_F processEventToNextState, \
+                                              AO_TYPE##_TRANSITION_TO_NEXT_STATE_F transitionToNextState, \
+                                              void *const ctx); \
+    static inline void AO_TYPE##_basicTransitionToNextState(AO_TYPE *const me, STATE_TYPE nextState, void *const ctx);
+
+/**
+ * @brief Active Object implementation macro: inlinable operations
+ * @note DECLARE_ACTIVE_OBJECT with the same args should be invoked before.
+ * @details Defines:
+ * - AO_TYPE##_Ctor: initializes id, initial state, fields and empty queue;
+ * - AO_TYPE##_Dispatch: enqueues an event, false if the queue is full;
+ * - AO_TYPE##_ProcessQueue: dequeues a single event, resolves the next state and transitions to it,
+ *   false if the queue is empty;
+ * - AO_TYPE##_basicTransitionToNextState: just assigns the next state;
+ * - AO_TYPE##_QUEUE_* queue operations.
+ */
+#define ACTIVE_OBJECT_IMPLEMENTATION(AO_TYPE, EVENT_TYPE, STATE_TYPE, FIELDS_TYPE, QUEUE_CAPACITY) \
+    static inline bool AO_TYPE##_QUEUE_IsEmpty(const AO_TYPE##_QUEUE *const queue) { \
+        return 0 == queue->size; \
+    } \
+    \
+    static inline bool AO_TYPE##_QUEUE_IsFull(const AO_TYPE##_QUEUE *const queue) { \
+        return (QUEUE_CAPACITY) == queue->size; \
+    } \
+    \
+    static inline bool AO_TYPE##_QUEUE_Enqueue(AO_TYPE##_QUEUE *const queue, EVENT_TYPE event) { \
+        if (AO_TYPE##_QUEUE_IsFull(queue)) return false; \
+        uint32_t rear = queue->front + queue->size; \
+        if (rear >= (QUEUE_CAPACITY)) rear -= (QUEUE_CAPACITY); \
+        queue->events[rear] = event; \
+        queue->size++; \
+        return true; \
+    } \
+    \
+    static inline bool AO_TYPE##_QUEUE_Dequeue(AO_TYPE##_QUEUE *const queue, EVENT_TYPE *const event) { \
+        if (AO_TYPE##_QUEUE_IsEmpty(queue)) return false; \
+        *event = queue->events[queue->front]; \
+        if (++queue->front == (QUEUE_CAPACITY)) queue->front = 0; \
+        queue->size--; \
+        return true; \
+    } \
+    \
+    static inline void AO_TYPE##_Ctor(AO_TYPE *const me, const uint32_t id, STATE_TYPE initialState, FIELDS_TYPE fields) { \
+        me->id = id; \
+        me->state = initialState; \
+        me->fields = fields; \
+        me->queue.front = 0; \
+        me->queue.size = 0; \
+    } \
+    \
+    static inline bool AO_TYPE##_Dispatch(AO_TYPE *const me, EVENT_TYPE event) { \
+        return AO_TYPE##_QUEUE_Enqueue(&me->queue, event); \
+    } \
+    \
+    static inline bool AO_TYPE##_ProcessQueue(AO_TYPE *const me, \
+                                              AO_TYPE##_PROCESS_EVENT_TO_NEXT_STATE_F processEventToNextState, \
+                                              AO_TYPE##_TRANSITION_TO_NEXT_STATE_F transitionToNextState, \
+                                              void *const ctx) { \
+        EVENT_TYPE event; \
+        if (!AO_TYPE##_QUEUE_Dequeue(&me->queue, &event)) return false; \
+        transitionToNextState(me, processEventToNextState(me, event), ctx); \
+        return true; \
+    } \
+    \
+    static inline void AO_TYPE##_basicTransitionToNextState(AO_TYPE *const me, STATE_TYPE nextState, void *const ctx) { \
+        (void) ctx; \
+        me->state = nextState; \
+    }
+
+#endif //ACTIVE_OBJECT_IMPL_H
@@ -0,0 +1,79 @@
+#include <string.h>
+
+#include "./active_object_pool.h"
+
+/** @brief Intrusive free list link, overlays the object of a free block */
+typedef struct TFreeBlock {
+    struct TFreeBlock *next;            /**< Next free block, overlays the object id */
+    const TActiveObjectPool *pool;      /**< Free block mark, overlays the state pointer which never points to the pool */
+} TFreeBlock;
+
+bool ActiveObjectPool_Initialize(TActiveObjectPool *pool,
+                                 TActiveObjectPoolUnit *storage,
+                                 size_t storageSize,
+                                 size_t objectSize,
+                                 uint32_t queueCapacity) {
+    if (NULL == pool || NULL == storage || objectSize < sizeof(TActiveObject) || 0 == queueCapacity)
+        return false;
+
+    pool->storage = (uint8_t *) storage;
+    pool->objectSize = objectSize;
+    pool->eventsOffset = ACTIVE_OBJECT_POOL_ROUND_UP(objectSize);
+    pool->blockSize = pool->eventsOffset + ACTIVE_OBJECT_POOL_ROUND_UP(sizeof(TEvent) * queueCapacity);
+    pool->blocksCount = (uint32_t) (storageSize / pool->blockSize);
+    pool->freeCount = pool->blocksCount;
+    pool->queueCapacity = queueCapacity;
+    pool->freeHead = NULL;
+
+    if (0 == pool->blocksCount) return false;
+
+    // Link blocks in reverse, so the first allocation takes the lowest address
+    for (uint32_t i = pool->blocksCount; i > 0; i--) {
+        TFreeBlock *block = (TFreeBlock *) (pool->storage + (size_t) (i - 1) * pool->blockSize);
+        block->next = (TFreeBlock *) pool->freeHead;
+        block->pool = pool;
+        pool->freeHead = block;
+    }
+
+    return true;
+}
+
+TActiveObject *ActiveObjectPool_Allocate(TActiveObjectPool *pool, const uint32_t id) {
+    TFreeBlock *block = (TFreeBlock *) pool->freeHead;
+
+    if (NULL == block) return NULL;
+
+    pool->freeHead = block->next;
+    pool->freeCount--;
+
+    TActiveObject *activeObject = (TActiveObject *) block;
+    TEvent *events = (TEvent *) ((uint8_t *) block + pool->eventsOffset);
+
+    memset(activeObject, 0, pool->objectSize);
+    ActiveObject_Initialize(activeObject, id, events, pool->queueCapacity);
+
+    return activeObject;
+}
+
+bool ActiveObjectPool_Release(TActiveObjectPool *pool, TActiveObject *activeObject) {
+    uint8_t *address = (uint8_t *) activeObject;
+
+    // Validate the object is a block start of this pool
+    if (address < pool->storage) return false;
+
+    size_t offset = (size_t) (address - pool->storage);
+
+    if (offset >= (size_t) pool->blocksCount * pool->blockSize || 0 != offset % pool->blockSize) return false;
+
+    TFreeBlock *block = (TFreeBlock *) address;
+
+    // A block released twice would be linked twice, the free mark is cleared by the allocation only
+    if (pool == block->pool) return false;
+
+    block->next = (TFreeBlock *) pool->freeHead;
+    block->pool = pool;
+    pool->freeHead = block;
+    pool->freeCount++;
+
+    return true;
+}
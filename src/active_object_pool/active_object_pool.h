@@ -0,0 +1,111 @@
+/**
+ * @file active_object_pool.h
+ *
+ * @brief Slab pool of Active Objects with co-located event queues
+ * @see active_object.h for the pooled object.
+ *
+ * @details The pool splits a user-allocated storage into equal blocks.
+ * Every block holds an Active Object (or a user sub Active Object, extending TActiveObject)
+ * immediately followed by its events array, so the object and its ring share
+ * neighbouring cache lines. Free blocks are linked into an intrusive LIFO list,
+ * allocation and release are O(1) and never call malloc.
+ * A free block is marked with the pool address in place of the object state pointer,
+ * so a second release of the same object is rejected instead of corrupting the free list.
+ *
+ * ### Example:
+ * @code
+ * #define POOL_QUEUE_CAPACITY (8)
+ * #define POOL_BLOCKS_MAX (32)
+ *
+ * TActiveObjectPoolUnit storage[ACTIVE_OBJECT_POOL_STORAGE_UNITS(TSubActiveObject, POOL_QUEUE_CAPACITY, POOL_BLOCKS_MAX)];
+ * TActiveObjectPool pool;
+ *
+ * ActiveObjectPool_Initialize(&pool, storage, sizeof(storage), sizeof(TSubActiveObject), POOL_QUEUE_CAPACITY);
+ *
+ * TSubActiveObject *subActiveObject = (TSubActiveObject *)ActiveObjectPool_Allocate(&pool, REQUEST_AO_ID);
+ * // ... process requests
+ * ActiveObjectPool_Release(&pool, &subActiveObject->super);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef ACTIVE_OBJECT_POOL_H
+#define ACTIVE_OBJECT_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+
+/** @brief Storage unit, guarantees blocks alignment suitable for Active Objects and events */
+typedef union {
+    void *pointer;
+    uint64_t integer;
+    double real;
+#ifdef EVENT_QUEUE_COMPACT_EVENT
+    TEvent event;   /**< Rings carved after the objects keep the 16 bytes alignment of the compact events */
+#endif
+} TActiveObjectPoolUnit;
+
+/** @brief Rounds size up to the storage unit size, a multiple of the TEvent alignment */
+#define ACTIVE_OBJECT_POOL_ROUND_UP(SIZE) \
+    ((((SIZE) + sizeof(TActiveObjectPoolUnit) - 1u) / sizeof(TActiveObjectPoolUnit)) * sizeof(TActiveObjectPoolUnit))
+
+/** @brief Size in bytes of a single block: object followed by its events array */
+#define ACTIVE_OBJECT_POOL_BLOCK_SIZE(OBJECT_TYPE, QUEUE_CAPACITY) \
+    (ACTIVE_OBJECT_POOL_ROUND_UP(sizeof(OBJECT_TYPE)) + ACTIVE_OBJECT_POOL_ROUND_UP(sizeof(TEvent) * (QUEUE_CAPACITY)))
+
+/** @brief Storage units number for BLOCKS_MAX blocks */
+#define ACTIVE_OBJECT_POOL_STORAGE_UNITS(OBJECT_TYPE, QUEUE_CAPACITY, BLOCKS_MAX) \
+    ((ACTIVE_OBJECT_POOL_BLOCK_SIZE(OBJECT_TYPE, QUEUE_CAPACITY) / sizeof(TActiveObjectPoolUnit)) * (BLOCKS_MAX))
+
+/** @brief Slab pool of Active Objects */
+typedef struct TActiveObjectPool {
+    uint8_t *storage;           /**< Blocks storage */
+    void *freeHead;             /**< First free block */
+    size_t objectSize;          /**< Size of the (sub) Active Object */
+    size_t eventsOffset;        /**< Offset of the events array in a block */
+    size_t blockSize;           /**< Size of a single block */
+    uint32_t blocksCount;       /**< Total blocks number */
+    uint32_t freeCount;         /**< Free blocks number */
+    uint32_t queueCapacity;     /**< Capacity of each object queue */
+} TActiveObjectPool;
+
+/**
+ * @brief Initializes the pool, all blocks become free
+ * @note The storage must be allocated by the user, see ACTIVE_OBJECT_POOL_STORAGE_UNITS.
+ *
+ * @param pool The pool to initialize
+ * @param storage Pointer to the storage
+ * @param storageSize Size of the storage in bytes
+ * @param objectSize Size of the (sub) Active Object, at least sizeof(TActiveObject)
+ * @param queueCapacity Capacity of each object queue
+ * @return true for success, false for invalid args or too small storage
+ */
+bool ActiveObjectPool_Initialize(TActiveObjectPool *pool,
+                                 TActiveObjectPoolUnit *storage,
+                                 size_t storageSize,
+                                 size_t objectSize,
+                                 uint32_t queueCapacity);
+
+/**
+ * @brief Takes a free block and initializes an Active Object with its co-located queue
+ * @details The whole (sub) object is zeroed before ActiveObject_Initialize.
+ *
+ * @param pool The pool
+ * @param id Object ID
+ * @return Pointer to the Active Object, NULL if the pool is exhausted
+ */
+TActiveObject *ActiveObjectPool_Allocate(TActiveObjectPool *pool, const uint32_t id);
+
+/**
+ * @brief Returns the Active Object block to the pool
+ * @param pool The pool
+ * @param activeObject The Active Object taken from this pool
+ * @return true for success, false if the object doesn't belong to the pool or is already released
+ */
+bool ActiveObjectPool_Release(TActiveObjectPool *pool, TActiveObject *activeObject);
+
+#endif //ACTIVE_OBJECT_POOL_H
@@ -0,0 +1,125 @@
+/**
+ * @file coroutine.h
+ *
+ * @brief Stackless coroutine event handlers: multi-step flows inside a single state
+ * @see fsm.h for the transition table the handlers are registered in.
+ *
+ * @details A sequential protocol (handshake, retry with backoff) is written as a single TEventHandler
+ * which suspends with CO_AWAIT until the awaited signal arrives, instead of a chain of tiny states and handlers.
+ * Protothread style: the resume point is a line number kept in the Active Object resume field and a switch
+ * jumps back to it on the next event, no separate stack is needed.
+ *
+ * While suspended the handler returns the current state, so the flow is a self-transition (onTraverse hook only).
+ * The handler is registered in the state row for every signal it awaits.
+ * A transition to another state restarts the coroutine of the left state (the FSM traversal clears the resume point).
+ * Every region of a TRegionsActiveObject keeps its own resume point (see region.h), coroutine handlers of
+ * different regions suspend independently.
+ *
+ * @note Local variables don't survive a suspension, keep the flow data in the object fields.
+ * @note One coroutine handler per state, one CO_ macro per source line, no switch statements around CO_ macros.
+ *
+ * ### Example:
+ * @code
+ * const TState *handshake(TActiveObject *const activeObject, TEvent event) {
+ *     TLink *link = (TLink *) activeObject;
+ *
+ *     CO_BEGIN(activeObject);
+ *     for (link->retries = 0; link->retries < RETRIES_MAX; link->retries++) {
+ *         sendHello(link);
+ *         CO_AWAIT_UNTIL(activeObject, HELLO_ACK_SIG == event.sig || TIMEOUT_SIG == event.sig);
+ *         if (HELLO_ACK_SIG == event.sig) break;
+ *     }
+ *     if (link->retries == RETRIES_MAX) CO_EXIT(activeObject, &statesList[LINK_ERROR_ST]);
+ *
+ *     sendConfig(link);
+ *     CO_AWAIT(activeObject, event, CONFIG_ACK_SIG);
+ *     CO_EXIT(activeObject, &statesList[LINK_UP_ST]);
+ *     CO_END(activeObject);
+ * }
+ *
+ * // one row, one handler for the whole flow
+ * const TEventHandler transitionTable[STATES_MAX][EVENTS_MAX] = {
+ *     [LINK_CONNECTING_ST] = {[CONNECT_SIG] = handshake, [HELLO_ACK_SIG] = handshake,
+ *                             [TIMEOUT_SIG] = handshake, [CONFIG_ACK_SIG] = handshake},
+ * };
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+
+/**
+ * @brief Starts the coroutine body, jumps to the resume point of the object
+ * @param ME The Active Object
+ */
+#define CO_BEGIN(ME) \
+    switch ((ME)->resume) { \
+        case 0:
+
+/**
+ * @brief Suspends until the next event delivered to the handler
+ * @param ME The Active Object
+ */
+#define CO_YIELD(ME) \
+    do { \
+        (ME)->resume = __LINE__; \
+        return (ME)->state; \
+        case __LINE__:; \
+    } while (0)
+
+/**
+ * @brief Suspends until an event satisfying the condition, the condition is checked on every next event
+ * @param ME The Active Object
+ * @param CONDITION Condition, usually on the handler event
+ */
+#define CO_AWAIT_UNTIL(ME, CONDITION) \
+    do { \
+        (ME)->resume = __LINE__; \
+        return (ME)->state; \
+        case __LINE__: \
+        if (!(CONDITION)) return (ME)->state; \
+    } while (0)
+
+/**
+ * @brief Suspends until an event with the signal, other events are ignored
+ * @param ME The Active Object
+ * @param EVENT The handler event
+ * @param SIG The awaited signal
+ */
+#define CO_AWAIT(ME, EVENT, SIG) CO_AWAIT_UNTIL(ME, (SIG) == (EVENT).sig)
+
+/**
+ * @brief Finishes the flow with a transition to the next state
+ * @param ME The Active Object
+ * @param NEXT_STATE The next state
+ */
+#define CO_EXIT(ME, NEXT_STATE) \
+    do { \
+        (ME)->resume = 0; \
+        return (NEXT_STATE); \
+    } while (0)
+
+/**
+ * @brief Ends the coroutine body, a flow which reaches the end stays in the state and starts over on the next event
+ * @param ME The Active Object
+ */
+#define CO_END(ME) \
+    } \
+    (ME)->resume = 0; \
+    return (ME)->state
+
+/**
+ * @brief Checks if the coroutine of the current state is suspended in the middle of the flow
+ * @param ME The Active Object
+ */
+#define CO_IS_RUNNING(ME) (0 != (ME)->resume)
+
+#endif //COROUTINE_H
@@ -0,0 +1,53 @@
+#include "./dispatch_stage.h"
+
+void DispatchStage_Initialize(TDispatchStage *stage, TDispatchStageEntry *entries, TEvent *scratch, uint32_t capacity) {
+    stage->entries = entries;
+    stage->scratch = scratch;
+    stage->capacity = capacity;
+    stage->count = 0;
+    stage->droppedCount = 0;
+    stage->rejectedCount = 0;
+}
+
+bool DispatchStage_Dispatch(TDispatchStage *stage, TActiveObject *target, TEvent event) {
+    if (NULL == target || 0 == stage->capacity) return false;
+
+    if (stage->count == stage->capacity) DispatchStage_Flush(stage);
+
+    stage->entries[stage->count++] = (TDispatchStageEntry) {.target = target, .event = event};
+    return true;
+}
+
+uint32_t DispatchStage_Flush(TDispatchStage *stage) {
+    uint32_t deliveredCount = 0;
+
+    // Group by destination in the order of first appearance, a stage holds dozens of events and a few destinations
+    for (uint32_t first = 0; first < stage->count; first++) {
+        TActiveObject *target = stage->entries[first].target;
+
+        if (NULL == target) continue;
+
+        uint32_t count = 0;
+
+        for (uint32_t i = first; i < stage->count; i++) {
+            if (stage->entries[i].target != target) continue;
+
+            stage->scratch[count++] = stage->entries[i].event;
+            stage->entries[i].target = NULL;
+        }
+
+        // The bulk dispatch takes the events rejected by the target filter too, its counter tells them apart
+        DISPATCH_STAGE_ENTER_CRITICAL(target);
+        uint32_t rejectedBefore = target->rejectedCount;
+        uint32_t dispatchedCount = ActiveObject_DispatchBulk(target, stage->scratch, count);
+        uint32_t rejectedCount = target->rejectedCount - rejectedBefore;
+        DISPATCH_STAGE_EXIT_CRITICAL(target);
+
+        deliveredCount += dispatchedCount - rejectedCount;
+        stage->droppedCount += count - dispatchedCount;
+        stage->rejectedCount += rejectedCount;
+    }
+
+    stage->count = 0;
+    return deliveredCount;
+}
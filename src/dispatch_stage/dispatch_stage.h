@@ -0,0 +1,98 @@
+/**
+ * @file dispatch_stage.h
+ *
+ * @brief Outgoing dispatch staging buffer, flushed to target queues in bulk
+ * @see active_object.h for ActiveObject_DispatchBulk.
+ *
+ * @details A handler dispatching many events to other objects stages them instead of
+ * enqueueing one by one. On flush, once per run-to-completion step or when the stage is full,
+ * staged events are grouped by destination and every destination gets a single
+ * ActiveObject_DispatchBulk call inside a single critical section, so the destination queue
+ * indices (and its lock, if any) are touched once per step instead of once per event.
+ * The order of events seen by every destination is the staging order.
+ *
+ * Every thread (or core) owns its own stage, no synchronization is needed for staging.
+ * Destination queues are guarded by DISPATCH_STAGE_ENTER_CRITICAL(target) / DISPATCH_STAGE_EXIT_CRITICAL(target),
+ * which are empty by default and should be defined by the port when queues are shared between threads.
+ *
+ * ### Example:
+ * @code
+ * TDispatchStageEntry entries[STAGE_CAPACITY];
+ * TEvent scratch[STAGE_CAPACITY];
+ * TDispatchStage stage; // one per thread
+ *
+ * DispatchStage_Initialize(&stage, entries, scratch, STAGE_CAPACITY);
+ *
+ * // inside a handler
+ * DispatchStage_Dispatch(&stage, &sensor, (TEvent){.sig = READ_SIG});
+ * DispatchStage_Dispatch(&stage, &logger, (TEvent){.sig = LOG_SIG});
+ *
+ * // after the run-to-completion step
+ * DispatchStage_Flush(&stage);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef DISPATCH_STAGE_H
+#define DISPATCH_STAGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+
+/** @brief Destination queue guards, empty for single threaded systems */
+#ifndef DISPATCH_STAGE_ENTER_CRITICAL
+#define DISPATCH_STAGE_ENTER_CRITICAL(TARGET)
+#endif
+
+#ifndef DISPATCH_STAGE_EXIT_CRITICAL
+#define DISPATCH_STAGE_EXIT_CRITICAL(TARGET)
+#endif
+
+/** @brief Staged event */
+typedef struct TDispatchStageEntry {
+    TActiveObject *target;  /**< Destination, NULL once grouped for the flush */
+    TEvent event;           /**< The event */
+} TDispatchStageEntry;
+
+/** @brief Outgoing staging buffer */
+typedef struct TDispatchStage {
+    TDispatchStageEntry *entries;   /**< Staged events in the staging order */
+    TEvent *scratch;                /**< Events of a single destination during the flush */
+    uint32_t capacity;              /**< Capacity of the entries and scratch arrays */
+    uint32_t count;                 /**< Number of staged events */
+    uint32_t droppedCount;          /**< Events not delivered because of full destination queues */
+    uint32_t rejectedCount;         /**< Events not delivered because of destination signal filters */
+} TDispatchStage;
+
+/**
+ * @brief Initializes an empty stage
+ * @param stage The stage
+ * @param entries Entries array, allocated by the user
+ * @param scratch Scratch events array of the same capacity, allocated by the user
+ * @param capacity Capacity of the entries and scratch arrays
+ */
+void DispatchStage_Initialize(TDispatchStage *stage, TDispatchStageEntry *entries, TEvent *scratch, uint32_t capacity);
+
+/**
+ * @brief Stages an event for the destination, flushes the stage first if it is full
+ * @param stage The stage
+ * @param target Destination Active Object
+ * @param event The event
+ * @return true if the event was staged, false for NULL target or zero capacity
+ */
+bool DispatchStage_Dispatch(TDispatchStage *stage, TActiveObject *target, TEvent event);
+
+/**
+ * @brief Delivers all staged events, one bulk dispatch per destination
+ * @details Events which don't fit into full destination queues are dropped and counted in droppedCount,
+ * events rejected by destination signal filters are counted in rejectedCount.
+ * @param stage The stage
+ * @return Number of delivered events, enqueued or deferred
+ */
+uint32_t DispatchStage_Flush(TDispatchStage *stage);
+
+#endif //DISPATCH_STAGE_H
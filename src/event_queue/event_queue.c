@@ -1,13 +1,43 @@
 #include "./event_queue.h"
 
+/** @brief Number of events in the current ring, not counting a linked larger ring */
+static inline uint32_t _getRingSize(TEventQueue* queue);
+
+/** @brief Checks if the current ring is full */
+static inline bool _isRingFull(TEventQueue* queue);
+
+/** @brief Enqueues into a growable queue: current ring, linked ring, or a newly linked larger ring */
+static bool _enqueueGrowable(TEventQueue* queue, TEvent event);
+
+/** @brief Called when the current ring of a growable queue runs empty: switches to the linked ring or shrinks back */
+static void _onRingEmpty(TEventQueue* queue);
+
 void EventQueue_Initialize(TEventQueue* queue, TEvent* events, uint32_t capacity) {
     queue->events = events;
     queue->capacity = capacity;
     queue->front = -1;
     queue->rear = -1;
+    queue->growth = NULL;
+}
+
+void EventQueue_SetGrowth(TEventQueue* queue, TEventQueueGrowth* growth, TEventQueueAllocate allocate,
+                          TEventQueueRelease release, uint32_t maxCapacity, void* const ctx) {
+    growth->allocate = allocate;
+    growth->release = release;
+    growth->ctx = ctx;
+    growth->maxCapacity = maxCapacity;
+    growth->initialEvents = queue->events;
+    growth->initialCapacity = queue->capacity;
+    EventQueue_Initialize(&growth->next, NULL, 0);
+
+    queue->growth = growth;
 }
 
 bool EventQueue_Enqueue(TEventQueue* queue, TEvent event) {
+    if (queue->growth) {
+        return _enqueueGrowable(queue, event);
+    }
+
     if (EventQueue_IsFull(queue)) {
         return false;
     }
@@ -21,16 +51,45 @@ bool EventQueue_Enqueue(TEventQueue* queue, TEvent event) {
     return true;
 }
 
+uint32_t EventQueue_EnqueueBulk(TEventQueue* queue, const TEvent* events, uint32_t count) {
+    if (queue->growth) {
+        uint32_t enqueuedCount = 0;
+        while (enqueuedCount < count && _enqueueGrowable(queue, events[enqueuedCount])) enqueuedCount++;
+        return enqueuedCount;
+    }
+
+    uint32_t freeSize = queue->capacity - _getRingSize(queue);
+
+    if (count > freeSize) count = freeSize;
+    if (0 == count) return 0;
+
+    uint32_t rear = (uint32_t)(queue->rear + 1) % queue->capacity;
+
+    for (uint32_t i = 0; i < count; i++) {
+        queue->events[(rear + i) % queue->capacity] = events[i];
+    }
+
+    if (queue->front == -1) {
+        queue->front = (int32_t)rear;
+    }
+
+    queue->rear = (int32_t)((rear + count - 1) % queue->capacity);
+    return count;
+}
+
 TEvent EventQueue_Dequeue(TEventQueue* queue) {
     if (EventQueue_IsEmpty(queue)) {
-        TEvent emptyEvent = {0, NULL, 0};
-        return emptyEvent;
+        return EVENT_EMPTY;
     }
 
     TEvent event = queue->events[queue->front];
 
     if (queue->front == queue->rear) {
         queue->front = queue->rear = -1;
+
+        if (queue->growth) {
+            _onRingEmpty(queue);
+        }
     } else {
         queue->front = (queue->front + 1) % queue->capacity;
     }
@@ -40,18 +99,182 @@ TEvent EventQueue_Dequeue(TEventQueue* queue) {
 
 TEvent EventQueue_Peek(TEventQueue* queue) {
     if (EventQueue_IsEmpty(queue)) {
-        TEvent emptyEvent = {0, NULL, 0};
-        return emptyEvent;
+        return EVENT_EMPTY;
     }
 
     return queue->events[queue->front];
 }
 
+TEvent EventQueue_PeekAt(TEventQueue* queue, uint32_t index) {
+    uint32_t ringSize = _getRingSize(queue);
+
+    if (index < ringSize) {
+        return queue->events[((uint32_t)queue->front + index) % queue->capacity];
+    }
+
+    if (queue->growth) {
+        return EventQueue_PeekAt(&queue->growth->next, index - ringSize);
+    }
+
+    return EVENT_EMPTY;
+}
+
 bool EventQueue_IsEmpty(TEventQueue* queue) {
     return (queue->front == -1);
 }
 
 bool EventQueue_IsFull(TEventQueue* queue) {
+    if (queue->growth) {
+        TEventQueue* newest = queue->growth->next.events ? &queue->growth->next : queue;
+
+        return _isRingFull(newest) && newest->capacity >= queue->growth->maxCapacity;
+    }
+
+    return _isRingFull(queue);
+}
+
+
+uint32_t EventQueue_GetSize(TEventQueue* queue) {
+    if (queue->growth) {
+        return _getRingSize(queue) + _getRingSize(&queue->growth->next);
+    }
+
+    return _getRingSize(queue);
+}
+
+uint32_t EventQueue_GetFreeSize(TEventQueue* queue) {
+    if (NULL == queue->growth) {
+        return queue->capacity - _getRingSize(queue);
+    }
+
+    TEventQueue* next = &queue->growth->next;
+    uint32_t maxCapacity = queue->growth->maxCapacity;
+
+    // A linked ring takes every new event and grows up to the max capacity
+    if (next->events) {
+        return maxCapacity > _getRingSize(next) ? maxCapacity - _getRingSize(next) : 0;
+    }
+
+    // The current ring fills first, then a ring of up to the max capacity is linked
+    return queue->capacity - _getRingSize(queue) + (queue->capacity < maxCapacity ? maxCapacity : 0);
+}
+
+uint32_t EventQueue_MoveToFront(TEventQueue* queue, TEventQueue* source, uint32_t count) {
+    uint32_t sourceSize = EventQueue_GetSize(source);
+    uint32_t freeSize = queue->capacity - _getRingSize(queue);
+
+    if (count > sourceSize) count = sourceSize;
+    if (count > freeSize) count = freeSize;
+    if (0 == count) return 0;
+
+    uint32_t front = 0;
+
+    if (EventQueue_IsEmpty(queue)) {
+        queue->rear = (int32_t)count - 1;
+    } else {
+        front = ((uint32_t)queue->front + queue->capacity - count) % queue->capacity;
+    }
+
+    // Take the oldest events ring by ring, a drained ring of a growable source switches to the linked one
+    for (uint32_t moved = 0; moved < count;) {
+        uint32_t ringSize = _getRingSize(source);
+        uint32_t chunk = count - moved < ringSize ? count - moved : ringSize;
+
+        for (uint32_t i = 0; i < chunk; i++) {
+            queue->events[(front + moved + i) % queue->capacity] =
+                source->events[((uint32_t)source->front + i) % source->capacity];
+        }
+
+        moved += chunk;
+
+        if (chunk == ringSize) {
+            source->front = source->rear = -1;
+
+            if (source->growth) {
+                _onRingEmpty(source);
+            }
+        } else {
+            source->front = (int32_t)(((uint32_t)source->front + chunk) % source->capacity);
+        }
+    }
+
+    queue->front = (int32_t)front;
+    return count;
+}
+
+static inline uint32_t _getRingSize(TEventQueue* queue) {
+    if (EventQueue_IsEmpty(queue)) {
+        return 0;
+    }
+
+    return (uint32_t)((queue->rear - queue->front + (int32_t)queue->capacity) % (int32_t)queue->capacity) + 1;
+}
+
+static inline bool _isRingFull(TEventQueue* queue) {
     return ((queue->rear + 1) % queue->capacity == queue->front);
 }
 
+static bool _enqueueGrowable(TEventQueue* queue, TEvent event) {
+    TEventQueueGrowth* growth = queue->growth;
+    TEventQueue* next = &growth->next;
+
+    // Current ring accepts events until it fills for the first time, then only the linked ring does
+    if (NULL == next->events) {
+        if (!_isRingFull(queue)) {
+            if (queue->front == -1) queue->front = 0;
+            queue->rear = (queue->rear + 1) % queue->capacity;
+            queue->events[queue->rear] = event;
+            return true;
+        }
+
+        if (queue->capacity >= growth->maxCapacity) return false;
+
+        uint32_t capacity = queue->capacity * 2 < growth->maxCapacity ? queue->capacity * 2 : growth->maxCapacity;
+        TEvent* events = growth->allocate(capacity, growth->ctx);
+
+        if (NULL == events) return false;
+
+        EventQueue_Initialize(next, events, capacity);
+    } else if (_isRingFull(next)) {
+        // Linked ring fills before the current one drains: migrate it to a larger ring, three rings are never linked
+        if (next->capacity >= growth->maxCapacity) return false;
+
+        uint32_t capacity = next->capacity * 2 < growth->maxCapacity ? next->capacity * 2 : growth->maxCapacity;
+        TEvent* events = growth->allocate(capacity, growth->ctx);
+
+        if (NULL == events) return false;
+
+        TEventQueue larger;
+        EventQueue_Initialize(&larger, events, capacity);
+        while (!EventQueue_IsEmpty(next)) EventQueue_Enqueue(&larger, EventQueue_Dequeue(next));
+
+        growth->release(next->events, next->capacity, growth->ctx);
+        *next = larger;
+    }
+
+    return EventQueue_Enqueue(next, event);
+}
+
+static void _onRingEmpty(TEventQueue* queue) {
+    TEventQueueGrowth* growth = queue->growth;
+    TEventQueue* next = &growth->next;
+
+    if (queue->events == growth->initialEvents) {
+        if (NULL == next->events) return;
+    } else {
+        growth->release(queue->events, queue->capacity, growth->ctx);
+    }
+
+    if (next->events) {
+        // The drained ring is done, the linked ring becomes current
+        queue->events = next->events;
+        queue->capacity = next->capacity;
+        queue->front = next->front;
+        queue->rear = next->rear;
+        EventQueue_Initialize(next, NULL, 0);
+    } else {
+        // Idle: shrink back to the initial ring
+        queue->events = growth->initialEvents;
+        queue->capacity = growth->initialCapacity;
+    }
+}
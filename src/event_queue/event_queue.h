@@ -7,12 +7,35 @@
  * It utilizes a fixed-size array and employs the concept of wrapping around the indices to achieve a circular behavior.
  * The circular nature allows efficient utilization of space without wasting memory.
  *
+ * Optional growable mode (EventQueue_SetGrowth): the queue starts with a small ring,
+ * and when it fills, a larger ring from a caller-supplied allocator is linked in for the new events.
+ * The old ring is drained first to keep FIFO order, then released. When the queue runs empty,
+ * it shrinks back to the initial ring. Fixed-size queues pay a single NULL check on enqueue,
+ * growth bookkeeping runs only on the full and the becoming empty paths.
+ *
+ * Optional compact events (EVENT_QUEUE_COMPACT_EVENT defined for the whole build): a 16-bit signal,
+ * a 32-bit size and the payload pointer in 16 bytes instead of 24 on 64-bit targets, so a cache line holds 4 events
+ * and an event is copied as a single 16-byte value. The field names are kept, but the field order is not:
+ * events should be built with EVENT_MAKE or designated initializers, positional initializers break.
+ *
  * ### Example:
  * @code
  * #include "event_queue.h"
  * #define QUEUE_MAX_CAPACITY  (8)
  * @endcode
  *
+ * ### Growable queue example:
+ * @code
+ * TEvent *allocateEvents(uint32_t capacity, void *const ctx) { return malloc(capacity * sizeof(TEvent)); }
+ * void releaseEvents(TEvent *events, uint32_t capacity, void *const ctx) { free(events); }
+ *
+ * TEvent events[4];
+ * TEventQueueGrowth growth;
+ *
+ * EventQueue_Initialize(&queue, events, 4);
+ * EventQueue_SetGrowth(&queue, &growth, allocateEvents, releaseEvents, 1024, NULL);
+ * @endcode
+ *
  * @author apolisskyi
  */
 
@@ -23,6 +46,27 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#ifdef EVENT_QUEUE_COMPACT_EVENT
+
+/** @brief 16 bytes alignment of the compact event on 64-bit targets, 12 bytes events stay unpadded on 32-bit ones */
+#if defined(__SIZEOF_POINTER__) && 8 == __SIZEOF_POINTER__
+#define EVENT_QUEUE_COMPACT_ALIGNMENT   __attribute__((aligned(16)))
+#else
+#define EVENT_QUEUE_COMPACT_ALIGNMENT
+#endif
+
+/**
+ * @brief Compact event structure containing a signal and payload
+ */
+typedef struct EVENT_QUEUE_COMPACT_ALIGNMENT TEvent {
+    void* payload;      /**< Pointer to payload */
+    uint32_t size;      /**< Size of payload */
+    int16_t sig;        /**< Signal for event, possibly enums, up to INT16_MAX */
+    uint16_t reserved;  /**< Keeps the layout explicit, zero */
+} TEvent;
+
+#else
+
 /**
  * @brief Event structure containing a signal and payload
  */
@@ -32,16 +76,61 @@ typedef struct TEvent {
     size_t size;        /**< Size of payload */
 } TEvent;
 
+#endif
+
+/** @brief Builds an event regardless of the event layout */
+#define EVENT_MAKE(SIG, PAYLOAD, SIZE)  ((TEvent) {.sig = (SIG), .payload = (PAYLOAD), .size = (SIZE)})
+
+/** @brief Empty event returned by an empty queue */
+#define EVENT_EMPTY                     EVENT_MAKE(0, NULL, 0)
+
+/** @brief Event fields accessors, the same for both event layouts */
+#define EVENT_SIG(EVENT)                ((int) (EVENT).sig)
+#define EVENT_PAYLOAD(EVENT)            ((EVENT).payload)
+#define EVENT_SIZE(EVENT)               ((size_t) (EVENT).size)
+
+typedef struct TEventQueueGrowth TEventQueueGrowth;
+
 /**
  * @brief Fixed-size Event Queue structure
  */
 typedef struct TEventQueue {
-    TEvent* events;         /**< Pointer to array holding the events */
-    int32_t front;          /**< Front index */
-    int32_t rear;           /**< Rear index */
-    uint32_t capacity;      /**< Capacity of the queue */
+    TEvent* events;             /**< Pointer to array holding the events */
+    int32_t front;              /**< Front index */
+    int32_t rear;               /**< Rear index */
+    uint32_t capacity;          /**< Capacity of the queue */
+    TEventQueueGrowth* growth;  /**< Growable mode state, NULL for a fixed-size queue */
 } TEventQueue;
 
+/**
+ * @brief Allocates an events ring for a growable queue
+ * @param capacity Number of events in the ring
+ * @param ctx User context
+ * @return The events array, NULL if out of memory
+ */
+typedef TEvent* (*TEventQueueAllocate)(uint32_t capacity, void* const ctx);
+
+/**
+ * @brief Releases an events ring allocated by TEventQueueAllocate
+ * @param events The events array
+ * @param capacity Number of events in the ring
+ * @param ctx User context
+ */
+typedef void (*TEventQueueRelease)(TEvent* events, uint32_t capacity, void* const ctx);
+
+/**
+ * @brief Growable mode state, allocated by the user per queue
+ */
+struct TEventQueueGrowth {
+    TEventQueueAllocate allocate;   /**< Rings allocator */
+    TEventQueueRelease release;     /**< Rings deallocator */
+    void* ctx;                      /**< User context for the allocator */
+    uint32_t maxCapacity;           /**< Max capacity of a single ring */
+    TEvent* initialEvents;          /**< Initial ring, user-allocated, never released */
+    uint32_t initialCapacity;       /**< Initial ring capacity */
+    TEventQueue next;               /**< Larger ring receiving new events while the current one drains, no events when not linked */
+};
+
 /**
  * @brief Initializes the Event Queue
  * @param queue The TEventQueue to initialize
@@ -50,6 +139,20 @@ typedef struct TEventQueue {
  */
 void EventQueue_Initialize(TEventQueue* queue, TEvent* events, uint32_t capacity);
 
+/**
+ * @brief Turns the queue into a growable one
+ * @note The queue should be initialized and empty, the growth state must outlive the queue.
+ *
+ * @param queue The TEventQueue pointer
+ * @param growth The growth state of this queue
+ * @param allocate Rings allocator
+ * @param release Rings deallocator
+ * @param maxCapacity Max capacity of a single ring, rings double up to this capacity
+ * @param ctx User context for the allocator
+ */
+void EventQueue_SetGrowth(TEventQueue* queue, TEventQueueGrowth* growth, TEventQueueAllocate allocate,
+                          TEventQueueRelease release, uint32_t maxCapacity, void* const ctx);
+
 /**
  * @brief Enqueue an event into the queue
  * @param queue The TEventQueue pointer
@@ -58,6 +161,16 @@ void EventQueue_Initialize(TEventQueue* queue, TEvent* events, uint32_t capacity
  */
 bool EventQueue_Enqueue(TEventQueue* queue, TEvent event);
 
+/**
+ * @brief Enqueue events into the queue in bulk, keeping their order
+ * @details Indices of a fixed-size queue are updated once for all events.
+ * @param queue The TEventQueue pointer
+ * @param events The TEvents to enqueue
+ * @param count Number of events
+ * @return Number of enqueued events, less than count if the queue is full
+ */
+uint32_t EventQueue_EnqueueBulk(TEventQueue* queue, const TEvent* events, uint32_t count);
+
 /**
  * @brief Dequeue an event from the queue
  * @param queue The TEventQueue pointer
@@ -72,6 +185,15 @@ TEvent EventQueue_Dequeue(TEventQueue* queue);
  */
 TEvent EventQueue_Peek(TEventQueue* queue);
 
+/**
+ * @brief Peek a pending event by its position without removing it
+ * @details A growable queue continues with its linked ring after the current one.
+ * @param queue The TEventQueue pointer
+ * @param index Position from the front of the queue, 0 for the front event
+ * @return The TEvent at the position, EVENT_EMPTY if the queue has no such event
+ */
+TEvent EventQueue_PeekAt(TEventQueue* queue, uint32_t index);
+
 /**
  * @brief Check if the queue is empty
  * @param queue The TEventQueue pointer
@@ -81,9 +203,37 @@ bool EventQueue_IsEmpty(TEventQueue* queue);
 
 /**
  * @brief Check if the queue is full
+ * @details A growable queue is full when its newest ring is full and already has the max capacity.
  * @param queue The TEventQueue pointer
  * @return true if full, false if not full
 */
 bool EventQueue_IsFull(TEventQueue* queue);
 
+/**
+ * @brief Get the number of events in the queue
+ * @param queue The TEventQueue pointer
+ * @return Number of events in the queue
+*/
+uint32_t EventQueue_GetSize(TEventQueue* queue);
+
+/**
+ * @brief Get the number of events the queue can still take
+ * @details A growable queue counts the rings it may grow to, as if every ring allocation succeeds.
+ * @param queue The TEventQueue pointer
+ * @return Number of free event slots
+*/
+uint32_t EventQueue_GetFreeSize(TEventQueue* queue);
+
+/**
+ * @brief Move the oldest events of the source queue to the front of the queue in bulk
+ * @details Events keep their order and are placed before the events already in the queue,
+ * indices of both queues are updated once per ring. A growable source is drained across its linked rings.
+ * @param queue The TEventQueue pointer to splice events into
+ * @param source The TEventQueue pointer to take events from
+ * @param count Max number of events to move
+ * @return Number of moved events, limited by the source size and the queue free space
+ * (of the draining ring for a growable queue)
+*/
+uint32_t EventQueue_MoveToFront(TEventQueue* queue, TEventQueue* source, uint32_t count);
+
 #endif // EVENT_QUEUE_H
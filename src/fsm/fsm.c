@@ -4,6 +4,17 @@
 const TState emptyState = EMPTY_STATE;
 const TState invalidState = INVALID_STATE;
 
+#ifdef FSM_PROFILE
+/** @brief Attached profiles list */
+static TFsmProfile *profilesHead = NULL;
+
+/** @brief Counts a lookup of the table cell if the table is profiled */
+static inline void _countLookup(const void *transitionTable, uint32_t state, uint32_t sig);
+#endif
+
+/** @brief Checks if the map is a permutation of [0, size) */
+static bool _isPermutation(const uint16_t *map, uint32_t size);
+
 /** @brief Executes a hook if it exists */
 static inline bool _executeHook(TStateHook hook, TActiveObject *activeObject);
 
@@ -18,6 +29,23 @@ static inline bool _IsValidArgsProcessEventToNextStateFromTransitionTable(
         const TEventHandler transitionTable[statesMax][eventsMax]
 );
 
+/** @brief Validates input args for {@see FSM_ProcessEventToNextStateFromTables} */
+static inline bool _IsValidArgsProcessEventToNextStateFromTables(
+        TActiveObject *const activeObject,
+        TEvent event,
+        uint32_t statesMax,
+        uint32_t eventsMax,
+        const TState *const nextStatesTable[statesMax][eventsMax]
+);
+
+/** @brief Validates current state and event of the active object against the tables size */
+static inline bool _IsValidStateAndEvent(
+        TActiveObject *const activeObject,
+        TEvent event,
+        uint32_t statesMax,
+        uint32_t eventsMax
+);
+
 /** @brief Validates input args for {@see FSM_TraverseAOToNextState} */
 static inline bool _IsValidArgsTraverseAOToNextState(
         TActiveObject *const activeObject,
@@ -48,6 +76,10 @@ const TState *FSM_ProcessEventToNextStateFromTransitionTable(
 
     uint32_t currStateName = activeObject->state->name;
 
+#ifdef FSM_PROFILE
+    _countLookup(transitionTable, currStateName, event.sig);
+#endif
+
     // Lookup transition table to find the handler for the current state and event
     const TEventHandler eventHandler = transitionTable[currStateName][event.sig];
 
@@ -62,6 +94,131 @@ const TState *FSM_ProcessEventToNextStateFromTransitionTable(
     return &emptyState;
 };
 
+const TState *FSM_ProcessEventToNextStateFromRemappedTable(
+        TActiveObject *const activeObject,
+        TEvent event,
+        uint32_t statesMax,
+        uint32_t eventsMax,
+        const uint16_t stateMap[statesMax],
+        const uint16_t sigMap[eventsMax],
+        const TEventHandler remappedTable[statesMax][eventsMax]) {
+
+    /* Validate input args */
+    if (!_IsValidArgsProcessEventToNextStateFromTransitionTable(activeObject,
+                                                                event,
+                                                                statesMax,
+                                                                eventsMax,
+                                                                remappedTable))
+        return &invalidState;
+
+    // Lookup the renumbered cell, the maps are small and stay in cache
+    const TEventHandler eventHandler = remappedTable[stateMap[activeObject->state->name]][sigMap[event.sig]];
+
+    // Call the handler to get the next state and make side effects
+    if (eventHandler) {
+        return eventHandler(activeObject, event);
+    }
+
+    // Return empty state if no transition exists
+    return &emptyState;
+};
+
+bool FSM_RemapTransitionTable(
+        uint32_t statesMax,
+        uint32_t eventsMax,
+        const TEventHandler transitionTable[statesMax][eventsMax],
+        const uint16_t stateMap[statesMax],
+        const uint16_t sigMap[eventsMax],
+        TEventHandler remappedTable[statesMax][eventsMax]) {
+    if (!_isPermutation(stateMap, statesMax) || !_isPermutation(sigMap, eventsMax)) return false;
+
+    for (uint32_t state = 0; state < statesMax; state++) {
+        for (uint32_t sig = 0; sig < eventsMax; sig++) {
+            remappedTable[stateMap[state]][sigMap[sig]] = transitionTable[state][sig];
+        }
+    }
+
+    return true;
+}
+
+bool FSM_AttachProfile(
+        TFsmProfile *profile,
+        const void *transitionTable,
+        uint32_t statesMax,
+        uint32_t eventsMax,
+        uint64_t *hits) {
+#ifdef FSM_PROFILE
+    if (NULL == profile || NULL == transitionTable || NULL == hits) return false;
+
+    for (uint32_t i = 0; i < statesMax * eventsMax; i++) {
+        hits[i] = 0;
+    }
+
+    profile->transitionTable = transitionTable;
+    profile->statesMax = statesMax;
+    profile->eventsMax = eventsMax;
+    profile->hits = hits;
+    profile->next = profilesHead;
+    profilesHead = profile;
+    return true;
+#else
+    (void) profile;
+    (void) transitionTable;
+    (void) statesMax;
+    (void) eventsMax;
+    (void) hits;
+    return false;
+#endif
+}
+
+void FSM_DetachProfile(TFsmProfile *profile) {
+#ifdef FSM_PROFILE
+    for (TFsmProfile **link = &profilesHead; *link; link = &(*link)->next) {
+        if (*link == profile) {
+            *link = profile->next;
+            return;
+        }
+    }
+#else
+    (void) profile;
+#endif
+}
+
+const TState *FSM_ProcessEventToNextStateFromTables(
+        TActiveObject *const activeObject,
+        TEvent event,
+        uint32_t statesMax,
+        uint32_t eventsMax,
+        const TState *const nextStatesTable[statesMax][eventsMax],
+        const TEventHandler (*transitionTable)[eventsMax]) {
+
+    /* Validate input args */
+    if (!_IsValidArgsProcessEventToNextStateFromTables(activeObject,
+                                                       event,
+                                                       statesMax,
+                                                       eventsMax,
+                                                       nextStatesTable))
+        return &invalidState;
+
+    uint32_t currStateName = activeObject->state->name;
+
+    // Table-only transition: a single load, no handler call
+    const TState *nextState = nextStatesTable[currStateName][event.sig];
+
+    if (nextState) return nextState;
+
+    // Lookup transition table to find the handler for the current state and event
+    const TEventHandler eventHandler = transitionTable ? transitionTable[currStateName][event.sig] : NULL;
+
+    // Call the handler to get the next state and make side effects
+    if (eventHandler) {
+        return eventHandler(activeObject, event);
+    }
+
+    // Return empty state if no transition exists
+    return &emptyState;
+};
+
 bool FSM_TraverseAOToNextState(
         TActiveObject *const activeObject,
         const TState *const nextState) {
@@ -79,8 +236,9 @@ bool FSM_TraverseAOToNextState(
         return false;
     }
 
-    // Update the state
+    // Update the state, a coroutine of the left state starts over next time
     activeObject->state = (TState *) nextState;
+    activeObject->resume = 0;
 
     if (!_executeHook(activeObject->state->onEnter, activeObject) ||
         !_executeHook(activeObject->state->onTraverse, activeObject)) {
@@ -90,6 +248,121 @@ bool FSM_TraverseAOToNextState(
     return true;
 };
 
+void FSM_CompileTransitionPlans(
+        const TState *const states,
+        uint32_t statesMax,
+        TTransitionPlan plans[statesMax][statesMax]) {
+    for (uint32_t from = 0; from < statesMax; from++) {
+        for (uint32_t to = 0; to < statesMax; to++) {
+            const TState *currState = &states[from];
+            const TState *nextState = &states[to];
+            TTransitionPlan *plan = &plans[from][to];
+
+            plan->exitCount = 0;
+            plan->hooksCount = 0;
+            plan->target = FSM_IsValidState(nextState) ? nextState : NULL;
+
+            // Self-transition
+            if (FSM_IsEqualStates(currState, nextState)) {
+                if (currState->onTraverse) plan->hooks[plan->hooksCount++] = currState->onTraverse;
+                continue;
+            }
+
+            if (currState->onExit) plan->hooks[plan->hooksCount++] = currState->onExit;
+            plan->exitCount = plan->hooksCount;
+
+            if (nextState->onEnter) plan->hooks[plan->hooksCount++] = nextState->onEnter;
+            if (nextState->onTraverse) plan->hooks[plan->hooksCount++] = nextState->onTraverse;
+        }
+    }
+}
+
+bool FSM_TraverseAOByPlan(
+        TActiveObject *const activeObject,
+        uint32_t statesMax,
+        const TTransitionPlan plans[statesMax][statesMax],
+        const TState *const nextState) {
+    if (!activeObject || !nextState) return false;
+
+    // Invalid next states have no target in the plans, unsigned compare rejects negative names too
+    const uint32_t from = (uint32_t) activeObject->state->name;
+    const uint32_t to = (uint32_t) nextState->name;
+
+    if (from >= statesMax || to >= statesMax) return false;
+
+    const TTransitionPlan *plan = &plans[from][to];
+    const uint32_t exitCount = plan->exitCount;
+    const uint32_t hooksCount = plan->hooksCount;
+    uint32_t i = 0;
+
+    if (NULL == plan->target) return false;
+
+    for (; i < exitCount; i++) {
+        if (!plan->hooks[i](activeObject, NULL)) return false;
+    }
+
+    // Update the state, nextState equals the plan target and keeps the plan load off the dependency chain
+    activeObject->state = nextState;
+    if (from != to) activeObject->resume = 0;
+
+    for (; i < hooksCount; i++) {
+        if (!plan->hooks[i](activeObject, NULL)) return false;
+    }
+
+    return true;
+};
+
+void FSM_CompileAcceptedSignals(
+        uint32_t statesMax,
+        uint32_t eventsMax,
+        const TState *const (*nextStatesTable)[eventsMax],
+        const TEventHandler (*transitionTable)[eventsMax],
+        TSignalMask accepted[statesMax][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(eventsMax)]) {
+    for (uint32_t state = 0; state < statesMax; state++) {
+        for (uint32_t word = 0; word < ACTIVE_OBJECT_SIGNAL_MASK_WORDS(eventsMax); word++) {
+            accepted[state][word] = 0;
+        }
+
+        for (uint32_t sig = 0; sig < eventsMax; sig++) {
+            bool isHandled = (nextStatesTable && nextStatesTable[state][sig])
+                             || (transitionTable && transitionTable[state][sig]);
+
+            if (isHandled) accepted[state][sig / 32u] |= 1u << (sig % 32u);
+        }
+    }
+}
+
+#ifdef FSM_PROFILE
+static inline void _countLookup(const void *transitionTable, uint32_t state, uint32_t sig) {
+    for (TFsmProfile *profile = profilesHead; profile; profile = profile->next) {
+        if (profile->transitionTable == transitionTable && state < profile->statesMax && sig < profile->eventsMax) {
+            FSM_PROFILE_COUNT(&profile->hits[state * profile->eventsMax + sig]);
+        }
+    }
+}
+#endif
+
+static bool _isPermutation(const uint16_t *map, uint32_t size) {
+    if (NULL == map || 0 == size) return false;
+
+    // Each of [0, size) once: in range and not seen before
+    uint32_t seen[(size + 31u) / 32u];
+
+    for (uint32_t word = 0; word < (size + 31u) / 32u; word++) {
+        seen[word] = 0;
+    }
+
+    for (uint32_t i = 0; i < size; i++) {
+        const uint32_t index = map[i];
+
+        if (index >= size || (seen[index / 32u] & (1u << (index % 32u)))) return false;
+
+        seen[index / 32u] |= 1u << (index % 32u);
+    }
+
+    return true;
+}
+
 static bool _executeHook(TStateHook hook, TActiveObject *activeObject) {
     if (hook) {
         return hook(activeObject, NULL);
@@ -111,6 +384,30 @@ static inline bool _IsValidArgsProcessEventToNextStateFromTransitionTable(
         || NULL == transitionTable)
         return false;
 
+    return _IsValidStateAndEvent(activeObject, event, statesMax, eventsMax);
+}
+
+static inline bool _IsValidArgsProcessEventToNextStateFromTables(
+        TActiveObject *const activeObject,
+        TEvent event,
+        uint32_t statesMax,
+        uint32_t eventsMax,
+        const TState *const nextStatesTable[statesMax][eventsMax]
+) {
+    // Validate Active object
+    if (NULL == activeObject
+        || NULL == nextStatesTable)
+        return false;
+
+    return _IsValidStateAndEvent(activeObject, event, statesMax, eventsMax);
+}
+
+static inline bool _IsValidStateAndEvent(
+        TActiveObject *const activeObject,
+        TEvent event,
+        uint32_t statesMax,
+        uint32_t eventsMax
+) {
     // Validate current state
     if (activeObject->state->name < 0 || activeObject->state->name >= statesMax) return false;
 
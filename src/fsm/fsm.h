@@ -17,6 +17,37 @@
 
 typedef const TState* (*TEventHandler)(TActiveObject *const activeObject, TEvent event);
 
+/** @brief Profile hit counter increment, processing threads may share a profile */
+#ifndef FSM_PROFILE_COUNT
+#define FSM_PROFILE_COUNT(PTR) __atomic_add_fetch((PTR), 1u, __ATOMIC_RELAXED)
+#endif
+
+/** @brief Max hook calls of a single transition: onExit, onEnter, onTraverse */
+#define FSM_TRANSITION_PLAN_HOOKS_MAX (3)
+
+/**
+ * @brief Precomputed transition from one state to another
+ * @details Holds only the non-NULL hooks in the call order, the first exitCount hooks run before the state update.
+ */
+typedef struct {
+    const TState *target; /**< The next state, NULL for a transition to an invalid state. */
+    uint8_t exitCount; /**< Number of hooks to call before the state update (onExit). */
+    uint8_t hooksCount; /**< Number of hooks to call. */
+    TStateHook hooks[FSM_TRANSITION_PLAN_HOOKS_MAX]; /**< Hooks to call. */
+} TTransitionPlan;
+
+/**
+ * @brief Per-cell lookup counters of a transition table, for profile-guided table remapping
+ * @see tools/fsm-pgo for the remapping maps generator.
+ */
+typedef struct TFsmProfile {
+    const void *transitionTable; /**< The profiled table. */
+    uint32_t statesMax; /**< The maximum number of states. */
+    uint32_t eventsMax; /**< The maximum number of events. */
+    uint64_t *hits; /**< Lookups counters [statesMax][eventsMax], allocated by the user. */
+    struct TFsmProfile *next; /**< Next attached profile. */
+} TFsmProfile;
+
 /**
  * @brief Processes an incoming event
  * @details Invoke state handler f from transition table by current state and event: [currState][event] => f(event): nextState
@@ -38,6 +69,135 @@ const TState *FSM_ProcessEventToNextStateFromTransitionTable(
     uint32_t eventsMax, /**< The maximum number of events. */
     const TEventHandler transitionTable[statesMax][eventsMax]); /**< The transition table for state-event. */
 
+/**
+ * @brief Processes an incoming event by the remapped transition table
+ * @details Same as FSM_ProcessEventToNextStateFromTransitionTable, the cell is looked up
+ * by the renumbered state and signal: remappedTable[stateMap[currState]][sigMap[event]] => f(event): nextState
+ *
+ * ### Example
+ * @code
+ * #include "transition_table_pgo.h" // generated by tools/fsm-pgo: fsmStateMap, fsmSigMap
+ *
+ * TEventHandler remappedTable[STATES_MAX][EVENTS_MAX];
+ *
+ * FSM_RemapTransitionTable(STATES_MAX, EVENTS_MAX, transitionTable, fsmStateMap, fsmSigMap, remappedTable);
+ * // ...
+ * FSM_ProcessEventToNextStateFromRemappedTable(&activeObject, event, STATES_MAX, EVENTS_MAX,
+ *                                              fsmStateMap, fsmSigMap, remappedTable);
+ * @endcode
+ *
+ * @param[in] activeObject The active object.
+ * @param[in] event The incoming event.
+ * @param[in] statesMax The maximum number of states.
+ * @param[in] eventsMax The maximum number of events.
+ * @param[in] stateMap Remapped row of every state name.
+ * @param[in] sigMap Remapped column of every signal.
+ * @param[in] remappedTable The table filled by FSM_RemapTransitionTable.
+ *
+ * @return A pointer to the next state
+ * @returns 0 (EMPTY_STATE) in case of state handler lack in transitionTable
+ * @returns -1 (INVALID_STATE) in case of invalid input args
+ */
+const TState *FSM_ProcessEventToNextStateFromRemappedTable(
+    TActiveObject *const activeObject, /**< The active object. */
+    TEvent event, /**< The incoming event. */
+    uint32_t statesMax, /**< The maximum number of states. */
+    uint32_t eventsMax, /**< The maximum number of events. */
+    const uint16_t stateMap[statesMax], /**< Remapped row of every state name. */
+    const uint16_t sigMap[eventsMax], /**< Remapped column of every signal. */
+    const TEventHandler remappedTable[statesMax][eventsMax]); /**< The remapped transition table. */
+
+/**
+ * @brief Fills the remapped transition table: remappedTable[stateMap[state]][sigMap[sig]] = transitionTable[state][sig]
+ * @details Hot cells packed into the first rows and columns by the maps share cache lines.
+ * Should be called once at the machine startup.
+ *
+ * @param[in] statesMax The maximum number of states.
+ * @param[in] eventsMax The maximum number of events.
+ * @param[in] transitionTable The transition table in the enum order.
+ * @param[in] stateMap Remapped row of every state name, a permutation of [0, statesMax).
+ * @param[in] sigMap Remapped column of every signal, a permutation of [0, eventsMax).
+ * @param[out] remappedTable The table to fill.
+ *
+ * @return true for success, false if a map is not a permutation
+ */
+bool FSM_RemapTransitionTable(
+    uint32_t statesMax,
+    uint32_t eventsMax,
+    const TEventHandler transitionTable[statesMax][eventsMax],
+    const uint16_t stateMap[statesMax],
+    const uint16_t sigMap[eventsMax],
+    TEventHandler remappedTable[statesMax][eventsMax]);
+
+/**
+ * @brief Attaches lookup counters to a transition table
+ * @details FSM_ProcessEventToNextStateFromTransitionTable counts every lookup of the table,
+ * handled or not, in hits[state][sig]. The counters are compiled in with FSM_PROFILE defined
+ * for the library build only, so production builds pay nothing.
+ *
+ * ### Example
+ * @code
+ * uint64_t hits[STATES_MAX][EVENTS_MAX];
+ * TFsmProfile profile;
+ *
+ * FSM_AttachProfile(&profile, transitionTable, STATES_MAX, EVENTS_MAX, &hits[0][0]);
+ * // ... run the representative load, then dump "state sig hits" lines for tools/fsm-pgo
+ * @endcode
+ *
+ * @param[out] profile The profile, allocated by the user.
+ * @param[in] transitionTable The profiled table.
+ * @param[in] statesMax The maximum number of states.
+ * @param[in] eventsMax The maximum number of events.
+ * @param[in] hits Counters [statesMax][eventsMax], zeroed on attach.
+ *
+ * @return true for success, false in a build without FSM_PROFILE
+ */
+bool FSM_AttachProfile(
+    TFsmProfile *profile,
+    const void *transitionTable,
+    uint32_t statesMax,
+    uint32_t eventsMax,
+    uint64_t *hits);
+
+/**
+ * @brief Detaches lookup counters from their transition table, the counters keep their values
+ * @param[in,out] profile The attached profile.
+ */
+void FSM_DetachProfile(TFsmProfile *profile);
+
+/**
+ * @brief Processes an incoming event with table-only transitions
+ * @details Looks up the next state table first: [currState][event] => nextState, a single load with no call.
+ * Falls back to the state handler from transition table for NULL cells: [currState][event] => f(event): nextState
+ *
+ * ### Example
+ * @code
+ * const TState *const nextStatesTable[STATES_MAX][EVENTS_MAX] = {
+ *     [EMPTY_HOOKS_ST] = { [GO_SUCCESS_HOOKS_ST] = &statesList[SUCCESS_HOOKS_ST] },
+ * };
+ *
+ * FSM_ProcessEventToNextStateFromTables(&activeObject, event, STATES_MAX, EVENTS_MAX, nextStatesTable, transitionTable);
+ * @endcode
+ *
+ * @param[in] activeObject The active object.
+ * @param[in] event The incoming event.
+ * @param[in] statesMax The maximum number of states.
+ * @param[in] eventsMax The maximum number of events.
+ * @param[in] nextStatesTable The next state table for state-event pairs without side effects.
+ * @param[in] transitionTable The transition table for state-event pairs with handlers, may be NULL.
+ *
+ * @return A pointer to the next state
+ * @returns 0 (EMPTY_STATE) in case of both next state and handler lack in tables
+ * @returns -1 (INVALID_STATE) in case of invalid input args
+ */
+const TState *FSM_ProcessEventToNextStateFromTables(
+    TActiveObject *const activeObject, /**< The active object. */
+    TEvent event, /**< The incoming event. */
+    uint32_t statesMax, /**< The maximum number of states. */
+    uint32_t eventsMax, /**< The maximum number of events. */
+    const TState *const nextStatesTable[statesMax][eventsMax], /**< The next state table for state-event. */
+    const TEventHandler (*transitionTable)[eventsMax]); /**< The transition table for state-event, may be NULL. */
+
 /**
  * @brief Transitions the Active Object to the next state
  * @details Invokes state hooks (onEnter, onTraverse, onExit) 
@@ -53,29 +213,134 @@ bool FSM_TraverseAOToNextState(
     TActiveObject *const activeObject,
     const TState *const nextState);    
 
+/**
+ * @brief Compiles transition plans for every (from, to) states pair
+ * @details Resolves once what FSM_TraverseAOToNextState decides on every transition:
+ * self-transition (onTraverse) or a real one (onExit, onEnter, onTraverse), dropping NULL hooks.
+ * Should be called once at the machine startup, plans are [from state name][to state name].
+ *
+ * ### Example:
+ * @code
+ * TTransitionPlan transitionPlans[STATES_MAX][STATES_MAX];
+ *
+ * FSM_CompileTransitionPlans(statesList, STATES_MAX, transitionPlans);
+ * // ...
+ * FSM_TraverseAOByPlan(&activeObject, STATES_MAX, transitionPlans, nextState);
+ * @endcode
+ *
+ * @param[in] states The states list indexed by state name.
+ * @param[in] statesMax The maximum number of states.
+ * @param[out] plans The plans table to fill.
+ */
+void FSM_CompileTransitionPlans(
+    const TState *const states,
+    uint32_t statesMax,
+    TTransitionPlan plans[statesMax][statesMax]);
+
+/**
+ * @brief Transitions the Active Object to the next state by a precomputed plan
+ * @details Same hooks and results as FSM_TraverseAOToNextState, without checks for hooks presence.
+ *
+ * @param[in,out] activeObject The active object.
+ * @param[in] statesMax The maximum number of states.
+ * @param[in] plans The plans compiled by FSM_CompileTransitionPlans.
+ * @param[in] nextState The next state to transition to.
+ *
+ * @return True if the transition is successful, false otherwise.
+ */
+bool FSM_TraverseAOByPlan(
+    TActiveObject *const activeObject,
+    uint32_t statesMax,
+    const TTransitionPlan plans[statesMax][statesMax],
+    const TState *const nextState);
+
+/**
+ * @brief Compiles the per-state bitmaps of signals with a transition for the dispatch-time signal filter
+ * @details A signal is accepted by a state if its next state table cell or transition table cell is not NULL,
+ * the rest would only reach EMPTY_STATE after taking a queue slot. Should be called once at the machine startup.
+ *
+ * ### Example:
+ * @code
+ * TSignalMask accepted[STATES_MAX][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)];
+ *
+ * FSM_CompileAcceptedSignals(STATES_MAX, EVENTS_MAX, nextStatesTable, transitionTable, accepted);
+ * @endcode
+ *
+ * @param[in] statesMax The maximum number of states.
+ * @param[in] eventsMax The maximum number of events.
+ * @param[in] nextStatesTable The next state table for state-event pairs, may be NULL.
+ * @param[in] transitionTable The transition table for state-event pairs, may be NULL.
+ * @param[out] accepted The bitmaps to fill, [state name][mask words].
+ */
+void FSM_CompileAcceptedSignals(
+    uint32_t statesMax,
+    uint32_t eventsMax,
+    const TState *const (*nextStatesTable)[eventsMax],
+    const TEventHandler (*transitionTable)[eventsMax],
+    TSignalMask accepted[statesMax][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(eventsMax)]);
+
 /** @brief Checks if two states are equal based on their name. */
 bool FSM_IsEqualStates(const TState *const stateA, const TState *const stateB);
 
 /** @brief Checks if a state is valid (i.e., not an empty or invalid state). */
 bool FSM_IsValidState(const TState *const state);
 
+/**
+ * @brief Guard chain case macro: condition function => event handler function
+ * @note should be used inside DECLARE_GUARD_CHAIN only, cases are separated by spaces, not commas
+ */
+#define GUARD_CASE(CONDITION_FUNCTION, HANDLER_FUNCTION) \
+    if (CONDITION_FUNCTION(activeObject, event)) return HANDLER_FUNCTION(activeObject, event);
+
+/**
+ * @brief Guard chain function declaration macro
+ * @details Generates a single flat TEventHandler function from an ordered list of GUARD_CASE(condition, handler)
+ * and an else handler: the first case with true condition wins, else handler is called if none matches.
+ * Conditions and handlers are called directly, without intermediate guard functions,
+ * declare them static inline in the same translation unit to let the compiler collapse the whole chain into one function.
+ * The generated function is a regular TEventHandler, so it may be used in a transition table.
+ *
+ * ### Example
+ * @code
+ * static inline bool canRetry(TActiveObject *const activeObject, TEvent event) { ... };
+ * static inline bool isBackoffElapsed(TActiveObject *const activeObject, TEvent event) { ... };
+ *
+ * DECLARE_GUARD_CHAIN(onRequestError,
+ *     GUARD_CASE(isBackoffElapsed, performRequest)
+ *     GUARD_CASE(canRetry, waitBackoff),
+ *     requestError);
+ *
+ * const TEventHandler transitionTable[STATES_MAX][EVENTS_MAX] = {
+ *     [PENDING_ST] = { [REQUEST_ERROR_SIG] = onRequestError },
+ * };
+ * @endcode
+ */
+#define DECLARE_GUARD_CHAIN(GUARD_NAME, GUARD_CASES, ELSE_FUNCTION) \
+    const TState* GUARD_NAME(TActiveObject *const activeObject, TEvent event) { \
+        GUARD_CASES \
+        return ELSE_FUNCTION(activeObject, event); \
+    }
+
 /**
  * @brief Guard function declaration macro
  * @note should be invoked before using appropriate GUARD macro in transition table
  * @details Creates a guard function for a given condition function and two event handler functions.
  * For true condition result the first event handler function will be called, for false - the second one.
+ * Shorthand for a DECLARE_GUARD_CHAIN with a single case.
  *
  * ### Example
  * @code
- * TODO make an example
+ * DECLARE_GUARD(canRetry, performRequest, requestError);
+ *
+ * const TEventHandler transitionTable[STATES_MAX][EVENTS_MAX] = {
+ *     [PENDING_ST] = { [TIMEOUT_SIG] = GUARD(canRetry, performRequest, requestError) },
+ * };
  * @endcode
  */
 #define DECLARE_GUARD(CONDITION_FUNCTION, ON_TRUE_FUNCTION, ON_FALSE_FUNCTION) \
-    const TState* GUARD_##CONDITION_FUNCTION##_##ON_TRUE_FUNCTION##_##ON_FALSE_FUNCTION(TActiveObject *const activeObject, TEvent event) { \
-        if (CONDITION_FUNCTION(activeObject, event)) return ON_TRUE_FUNCTION(activeObject, event);  \
-        return ON_FALSE_FUNCTION(activeObject, event);  \
-        return (const TState*)NULL;   \
-    };
+    DECLARE_GUARD_CHAIN(GUARD(CONDITION_FUNCTION, ON_TRUE_FUNCTION, ON_FALSE_FUNCTION), \
+                        GUARD_CASE(CONDITION_FUNCTION, ON_TRUE_FUNCTION), \
+                        ON_FALSE_FUNCTION)
 
 /**
  * @brief Guard function macro
@@ -0,0 +1,90 @@
+/**
+ * @file fsm_impl.h
+ *
+ * @brief Type-specialized FSM generator
+ * @see fsm.h for the generic FSM.
+ * @see active_object_impl.h for the type-specialized Active Object.
+ *
+ * @details Generates a transition table lookup for a user-defined object, event type and state enum.
+ * The object may be any struct with a `state` field of STATE_TYPE, e.g. an Active Object from DECLARE_ACTIVE_OBJECT.
+ * Handlers take the typed object and event and return the next state enum value.
+ *
+ * ### Example:
+ * @code
+ * DECLARE_FSM(Elevator, ELEVATOR_EVENT, ELEVATOR_STATE, EVENTS_MAX, STATES_MAX);
+ * FSM_IMPLEMENTATION(Elevator, ELEVATOR_EVENT, ELEVATOR_STATE, EVENTS_MAX, STATES_MAX);
+ *
+ * const ELEVATOR_EVENT_HANDLE_F transitionTable[STATES_MAX][EVENTS_MAX] = {
+ *     [IDLE][BUTTON_UP_PRESSED] = handleIdle,
+ * };
+ *
+ * elevator.state = Elevator_FSM_ProcessEventToNextStateFromTransitionTable(&elevator, event, transitionTable);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef FSM_IMPL_H
+#define FSM_IMPL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "./fsm.h"
+
+/**
+ * @brief FSM declaration macro: types and prototypes
+ * @details Declares:
+ * - AO_TYPE##_STATE: the state type of the object;
+ * - EVENT_TYPE##_HANDLE_F: event handler type, [state][event] => f(event): nextState.
+ */
+#define DECLARE_FSM(AO_TYPE, EVENT_TYPE, STATE_TYPE, EVENTS_MAX, STATES_MAX) \
+    typedef STATE_TYPE AO_TYPE##_STATE; \
+    typedef STATE_TYPE (*EVENT_TYPE##_HANDLE_F)(AO_TYPE *const activeObject, EVENT_TYPE event); \
+    \
+    static inline STATE_TYPE AO_TYPE##_FSM_ProcessEventToNextStateFromTransitionTable( \
+            AO_TYPE *const activeObject, \
+            EVENT_TYPE event, \
+            const EVENT_TYPE##_HANDLE_F transitionTable[STATES_MAX][EVENTS_MAX]);
+
+/**
+ * @brief FSM implementation macro
+ * @note DECLARE_FSM with the same args should be invoked before.
+ * @details Defines AO_TYPE##_FSM_ProcessEventToNextStateFromTransitionTable:
+ * invokes the handler for the current state and event,
+ * returns the current state for a missing handler or out of range state/event.
+ */
+#define FSM_IMPLEMENTATION(AO_TYPE, EVENT_TYPE, STATE_TYPE, EVENTS_MAX, STATES_MAX) \
+    static inline STATE_TYPE AO_TYPE##_FSM_ProcessEventToNextStateFromTransitionTable( \
+            AO_TYPE *const activeObject, \
+            EVENT_TYPE event, \
+            const EVENT_TYPE##_HANDLE_F transitionTable[STATES_MAX][EVENTS_MAX]) { \
+        if ((uint32_t) activeObject->state >= (uint32_t) (STATES_MAX) \
+            || (uint32_t) event.sig >= (uint32_t) (EVENTS_MAX)) \
+            return activeObject->state; \
+        const EVENT_TYPE##_HANDLE_F eventHandler = transitionTable[activeObject->state][event.sig]; \
+        if (eventHandler) return eventHandler(activeObject, event); \
+        return activeObject->state; \
+    }
+
+/**
+ * @brief Typed guard function declaration macro
+ * @note DECLARE_FSM should be invoked before, the guard is referenced in a table with GUARD macro
+ * @details For true condition result the first event handler function will be called, for false - the second one.
+ *
+ * ### Example
+ * @code
+ * DECLARE_TYPED_GUARD(REQUEST_AO, REQUEST_EVENT, canRetry, performRequest, requestError);
+ *
+ * const REQUEST_EVENT_HANDLE_F requestTransitionTable[REQUEST_ST_MAX][REQUEST_SIG_MAX] = {
+ *     [PENDING_ST] = {[TIMEOUT_SIG] = GUARD(canRetry, performRequest, requestError)},
+ * };
+ * @endcode
+ */
+#define DECLARE_TYPED_GUARD(AO_TYPE, EVENT_TYPE, CONDITION_FUNCTION, ON_TRUE_FUNCTION, ON_FALSE_FUNCTION) \
+    static AO_TYPE##_STATE GUARD(CONDITION_FUNCTION, ON_TRUE_FUNCTION, ON_FALSE_FUNCTION)(AO_TYPE *const activeObject, EVENT_TYPE event) { \
+        if (CONDITION_FUNCTION(activeObject, event)) return ON_TRUE_FUNCTION(activeObject, event); \
+        return ON_FALSE_FUNCTION(activeObject, event); \
+    }
+
+#endif //FSM_IMPL_H
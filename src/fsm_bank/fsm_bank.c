@@ -0,0 +1,100 @@
+#include <string.h>
+
+#include "./fsm_bank.h"
+
+void FSMBank_Initialize(TFSMBank *bank,
+                        TFSMBankState *states,
+                        uint32_t instancesCount,
+                        uint32_t statesMax,
+                        uint32_t eventsMax,
+                        const TFSMBankHandler handlers[statesMax][eventsMax],
+                        const TFSMBankState nextStates[statesMax][eventsMax]) {
+    bank->states = states;
+    bank->instancesCount = instancesCount;
+    bank->statesMax = statesMax;
+    bank->eventsMax = eventsMax;
+    bank->handlers = (const TFSMBankHandler *) handlers;
+    bank->nextStates = (const TFSMBankState *) nextStates;
+    bank->keys = NULL;
+    bank->runOffsets = NULL;
+    bank->runInstances = NULL;
+    bank->stepsMax = 0;
+
+    memset(states, 0, sizeof(TFSMBankState) * instancesCount);
+}
+
+void FSMBank_SetScratch(TFSMBank *bank, uint32_t *keys, uint32_t *runOffsets, uint32_t *runInstances, uint32_t stepsMax) {
+    bank->keys = keys;
+    bank->runOffsets = runOffsets;
+    bank->runInstances = runInstances;
+    bank->stepsMax = stepsMax;
+}
+
+uint32_t FSMBank_Step(TFSMBank *bank, const TFSMBankStep *steps, uint32_t count) {
+    if (NULL == bank || NULL == steps || NULL == bank->handlers || count > bank->stepsMax) return 0;
+    if (0 == count || NULL == bank->keys || NULL == bank->runOffsets || NULL == bank->runInstances) return 0;
+
+    const uint32_t cellsCount = bank->statesMax * bank->eventsMax;
+    TFSMBankState *const states = bank->states;
+    uint32_t *const keys = bank->keys;
+    uint32_t *const runOffsets = bank->runOffsets;
+    uint32_t processed = 0;
+
+    // 1. Gather (state, sig) cell of each step, cellsCount marks a skipped step
+    for (uint32_t i = 0; i < count; i++) {
+        const uint32_t instance = steps[i].instance;
+        const uint32_t sig = (uint32_t) steps[i].sig;
+        // A state out of the table, e.g. written by a handler, would index past the cells
+        const bool isValid = instance < bank->instancesCount && sig < bank->eventsMax
+                             && (uint32_t) states[instance] < bank->statesMax;
+
+        keys[i] = isValid ? (uint32_t) states[instance] * bank->eventsMax + sig : cellsCount;
+        processed += isValid;
+    }
+
+    // 2. Resolve table-only cells with no calls, mark them as done
+    if (bank->nextStates) {
+        for (uint32_t i = 0; i < count; i++) {
+            const uint32_t key = keys[i];
+
+            if (key == cellsCount || bank->handlers[key]) continue;
+
+            const TFSMBankState nextState = bank->nextStates[key];
+            if (nextState) states[steps[i].instance] = nextState;
+
+            keys[i] = cellsCount;
+        }
+    }
+
+    // 3. Group remaining steps by cell: counting sort of instances into runs
+    memset(runOffsets, 0, sizeof(uint32_t) * (cellsCount + 1));
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (keys[i] != cellsCount) runOffsets[keys[i] + 1]++;
+    }
+
+    for (uint32_t key = 1; key <= cellsCount; key++) {
+        runOffsets[key] += runOffsets[key - 1];
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (keys[i] != cellsCount) bank->runInstances[runOffsets[keys[i]]++] = steps[i].instance;
+    }
+
+    // 4. Invoke each handler once over its run, runOffsets[key] is the end of the key run now
+    uint32_t runStart = 0;
+
+    for (uint32_t key = 0; key < cellsCount; key++) {
+        const uint32_t runEnd = runOffsets[key];
+
+        if (runEnd > runStart) {
+            const TFSMBankHandler handler = bank->handlers[key];
+            // Cells without handler are filtered out before, unless nextStates table is absent
+            if (handler) handler(bank, (int) (key % bank->eventsMax), &bank->runInstances[runStart], runEnd - runStart);
+        }
+
+        runStart = runEnd;
+    }
+
+    return processed;
+}
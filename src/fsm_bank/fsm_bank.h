@@ -0,0 +1,125 @@
+/**
+ * @file fsm_bank.h
+ *
+ * @brief FSM Bank - many instances of the same machine stepped in bulk
+ * @see fsm.h for the single Active Object FSM.
+ *
+ * @details The bank keeps only the current state of each instance,
+ * contiguously in a single array (struct of arrays), instead of a TActiveObject per instance.
+ * Transitions are described by two flat [statesMax][eventsMax] tables:
+ * - handlers: called once per run of instances sharing the same (state, sig) cell,
+ *   the handler sets the next state of every instance in the run;
+ * - nextStates: table-only transitions, used when the handler cell is NULL,
+ *   0 (no state) means no transition.
+ *
+ * A bulk step takes an array of (instance, sig) pairs:
+ * 1. gathers the (state, sig) cell of each pair,
+ * 2. resolves table-only cells in a single gather/store pass, with no calls,
+ * 3. groups the remaining pairs by cell (counting sort) and invokes each handler once over its run.
+ *
+ * @note Each instance should appear at most once per FSMBank_Step call,
+ * further events of the same instance go to the next call.
+ * @note State hooks are not supported by the bank, use handlers for side effects.
+ *
+ * ### Example:
+ * @code
+ * TFSMBankState sessionStates[SESSIONS_MAX];
+ * uint32_t keys[STEPS_MAX], runInstances[STEPS_MAX], runOffsets[SESSION_ST_MAX * SESSION_SIG_MAX + 1];
+ *
+ * FSMBank_Initialize(&bank, sessionStates, SESSIONS_MAX, SESSION_ST_MAX, SESSION_SIG_MAX, sessionHandlers, sessionNextStates);
+ * FSMBank_SetScratch(&bank, keys, runOffsets, runInstances, STEPS_MAX);
+ *
+ * TFSMBankStep steps[] = {{.instance = 0, .sig = OPEN_SIG}, {.instance = 42, .sig = CLOSE_SIG}};
+ * FSMBank_Step(&bank, steps, 2);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef FSM_BANK_H
+#define FSM_BANK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/** @brief State name of a bank instance */
+typedef uint16_t TFSMBankState;
+
+typedef struct TFSMBank TFSMBank;
+
+/**
+ * @brief Handler invoked once per run of instances in the same state receiving the same signal
+ *
+ * @param bank The bank
+ * @param sig The signal
+ * @param instances Instances of the run
+ * @param count Number of instances in the run
+ */
+typedef void (*TFSMBankHandler)(TFSMBank *const bank, int sig, const uint32_t *const instances, uint32_t count);
+
+/** @brief Single bulk step entry: signal for an instance */
+typedef struct {
+    uint32_t instance;  /**< Instance index */
+    int sig;            /**< Signal for the instance */
+} TFSMBankStep;
+
+/** @brief Bank of identical FSM instances */
+struct TFSMBank {
+    TFSMBankState *states;              /**< Current state of each instance */
+    uint32_t instancesCount;            /**< Number of instances */
+    uint32_t statesMax;                 /**< The maximum number of states */
+    uint32_t eventsMax;                 /**< The maximum number of events */
+    const TFSMBankHandler *handlers;    /**< Flat [statesMax][eventsMax] handlers table */
+    const TFSMBankState *nextStates;    /**< Flat [statesMax][eventsMax] table-only transitions */
+    uint32_t *keys;                     /**< Scratch: cell of each step, [stepsMax] */
+    uint32_t *runOffsets;               /**< Scratch: run offsets, [statesMax * eventsMax + 1] */
+    uint32_t *runInstances;             /**< Scratch: instances grouped by cell, [stepsMax] */
+    uint32_t stepsMax;                  /**< Max steps number per FSMBank_Step call */
+};
+
+/**
+ * @brief Initializes the bank, all instances are set to state 0
+ * @note The states array and tables must be allocated by the user.
+ *
+ * @param bank The bank to initialize
+ * @param states Array of instancesCount states
+ * @param instancesCount Number of instances
+ * @param statesMax The maximum number of states
+ * @param eventsMax The maximum number of events
+ * @param handlers Handlers table, NULL cell means table-only transition
+ * @param nextStates Table-only transitions, 0 cell means no transition, may be NULL
+ */
+void FSMBank_Initialize(TFSMBank *bank,
+                        TFSMBankState *states,
+                        uint32_t instancesCount,
+                        uint32_t statesMax,
+                        uint32_t eventsMax,
+                        const TFSMBankHandler handlers[statesMax][eventsMax],
+                        const TFSMBankState nextStates[statesMax][eventsMax]);
+
+/**
+ * @brief Provides scratch buffers for FSMBank_Step
+ * @note The buffers must be allocated by the user.
+ *
+ * @param bank The bank
+ * @param keys Array of stepsMax
+ * @param runOffsets Array of statesMax * eventsMax + 1
+ * @param runInstances Array of stepsMax
+ * @param stepsMax Max steps number per FSMBank_Step call
+ */
+void FSMBank_SetScratch(TFSMBank *bank, uint32_t *keys, uint32_t *runOffsets, uint32_t *runInstances, uint32_t stepsMax);
+
+/**
+ * @brief Processes a batch of (instance, sig) steps
+ * @details Steps with out of range instance, signal or instance state are skipped.
+ *
+ * @param bank The bank
+ * @param steps Steps to process
+ * @param count Number of steps, up to stepsMax
+ * @return Number of processed steps
+ * @returns 0 in case of invalid input args, no steps or no scratch buffers
+ */
+uint32_t FSMBank_Step(TFSMBank *bank, const TFSMBankStep *steps, uint32_t count);
+
+#endif //FSM_BANK_H
@@ -0,0 +1,93 @@
+/**
+ * @file handle.h
+ *
+ * @brief Generation-tagged handles of slots in user-allocated tables
+ * @see registry.h, request.h and simulation.h for the tables handing out handles.
+ *
+ * @details A handle encodes a slot index and the slot generation: [generation:32][slot index:32].
+ * The generation is bumped every time the slot is freed, so every copy of the old handle becomes stale
+ * and a lookup rejects it with a single compare. Handle 0 (generation 0) is never given out.
+ *
+ * Free slots are usually reused LIFO, so a single hot slot may go through all its generations.
+ * A slot whose generation saturates is retired instead of being reused: a stale handle never
+ * resolves to a newer owner of the slot, the table loses a slot after 2^32 - 1 reuses of it.
+ *
+ * ### Example:
+ * @code
+ * THandle handle = Handle_Make(index, slot->generation);
+ *
+ * // lookup
+ * TSlot *slot = &slots[Handle_GetIndex(handle)];
+ * if (slot->isUsed && Handle_GetGeneration(handle) == slot->generation) return slot;
+ *
+ * // free
+ * if (Handle_NextGeneration(&slot->generation)) pushFree(slot);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/** @brief Bits of the handle holding the slot index, the rest holds the slot generation */
+#define HANDLE_INDEX_BITS           (32)
+#define HANDLE_INDEX_MASK           (UINT32_MAX)
+
+/** @brief Handle which is never given to a slot */
+#define HANDLE_INVALID              (0)
+
+/** @brief Generation of a never used slot */
+#define HANDLE_GENERATION_FIRST     (1u)
+
+/** @brief Generation of the last use of a slot, the slot is retired when freed */
+#define HANDLE_GENERATION_LAST      (UINT32_MAX)
+
+/** @brief Generation-tagged handle: [generation:32][slot index:32] */
+typedef uint64_t THandle;
+
+/**
+ * @brief Builds a handle from the slot index and generation
+ * @param index Slot index
+ * @param generation Slot generation, HANDLE_GENERATION_FIRST or later
+ * @return The handle
+ */
+static inline THandle Handle_Make(uint32_t index, uint32_t generation) {
+    return ((THandle) generation << HANDLE_INDEX_BITS) | index;
+}
+
+/**
+ * @brief Returns the slot index of the handle
+ * @param handle The handle
+ * @return Slot index, to be range checked by the table
+ */
+static inline uint32_t Handle_GetIndex(THandle handle) {
+    return (uint32_t) (handle & HANDLE_INDEX_MASK);
+}
+
+/**
+ * @brief Returns the slot generation of the handle
+ * @param handle The handle
+ * @return Slot generation, 0 for HANDLE_INVALID
+ */
+static inline uint32_t Handle_GetGeneration(THandle handle) {
+    return (uint32_t) (handle >> HANDLE_INDEX_BITS);
+}
+
+/**
+ * @brief Makes all handles of a freed slot stale
+ * @param[in,out] generation The slot generation
+ * @return true if the slot may be reused, false if the generation is saturated and the slot is retired
+ */
+static inline bool Handle_NextGeneration(uint32_t *generation) {
+    if (HANDLE_GENERATION_LAST == *generation) return false;
+
+    (*generation)++;
+    return true;
+}
+
+#endif //HANDLE_H
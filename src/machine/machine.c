@@ -0,0 +1,151 @@
+#include "./machine.h"
+
+/** @brief Wrap-safe "a is earlier than b" */
+static inline bool _isBefore(uint32_t a, uint32_t b);
+
+/** @brief Default state translation: the state with the same name, NULL if the next version has no such state */
+static inline const TState *_mapByName(const TMachine *next, const TState *state);
+
+/** @brief Checks if every worker has reported a quiescent state since the epoch */
+static bool _isGracePeriodOver(TMachineHandle *handle, uint32_t epoch);
+
+/** @brief Index of the descriptor in the retired array, retiredCount if it is not retired */
+static uint32_t _findRetired(const TMachineHandle *handle, const TMachine *machine);
+
+void Machine_Initialize(TMachineHandle *handle, TMachine *machine, TMachineReader *readers, uint32_t readersCount,
+                        TMachineRetired *retired, uint32_t retiredCapacity, TMachineRelease release, void *const ctx) {
+    handle->current = machine;
+    handle->epoch = 0;
+    handle->readers = readers;
+    handle->readersCount = readersCount;
+    handle->retired = retired;
+    handle->retiredCapacity = retiredCapacity;
+    handle->retiredCount = 0;
+    handle->release = release;
+    handle->ctx = ctx;
+
+    for (uint32_t i = 0; i < readersCount; i++) {
+        readers[i].epoch = 0;
+    }
+}
+
+bool Machine_Publish(TMachineHandle *handle, TMachine *machine) {
+    if (NULL == machine) return false;
+
+    TMachine *previous = handle->current;
+
+    if (machine == previous) return true;
+
+    uint32_t republished = _findRetired(handle, machine);
+
+    if (republished == handle->retiredCount && handle->retiredCount >= handle->retiredCapacity) return false;
+
+    // A rolled back descriptor is current again, it must not be released with the retired ones
+    if (republished < handle->retiredCount) {
+        handle->retired[republished] = handle->retired[--handle->retiredCount];
+    }
+
+    // The descriptor is published before the epoch moves: a worker seeing the new epoch sees the new descriptor
+    MACHINE_STORE_RELEASE(&handle->current, machine);
+    uint32_t epoch = MACHINE_ADD_RELEASE(&handle->epoch, 1u);
+
+    handle->retired[handle->retiredCount++] = (TMachineRetired) {.machine = previous, .epoch = epoch};
+    return true;
+}
+
+void Machine_Quiescent(TMachineHandle *handle, uint32_t reader) {
+    if (reader >= handle->readersCount) return;
+
+    MACHINE_STORE_RELEASE(&handle->readers[reader].epoch, MACHINE_LOAD_ACQUIRE(&handle->epoch));
+}
+
+uint32_t Machine_Reclaim(TMachineHandle *handle) {
+    uint32_t releasedCount = 0;
+    uint32_t keptCount = 0;
+
+    for (uint32_t i = 0; i < handle->retiredCount; i++) {
+        TMachineRetired retired = handle->retired[i];
+
+        if (!_isGracePeriodOver(handle, retired.epoch) || 0 != MACHINE_LOAD_ACQUIRE(&retired.machine->objectsCount)) {
+            handle->retired[keptCount++] = retired;
+            continue;
+        }
+
+        if (handle->release) handle->release(retired.machine, handle->ctx);
+        releasedCount++;
+    }
+
+    handle->retiredCount = keptCount;
+    return releasedCount;
+}
+
+void MachineActiveObject_Initialize(TMachineActiveObject *me, TMachineHandle *handle, const uint32_t id,
+                                    TEvent *events, uint32_t capacity, int stateName) {
+    TMachine *machine = MACHINE_LOAD_ACQUIRE(&handle->current);
+
+    ActiveObject_Initialize(&me->super, id, events, capacity);
+    me->super.state = &machine->states[stateName];
+    me->handle = handle;
+    me->machine = machine;
+    MACHINE_ADD_RELEASE(&machine->objectsCount, 1u);
+}
+
+bool MachineActiveObject_Migrate(TMachineActiveObject *me) {
+    TMachine *current = MACHINE_LOAD_ACQUIRE(&me->handle->current);
+    TMachine *previous = me->machine;
+
+    if (current == previous) return true;
+
+    const TState *state = current->mapState
+                          ? current->mapState(current, previous, me->super.state)
+                          : _mapByName(current, me->super.state);
+
+    if (NULL == state) return false;
+
+    me->super.state = state;
+    me->machine = current;
+    MACHINE_ADD_RELEASE(&current->objectsCount, 1u);
+
+    // The last access to the previous descriptor, it may be released right after
+    MACHINE_SUB_RELEASE(&previous->objectsCount, 1u);
+    return true;
+}
+
+const TState *MachineActiveObject_ProcessEvent(TMachineActiveObject *me, TEvent event) {
+    MachineActiveObject_Migrate(me);
+
+    const TMachine *machine = me->machine;
+
+    return FSM_ProcessEventToNextStateFromTransitionTable(
+            &me->super,
+            event,
+            machine->statesMax,
+            machine->eventsMax,
+            (const TEventHandler (*)[machine->eventsMax]) machine->transitionTable);
+}
+
+static inline bool _isBefore(uint32_t a, uint32_t b) {
+    return (int32_t) (a - b) < 0;
+}
+
+static inline const TState *_mapByName(const TMachine *next, const TState *state) {
+    if (NULL == state || state->name < 0 || (uint32_t) state->name >= next->statesMax) return NULL;
+
+    return &next->states[state->name];
+}
+
+static bool _isGracePeriodOver(TMachineHandle *handle, uint32_t epoch) {
+    for (uint32_t i = 0; i < handle->readersCount; i++) {
+        if (_isBefore(MACHINE_LOAD_ACQUIRE(&handle->readers[i].epoch), epoch)) return false;
+    }
+
+    return true;
+}
+
+static uint32_t _findRetired(const TMachineHandle *handle, const TMachine *machine) {
+    uint32_t i = 0;
+
+    while (i < handle->retiredCount && handle->retired[i].machine != machine) i++;
+
+    return i;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file machine.h
+ *
+ * @brief Hot-swappable versioned machine descriptors with RCU-style publication
+ * @see fsm.h for the transition tables and hooks of a single machine.
+ *
+ * @details A machine descriptor bundles a version of the states list and the transition table.
+ * Active Objects reach the current descriptor through an atomic pointer in a machine handle,
+ * Machine_Publish swaps it with a single release store, so an updated behaviour (e.g. tables and handlers
+ * of a freshly loaded plugin) is rolled out without stopping the event processing or locking the lookup.
+ *
+ * Every object keeps the descriptor its current state belongs to. Before its next event is looked up,
+ * an object of an older version migrates: the new descriptor mapState translates the current state,
+ * by state name by default. Readers are wait-free: an acquire load and a pointer compare per event,
+ * a migration is a bounded mapping and two atomic counter updates.
+ *
+ * Old descriptors are reclaimed with quiescent-state-based reclamation (QSBR): every worker reports
+ * Machine_Quiescent at run-to-completion boundaries, where it holds no descriptor pointer loaded from the handle.
+ * A retired descriptor is released once every worker has reported after its retirement and no object still uses it,
+ * idle objects can be migrated ahead with MachineActiveObject_Migrate.
+ * Publish and reclaim are called by a single updater thread.
+ *
+ * ### Example:
+ * @code
+ * TMachine machineV1 = {.version = 1, .statesMax = ST_MAX, .eventsMax = SIG_MAX, .states = statesV1, .transitionTable = &tableV1[0][0]};
+ * TMachineReader readers[WORKERS_MAX];
+ * TMachineRetired retired[RETIRED_MAX];
+ *
+ * Machine_Initialize(&handle, &machineV1, readers, WORKERS_MAX, retired, RETIRED_MAX, unloadPlugin, NULL);
+ * MachineActiveObject_Initialize(&device, &handle, DEVICE_AO_ID, events, QUEUE_MAX_SIZE, IDLE_ST);
+ *
+ * // worker
+ * TEvent event = ActiveObject_ProcessQueue(&device.super);
+ * const TState *nextState = MachineActiveObject_ProcessEvent(&device, event);
+ * if (FSM_IsValidState(nextState)) FSM_TraverseAOToNextState(&device.super, nextState);
+ * Machine_Quiescent(&handle, workerIndex);
+ *
+ * // updater
+ * Machine_Publish(&handle, loadPlugin("device_v2.so"));
+ * Machine_Reclaim(&handle);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef MACHINE_H
+#define MACHINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+#include "../fsm/fsm.h"
+
+/** @brief Acquire load of a value written by another thread */
+#ifndef MACHINE_LOAD_ACQUIRE
+#define MACHINE_LOAD_ACQUIRE(PTR)           __atomic_load_n((PTR), __ATOMIC_ACQUIRE)
+#endif
+
+/** @brief Release store, publishes previous writes to other threads */
+#ifndef MACHINE_STORE_RELEASE
+#define MACHINE_STORE_RELEASE(PTR, VALUE)   __atomic_store_n((PTR), (VALUE), __ATOMIC_RELEASE)
+#endif
+
+/** @brief Wait-free counter updates, release ordered, return the updated value */
+#ifndef MACHINE_ADD_RELEASE
+#define MACHINE_ADD_RELEASE(PTR, VALUE)     __atomic_add_fetch((PTR), (VALUE), __ATOMIC_RELEASE)
+#endif
+
+#ifndef MACHINE_SUB_RELEASE
+#define MACHINE_SUB_RELEASE(PTR, VALUE)     __atomic_sub_fetch((PTR), (VALUE), __ATOMIC_RELEASE)
+#endif
+
+typedef struct TMachine TMachine;
+
+/**
+ * @brief Translates a state of the previous descriptor version to the next one
+ * @param next The next descriptor
+ * @param previous The previous descriptor
+ * @param state State of the previous descriptor
+ * @return State of the next descriptor, NULL to keep the object on the previous version
+ */
+typedef const TState *(*TMachineMapState)(const TMachine *next, const TMachine *previous, const TState *state);
+
+/**
+ * @brief Releases a reclaimed descriptor, e.g. unloads its plugin
+ * @param machine The descriptor
+ * @param ctx User context
+ */
+typedef void (*TMachineRelease)(TMachine *machine, void *const ctx);
+
+/** @brief Versioned machine descriptor */
+struct TMachine {
+    uint32_t version;                       /**< User version number */
+    uint32_t statesMax;                     /**< The maximum number of states */
+    uint32_t eventsMax;                     /**< The maximum number of events */
+    const TState *states;                   /**< States list indexed by state name */
+    const TEventHandler *transitionTable;   /**< Flattened [statesMax][eventsMax] transition table */
+    TMachineMapState mapState;              /**< Translates states of older versions, NULL to map by state name */
+    uint32_t objectsCount;                  /**< Objects in the states of this descriptor, updated atomically */
+};
+
+/** @brief Quiescent state of a worker */
+typedef struct TMachineReader {
+    uint32_t epoch;             /**< Handle epoch seen at the last quiescent state, updated atomically */
+} TMachineReader;
+
+/** @brief Retired descriptor waiting for the grace period */
+typedef struct TMachineRetired {
+    TMachine *machine;          /**< Retired descriptor */
+    uint32_t epoch;             /**< Handle epoch after the retirement */
+} TMachineRetired;
+
+/** @brief Machine handle: published descriptor and its reclamation domain */
+typedef struct TMachineHandle {
+    TMachine *current;          /**< Published descriptor, swapped atomically */
+    uint32_t epoch;             /**< Incremented by every publish, updated atomically */
+    TMachineReader *readers;    /**< Workers array */
+    uint32_t readersCount;      /**< Number of workers */
+    TMachineRetired *retired;   /**< Retired descriptors array */
+    uint32_t retiredCapacity;   /**< Capacity of the retired descriptors array */
+    uint32_t retiredCount;      /**< Number of retired descriptors not released yet */
+    TMachineRelease release;    /**< Release callback, may be NULL */
+    void *ctx;                  /**< User context of the release callback */
+} TMachineHandle;
+
+/** @brief Active Object running a hot-swappable machine, extends TActiveObject */
+typedef struct TMachineActiveObject {
+    TActiveObject super;        /**< Base Active Object */
+    TMachineHandle *handle;     /**< Handle of the machine */
+    TMachine *machine;          /**< Descriptor of super.state */
+} TMachineActiveObject;
+
+/**
+ * @brief Initializes a handle with the first descriptor
+ * @param handle The handle
+ * @param machine The first descriptor
+ * @param readers Workers array, allocated by the user
+ * @param readersCount Number of workers
+ * @param retired Retired descriptors array, allocated by the user
+ * @param retiredCapacity Capacity of the retired descriptors array
+ * @param release Release callback of reclaimed descriptors, may be NULL
+ * @param ctx User context of the release callback
+ */
+void Machine_Initialize(TMachineHandle *handle, TMachine *machine, TMachineReader *readers, uint32_t readersCount,
+                        TMachineRetired *retired, uint32_t retiredCapacity, TMachineRelease release, void *const ctx);
+
+/**
+ * @brief Publishes the next descriptor with a single atomic store and retires the current one
+ * @details A rollback to a retired descriptor takes it back from the retired ones, so it is never released while current.
+ * Publishing the current descriptor again changes nothing.
+ * @param handle The handle
+ * @param machine The next descriptor
+ * @return true for success, false for NULL descriptor or no room for one more retired descriptor
+ */
+bool Machine_Publish(TMachineHandle *handle, TMachine *machine);
+
+/**
+ * @brief Reports a quiescent state of a worker: it holds no descriptor pointer loaded from the handle
+ * @param handle The handle
+ * @param reader Worker index
+ */
+void Machine_Quiescent(TMachineHandle *handle, uint32_t reader);
+
+/**
+ * @brief Releases retired descriptors past the grace period and with no objects left
+ * @param handle The handle
+ * @return Number of released descriptors
+ */
+uint32_t Machine_Reclaim(TMachineHandle *handle);
+
+/**
+ * @brief Initializes an Active Object in a state of the current descriptor
+ * @param me The Active Object
+ * @param handle Handle of the machine
+ * @param id Object ID
+ * @param events Events array, allocated by the user
+ * @param capacity Capacity of the events array
+ * @param stateName Initial state name
+ */
+void MachineActiveObject_Initialize(TMachineActiveObject *me, TMachineHandle *handle, const uint32_t id,
+                                    TEvent *events, uint32_t capacity, int stateName);
+
+/**
+ * @brief Moves an object of an older version to the current descriptor
+ * @param me The Active Object
+ * @return true if the object is on the current descriptor, false if mapState kept it on the previous one
+ */
+bool MachineActiveObject_Migrate(TMachineActiveObject *me);
+
+/**
+ * @brief Migrates the object if needed and processes the event with the transition table of its descriptor
+ * @param me The Active Object
+ * @param event The event
+ * @return The next state, to be passed to FSM_TraverseAOToNextState, see FSM_ProcessEventToNextStateFromTransitionTable
+ */
+const TState *MachineActiveObject_ProcessEvent(TMachineActiveObject *me, TEvent event);
+
+#endif //MACHINE_H
@@ -0,0 +1,116 @@
+#include "./mailbox.h"
+
+bool Mailbox_Initialize(TMailbox *mailbox, TMailboxMessage *messages, uint32_t capacity) {
+    // Capacity must be a power of two to wrap free running indices with a mask
+    if (NULL == messages || 0 == capacity || 0 != (capacity & (capacity - 1u))) return false;
+
+    mailbox->head = 0;
+    mailbox->cachedTail = 0;
+    mailbox->tail = 0;
+    mailbox->cachedHead = 0;
+    mailbox->messages = messages;
+    mailbox->mask = capacity - 1u;
+
+    return true;
+}
+
+bool Mailbox_Send(TMailbox *mailbox, TActiveObject *target, TEvent event) {
+    const uint32_t tail = mailbox->tail;
+
+    // Refresh the consumer index only when the cached one says the ring is full
+    if (tail - mailbox->cachedHead > mailbox->mask) {
+        mailbox->cachedHead = MAILBOX_LOAD_ACQUIRE(&mailbox->head);
+        if (tail - mailbox->cachedHead > mailbox->mask) return false;
+    }
+
+    TMailboxMessage *message = &mailbox->messages[tail & mailbox->mask];
+    message->target = target;
+    message->event = event;
+
+    MAILBOX_STORE_RELEASE(&mailbox->tail, tail + 1u);
+    return true;
+}
+
+bool Mailbox_Receive(TMailbox *mailbox, TMailboxMessage *message) {
+    const uint32_t head = mailbox->head;
+
+    // Refresh the producer index only when the cached one says the ring is empty
+    if (head == mailbox->cachedTail) {
+        mailbox->cachedTail = MAILBOX_LOAD_ACQUIRE(&mailbox->tail);
+        if (head == mailbox->cachedTail) return false;
+    }
+
+    *message = mailbox->messages[head & mailbox->mask];
+
+    MAILBOX_STORE_RELEASE(&mailbox->head, head + 1u);
+    return true;
+}
+
+uint32_t Mailbox_Deliver(TMailbox *mailbox, uint32_t max) {
+    uint32_t head = mailbox->head;
+
+    mailbox->cachedTail = MAILBOX_LOAD_ACQUIRE(&mailbox->tail);
+
+    uint32_t available = mailbox->cachedTail - head;
+    if (available > max) available = max;
+
+    uint32_t consumed = 0;
+    uint32_t delivered = 0;
+
+    while (consumed < available) {
+        const TMailboxMessage *message = &mailbox->messages[head & mailbox->mask];
+        TDispatchResult result = ActiveObject_Submit(message->target, message->event);
+
+        // Keep the message in the mailbox while its target queue is full, a rejected one is discarded
+        if (ACTIVE_OBJECT_DISPATCH_FULL == result) break;
+        if (ACTIVE_OBJECT_DISPATCH_REJECTED != result) delivered++;
+
+        head++;
+        consumed++;
+    }
+
+    // Publish the consumed index once per batch
+    if (consumed) MAILBOX_STORE_RELEASE(&mailbox->head, head);
+
+    return delivered;
+}
+
+bool MailboxMesh_Initialize(TMailboxMesh *mesh,
+                            TMailbox *mailboxes,
+                            TMailboxMessage *messages,
+                            uint32_t coresCount,
+                            uint32_t capacity) {
+    if (NULL == mailboxes || NULL == messages || 0 == coresCount) return false;
+
+    mesh->mailboxes = mailboxes;
+    mesh->coresCount = coresCount;
+
+    for (uint32_t i = 0; i < coresCount * coresCount; i++) {
+        if (!Mailbox_Initialize(&mailboxes[i], &messages[(size_t) i * capacity], capacity)) return false;
+    }
+
+    return true;
+}
+
+bool MailboxMesh_Send(TMailboxMesh *mesh, uint32_t fromCore, uint32_t toCore, TActiveObject *target, TEvent event) {
+    if (fromCore >= mesh->coresCount || toCore >= mesh->coresCount) return false;
+
+    // Same core: the target is run by the calling thread
+    if (fromCore == toCore) return ActiveObject_Dispatch(target, event);
+
+    return Mailbox_Send(&mesh->mailboxes[fromCore * mesh->coresCount + toCore], target, event);
+}
+
+uint32_t MailboxMesh_Poll(TMailboxMesh *mesh, uint32_t core) {
+    if (core >= mesh->coresCount) return 0;
+
+    uint32_t delivered = 0;
+
+    for (uint32_t fromCore = 0; fromCore < mesh->coresCount; fromCore++) {
+        if (fromCore == core) continue;
+
+        delivered += Mailbox_Deliver(&mesh->mailboxes[fromCore * mesh->coresCount + core], UINT32_MAX);
+    }
+
+    return delivered;
+}
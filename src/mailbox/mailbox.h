@@ -0,0 +1,168 @@
+/**
+ * @file mailbox.h
+ *
+ * @brief Lock-free SPSC mailbox and cross-core mailbox mesh for Active Objects
+ * @see active_object.h for the events destination.
+ *
+ * @details A mailbox is a single producer / single consumer ring of (target Active Object, event) messages.
+ * The ring pointer and mask, the consumer indices and the producer indices live on three separate cache lines,
+ * and every mailbox starts at a line boundary, so mailboxes of a mesh array share no line either.
+ * Each side keeps a cached copy of the other side index, so the other side line is touched only when the cached index runs out.
+ * Delivery on the consumer side dispatches messages into the targets queues
+ * with ActiveObject_Dispatch and publishes the consumed index once per batch.
+ *
+ * The mesh is a square matrix of mailboxes, one per (source core, destination core) pair.
+ * Each core owns a fixed set of Active Objects and runs them on its own thread (or core),
+ * the only shared state between two cores is their pair of mailboxes.
+ *
+ * Memory ordering uses MAILBOX_LOAD_ACQUIRE / MAILBOX_STORE_RELEASE,
+ * GCC/Clang atomic builtins by default, the port may redefine them.
+ *
+ * ### Example:
+ * @code
+ * #define CORES_MAX (2)
+ * #define MAILBOX_CAPACITY (16)
+ *
+ * TMailbox mailboxes[CORES_MAX * CORES_MAX];
+ * TMailboxMessage messages[CORES_MAX * CORES_MAX * MAILBOX_CAPACITY];
+ * TMailboxMesh mesh;
+ *
+ * MailboxMesh_Initialize(&mesh, mailboxes, messages, CORES_MAX, MAILBOX_CAPACITY);
+ *
+ * // core 0
+ * MailboxMesh_Send(&mesh, 0, 1, &core1ActiveObject, (TEvent){.sig = PING_SIG});
+ *
+ * // core 1 loop
+ * MailboxMesh_Poll(&mesh, 1);
+ * TEvent event = ActiveObject_ProcessQueue(&core1ActiveObject);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+
+/** @brief Cache line size, producer and consumer indices are kept on separate lines */
+#ifndef MAILBOX_CACHE_LINE_SIZE
+#define MAILBOX_CACHE_LINE_SIZE     (64)
+#endif
+
+/** @brief Acquire load of an index written by the other side */
+#ifndef MAILBOX_LOAD_ACQUIRE
+#define MAILBOX_LOAD_ACQUIRE(PTR)           __atomic_load_n((PTR), __ATOMIC_ACQUIRE)
+#endif
+
+/** @brief Release store of an own index, publishes previous writes to the other side */
+#ifndef MAILBOX_STORE_RELEASE
+#define MAILBOX_STORE_RELEASE(PTR, VALUE)   __atomic_store_n((PTR), (VALUE), __ATOMIC_RELEASE)
+#endif
+
+/** @brief Mailbox message: event for the target Active Object */
+typedef struct TMailboxMessage {
+    TActiveObject *target;  /**< Destination Active Object */
+    TEvent event;           /**< Event to dispatch */
+} TMailboxMessage;
+
+/** @brief Single producer single consumer mailbox, cache line aligned, so neighbouring mailboxes of a mesh share no line */
+typedef struct __attribute__((aligned(MAILBOX_CACHE_LINE_SIZE))) TMailbox {
+    TMailboxMessage *messages;  /**< Messages ring, read by both sides, never written after initialization */
+    uint32_t mask;              /**< Capacity - 1, capacity is a power of two */
+    uint8_t sharedPadding[MAILBOX_CACHE_LINE_SIZE - sizeof(TMailboxMessage *) - sizeof(uint32_t)];
+    uint32_t head;          /**< Consumer: free running read index */
+    uint32_t cachedTail;    /**< Consumer: last seen producer index */
+    uint8_t consumerPadding[MAILBOX_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
+    uint32_t tail;          /**< Producer: free running write index */
+    uint32_t cachedHead;    /**< Producer: last seen consumer index */
+} TMailbox;
+
+/** @brief Square matrix of mailboxes, [source core][destination core] */
+typedef struct TMailboxMesh {
+    TMailbox *mailboxes;    /**< coresCount * coresCount mailboxes */
+    uint32_t coresCount;    /**< Number of cores */
+} TMailboxMesh;
+
+/**
+ * @brief Initializes an empty mailbox
+ * @note The messages array must be allocated by the user.
+ *
+ * @param mailbox The mailbox to initialize
+ * @param messages Array of capacity messages
+ * @param capacity Capacity of the mailbox, must be a power of two
+ * @return true for success, false for invalid capacity
+ */
+bool Mailbox_Initialize(TMailbox *mailbox, TMailboxMessage *messages, uint32_t capacity);
+
+/**
+ * @brief Sends a message, producer side only
+ * @param mailbox The mailbox
+ * @param target The destination Active Object
+ * @param event The event to dispatch
+ * @return true for success, false if the mailbox is full
+ */
+bool Mailbox_Send(TMailbox *mailbox, TActiveObject *target, TEvent event);
+
+/**
+ * @brief Receives a single message, consumer side only
+ * @param mailbox The mailbox
+ * @param[out] message The received message
+ * @return true for success, false if the mailbox is empty
+ */
+bool Mailbox_Receive(TMailbox *mailbox, TMailboxMessage *message);
+
+/**
+ * @brief Dispatches up to max messages to their targets, consumer side only
+ * @details Stops at the first message whose target queue is full, leaving it in the mailbox.
+ * A message rejected by the target signal filter is discarded, it would never be taken.
+ *
+ * @param mailbox The mailbox
+ * @param max Max number of messages to consume
+ * @return Number of delivered messages, discarded ones are not counted
+ */
+uint32_t Mailbox_Deliver(TMailbox *mailbox, uint32_t max);
+
+/**
+ * @brief Initializes the mesh and all its mailboxes
+ * @note Mailboxes and messages arrays must be allocated by the user.
+ *
+ * @param mesh The mesh to initialize
+ * @param mailboxes Array of coresCount * coresCount mailboxes
+ * @param messages Array of coresCount * coresCount * capacity messages
+ * @param coresCount Number of cores
+ * @param capacity Capacity of each mailbox, must be a power of two
+ * @return true for success, false for invalid args
+ */
+bool MailboxMesh_Initialize(TMailboxMesh *mesh,
+                            TMailbox *mailboxes,
+                            TMailboxMessage *messages,
+                            uint32_t coresCount,
+                            uint32_t capacity);
+
+/**
+ * @brief Sends an event to an Active Object owned by another core
+ * @details Events to the own core are dispatched directly, bypassing the mailbox.
+ *
+ * @param mesh The mesh
+ * @param fromCore The calling core
+ * @param toCore The core owning the target
+ * @param target The destination Active Object
+ * @param event The event to dispatch
+ * @return true for success, false for invalid core or full mailbox/queue
+ */
+bool MailboxMesh_Send(TMailboxMesh *mesh, uint32_t fromCore, uint32_t toCore, TActiveObject *target, TEvent event);
+
+/**
+ * @brief Delivers all pending messages addressed to the core, called from the core loop
+ * @param mesh The mesh
+ * @param core The calling core
+ * @return Number of delivered messages
+ */
+uint32_t MailboxMesh_Poll(TMailboxMesh *mesh, uint32_t core);
+
+#endif //MAILBOX_H
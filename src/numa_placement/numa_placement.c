@@ -0,0 +1,183 @@
+#include "./numa_placement.h"
+
+/** @brief Intrusive free list link, overlays a free payload block */
+typedef struct TFreePayload {
+    struct TFreePayload *next;          /**< Next free block */
+    const TNumaPayloadPool *pool;       /**< Free block mark, cleared by the allocation */
+} TFreePayload;
+
+/** @brief Checks if the address is inside the storage */
+static inline bool _isInside(const void *address, const uint8_t *storage, size_t storageSize);
+
+/** @brief Splits the storage into free payload blocks */
+static void _initializePayloads(TNumaPayloadPool *pool, void *storage, size_t storageSize, size_t payloadSize);
+
+/** @brief Returns the node with supplied storages, NULL for invalid node */
+static inline TNumaNode *_getNode(TNumaPlacement *placement, uint32_t node);
+
+void NumaPlacement_Initialize(TNumaPlacement *placement, TNumaNode *nodes, uint32_t nodesCount, uint64_t *dispatchCounts) {
+    placement->nodes = nodes;
+    placement->nodesCount = nodesCount;
+    placement->dispatchCounts = dispatchCounts;
+    placement->crossNodeCount = 0;
+
+    for (uint32_t i = 0; i < nodesCount; i++) {
+        nodes[i].isAdded = false;
+    }
+
+    if (dispatchCounts) {
+        for (uint32_t i = 0; i < nodesCount * nodesCount; i++) {
+            dispatchCounts[i] = 0;
+        }
+    }
+}
+
+bool NumaPlacement_AddNode(TNumaPlacement *placement, uint32_t node,
+                           void *objectsStorage, size_t objectsStorageSize, size_t objectSize, uint32_t queueCapacity,
+                           void *payloadsStorage, size_t payloadsStorageSize, size_t payloadSize) {
+    if (node >= placement->nodesCount) return false;
+
+    TNumaNode *numaNode = &placement->nodes[node];
+
+    if (!ActiveObjectPool_Initialize(&numaNode->objects, (TActiveObjectPoolUnit *) objectsStorage, objectsStorageSize,
+                                     objectSize, queueCapacity)) {
+        return false;
+    }
+
+    _initializePayloads(&numaNode->payloads, payloadsStorage, payloadsStorageSize, payloadSize);
+    numaNode->isAdded = true;
+    return true;
+}
+
+TActiveObject *NumaPlacement_CreateObject(TNumaPlacement *placement, uint32_t node, const uint32_t id) {
+    TNumaNode *numaNode = _getNode(placement, node);
+
+    if (NULL == numaNode) return NULL;
+
+    NUMA_PLACEMENT_ENTER_CRITICAL(numaNode);
+
+    TActiveObject *activeObject = ActiveObjectPool_Allocate(&numaNode->objects, id);
+
+    NUMA_PLACEMENT_EXIT_CRITICAL(numaNode);
+    return activeObject;
+}
+
+bool NumaPlacement_DestroyObject(TNumaPlacement *placement, TActiveObject *activeObject) {
+    TNumaNode *numaNode = _getNode(placement, NumaPlacement_GetNode(placement, activeObject));
+
+    if (NULL == numaNode) return false;
+
+    NUMA_PLACEMENT_ENTER_CRITICAL(numaNode);
+
+    bool isReleased = ActiveObjectPool_Release(&numaNode->objects, activeObject);
+
+    NUMA_PLACEMENT_EXIT_CRITICAL(numaNode);
+    return isReleased;
+}
+
+void *NumaPlacement_AllocatePayload(TNumaPlacement *placement, uint32_t node) {
+    TNumaNode *numaNode = _getNode(placement, node);
+
+    if (NULL == numaNode) return NULL;
+
+    NUMA_PLACEMENT_ENTER_CRITICAL(numaNode);
+
+    TFreePayload *block = (TFreePayload *) numaNode->payloads.freeHead;
+
+    if (block) {
+        numaNode->payloads.freeHead = block->next;
+        numaNode->payloads.freeCount--;
+        block->pool = NULL;
+    }
+
+    NUMA_PLACEMENT_EXIT_CRITICAL(numaNode);
+    return block;
+}
+
+bool NumaPlacement_ReleasePayload(TNumaPlacement *placement, void *payload) {
+    TNumaNode *numaNode = _getNode(placement, NumaPlacement_GetNode(placement, payload));
+
+    if (NULL == numaNode) return false;
+
+    TNumaPayloadPool *pool = &numaNode->payloads;
+    size_t offset = (size_t) ((uint8_t *) payload - pool->storage);
+
+    // Validate the payload is a block start of the node pool
+    if (NULL == pool->storage || offset >= (size_t) pool->blocksCount * pool->blockSize || 0 != offset % pool->blockSize) {
+        return false;
+    }
+
+    TFreePayload *block = (TFreePayload *) payload;
+
+    NUMA_PLACEMENT_ENTER_CRITICAL(numaNode);
+
+    // A block released twice would be linked twice, the free mark is cleared by the allocation only
+    if (pool == block->pool) {
+        NUMA_PLACEMENT_EXIT_CRITICAL(numaNode);
+        return false;
+    }
+
+    block->next = (TFreePayload *) pool->freeHead;
+    block->pool = pool;
+    pool->freeHead = block;
+    pool->freeCount++;
+
+    NUMA_PLACEMENT_EXIT_CRITICAL(numaNode);
+    return true;
+}
+
+uint32_t NumaPlacement_GetNode(TNumaPlacement *placement, const void *address) {
+    for (uint32_t i = 0; i < placement->nodesCount; i++) {
+        TNumaNode *numaNode = &placement->nodes[i];
+
+        if (!numaNode->isAdded) continue;
+
+        if (_isInside(address, numaNode->objects.storage, (size_t) numaNode->objects.blocksCount * numaNode->objects.blockSize)
+            || _isInside(address, numaNode->payloads.storage, (size_t) numaNode->payloads.blocksCount * numaNode->payloads.blockSize)) {
+            return i;
+        }
+    }
+
+    return NUMA_PLACEMENT_NO_NODE;
+}
+
+bool NumaPlacement_Dispatch(TNumaPlacement *placement, uint32_t fromNode, TActiveObject *target, TEvent event) {
+    if (!ActiveObject_Dispatch(target, event)) return false;
+
+    uint32_t toNode = NumaPlacement_GetNode(placement, target);
+
+    if (fromNode < placement->nodesCount && toNode < placement->nodesCount) {
+        if (placement->dispatchCounts) NUMA_PLACEMENT_COUNT(&placement->dispatchCounts[fromNode * placement->nodesCount + toNode]);
+        if (fromNode != toNode) NUMA_PLACEMENT_COUNT(&placement->crossNodeCount);
+    }
+
+    return true;
+}
+
+static inline bool _isInside(const void *address, const uint8_t *storage, size_t storageSize) {
+    const uint8_t *pointer = (const uint8_t *) address;
+
+    return NULL != storage && pointer >= storage && pointer < storage + storageSize;
+}
+
+static void _initializePayloads(TNumaPayloadPool *pool, void *storage, size_t storageSize, size_t payloadSize) {
+    pool->storage = (uint8_t *) storage;
+    pool->blockSize = NUMA_PLACEMENT_PAYLOAD_BLOCK_SIZE(payloadSize);
+    pool->blocksCount = storage ? (uint32_t) (storageSize / pool->blockSize) : 0;
+    pool->freeCount = pool->blocksCount;
+    pool->freeHead = NULL;
+
+    // Link blocks in reverse, so the first allocation takes the lowest address
+    for (uint32_t i = pool->blocksCount; i > 0; i--) {
+        TFreePayload *block = (TFreePayload *) (pool->storage + (size_t) (i - 1) * pool->blockSize);
+        block->next = (TFreePayload *) pool->freeHead;
+        block->pool = pool;
+        pool->freeHead = block;
+    }
+}
+
+static inline TNumaNode *_getNode(TNumaPlacement *placement, uint32_t node) {
+    if (node >= placement->nodesCount || !placement->nodes[node].isAdded) return NULL;
+
+    return &placement->nodes[node];
+}
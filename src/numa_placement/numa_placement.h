@@ -0,0 +1,180 @@
+/**
+ * @file numa_placement.h
+ *
+ * @brief NUMA-aware placement of Active Objects, their queues and payload pools, cross-node dispatch counters
+ * @see active_object_pool.h for the per-node object slabs.
+ *
+ * @details Every NUMA node gets its own slab of Active Objects with co-located event rings
+ * and its own pool of fixed-size payload blocks. The storages are supplied by the port,
+ * allocated on the node (e.g. numa_alloc_onnode or mbind on Linux), so the library stays free of OS calls.
+ * An object created for a node, its ring and the payloads allocated for it stay on the node of the thread consuming them.
+ *
+ * The node of an object or a payload is resolved from its address by the node storage ranges.
+ * NumaPlacement_Dispatch counts every dispatch in a [from node][to node] matrix, so remote traffic
+ * of a misplaced topology is visible in the crossNodeCount total.
+ * On a single node machine everything is placed on node 0 and no dispatch is cross-node.
+ *
+ * Object and payload storages of a node are guarded by NUMA_PLACEMENT_ENTER_CRITICAL(node) /
+ * NUMA_PLACEMENT_EXIT_CRITICAL(node), which are empty by default and should be defined by the port
+ * (e.g. a mutex per node) when threads create objects or take payloads of the same node.
+ * The port may keep its lock in the node lock field. Threads working with different nodes don't contend.
+ *
+ * ### Example:
+ * @code
+ * TNumaNode nodes[NODES_MAX];
+ * uint64_t dispatchCounts[NODES_MAX * NODES_MAX];
+ *
+ * NumaPlacement_Initialize(&placement, nodes, nodesCount, dispatchCounts);
+ * for (uint32_t node = 0; node < nodesCount; node++) {
+ *     NumaPlacement_AddNode(&placement, node,
+ *                           numa_alloc_onnode(OBJECTS_SIZE, node), OBJECTS_SIZE, sizeof(TSensor), QUEUE_CAPACITY,
+ *                           numa_alloc_onnode(PAYLOADS_SIZE, node), PAYLOADS_SIZE, sizeof(TSample));
+ * }
+ *
+ * TActiveObject *sensor = NumaPlacement_CreateObject(&placement, consumerNode, SENSOR_AO_ID);
+ * TSample *sample = NumaPlacement_AllocatePayload(&placement, consumerNode);
+ * NumaPlacement_Dispatch(&placement, producerNode, sensor, (TEvent){.sig = SAMPLE_SIG, .payload = sample, .size = sizeof(TSample)});
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef NUMA_PLACEMENT_H
+#define NUMA_PLACEMENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+#include "../active_object_pool/active_object_pool.h"
+
+/** @brief Node index of an address outside of every node storage */
+#define NUMA_PLACEMENT_NO_NODE      (UINT32_MAX)
+
+/** @brief Counter increment, dispatching threads of all nodes share the counters */
+#ifndef NUMA_PLACEMENT_COUNT
+#define NUMA_PLACEMENT_COUNT(PTR)   __atomic_add_fetch((PTR), 1u, __ATOMIC_RELAXED)
+#endif
+
+/** @brief Critical section guards of a node storages, empty for single threaded systems */
+#ifndef NUMA_PLACEMENT_ENTER_CRITICAL
+#define NUMA_PLACEMENT_ENTER_CRITICAL(NODE)
+#endif
+
+#ifndef NUMA_PLACEMENT_EXIT_CRITICAL
+#define NUMA_PLACEMENT_EXIT_CRITICAL(NODE)
+#endif
+
+/** @brief Size in bytes of a single payload block, a free block holds the free list link and the free mark */
+#define NUMA_PLACEMENT_PAYLOAD_BLOCK_SIZE(PAYLOAD_SIZE) \
+    ACTIVE_OBJECT_POOL_ROUND_UP((PAYLOAD_SIZE) < 2u * sizeof(void *) ? 2u * sizeof(void *) : (PAYLOAD_SIZE))
+
+/** @brief Pool of fixed-size payload blocks */
+typedef struct TNumaPayloadPool {
+    uint8_t *storage;           /**< Blocks storage */
+    void *freeHead;             /**< First free block */
+    size_t blockSize;           /**< Size of a single block */
+    uint32_t blocksCount;       /**< Total blocks number */
+    uint32_t freeCount;         /**< Free blocks number */
+} TNumaPayloadPool;
+
+/** @brief Storages of a single NUMA node */
+typedef struct TNumaNode {
+    TActiveObjectPool objects;  /**< Active Objects with co-located rings */
+    TNumaPayloadPool payloads;  /**< Payload blocks */
+    bool isAdded;               /**< Storages are supplied */
+    void *lock;                 /**< Port lock of the node storages, untouched by the placement */
+} TNumaNode;
+
+/** @brief NUMA placement of Active Objects and payloads */
+typedef struct TNumaPlacement {
+    TNumaNode *nodes;           /**< Nodes array */
+    uint32_t nodesCount;        /**< Number of nodes */
+    uint64_t *dispatchCounts;   /**< Dispatches matrix [from node][to node], may be NULL */
+    uint64_t crossNodeCount;    /**< Total dispatches between different nodes */
+} TNumaPlacement;
+
+/**
+ * @brief Initializes the placement with no node storages
+ * @param placement The placement
+ * @param nodes Nodes array, allocated by the user, the node lock fields are kept as is
+ * @param nodesCount Number of nodes
+ * @param dispatchCounts Counters array of nodesCount * nodesCount, allocated by the user, NULL to count the total only
+ */
+void NumaPlacement_Initialize(TNumaPlacement *placement, TNumaNode *nodes, uint32_t nodesCount, uint64_t *dispatchCounts);
+
+/**
+ * @brief Supplies the storages of a node
+ * @note Storages should be allocated on the node and aligned as TActiveObjectPoolUnit.
+ *
+ * @param placement The placement
+ * @param node Node index
+ * @param objectsStorage Storage of the Active Objects and their rings
+ * @param objectsStorageSize Size of the objects storage in bytes
+ * @param objectSize Size of the (sub) Active Object
+ * @param queueCapacity Capacity of each object queue
+ * @param payloadsStorage Storage of the payload blocks, may be NULL
+ * @param payloadsStorageSize Size of the payloads storage in bytes, NUMA_PLACEMENT_PAYLOAD_BLOCK_SIZE per block
+ * @param payloadSize Size of a single payload
+ * @return true for success, false for invalid node or too small objects storage
+ */
+bool NumaPlacement_AddNode(TNumaPlacement *placement, uint32_t node,
+                           void *objectsStorage, size_t objectsStorageSize, size_t objectSize, uint32_t queueCapacity,
+                           void *payloadsStorage, size_t payloadsStorageSize, size_t payloadSize);
+
+/**
+ * @brief Creates an Active Object with its ring on the node
+ * @param placement The placement
+ * @param node Node of the consumer thread
+ * @param id Object ID
+ * @return Pointer to the Active Object, NULL for invalid node or exhausted node storage
+ */
+TActiveObject *NumaPlacement_CreateObject(TNumaPlacement *placement, uint32_t node, const uint32_t id);
+
+/**
+ * @brief Returns the Active Object to its node storage
+ * @param placement The placement
+ * @param activeObject Object created by NumaPlacement_CreateObject
+ * @return true for success, false if the object doesn't belong to the placement
+ */
+bool NumaPlacement_DestroyObject(TNumaPlacement *placement, TActiveObject *activeObject);
+
+/**
+ * @brief Takes a payload block on the node
+ * @param placement The placement
+ * @param node Node of the consumer thread
+ * @return Pointer to the block, NULL for invalid node or exhausted pool
+ */
+void *NumaPlacement_AllocatePayload(TNumaPlacement *placement, uint32_t node);
+
+/**
+ * @brief Returns a payload block to its node pool
+ * @note A free block is marked with its pool address after the free list link,
+ * a payload should not keep the pool address there.
+ *
+ * @param placement The placement
+ * @param payload Block taken by NumaPlacement_AllocatePayload
+ * @return true for success, false if the block doesn't belong to the placement or is already released
+ */
+bool NumaPlacement_ReleasePayload(TNumaPlacement *placement, void *payload);
+
+/**
+ * @brief Resolves the node of an object or a payload by its address
+ * @param placement The placement
+ * @param address Address inside a node storage
+ * @return Node index, NUMA_PLACEMENT_NO_NODE for an address outside of every node storage
+ */
+uint32_t NumaPlacement_GetNode(TNumaPlacement *placement, const void *address);
+
+/**
+ * @brief Dispatches an event and counts it by the source and the target nodes
+ * @param placement The placement
+ * @param fromNode Node of the dispatching thread
+ * @param target Target Active Object
+ * @param event The event
+ * @return true if the event was enqueued, false if the queue is full
+ */
+bool NumaPlacement_Dispatch(TNumaPlacement *placement, uint32_t fromNode, TActiveObject *target, TEvent event);
+
+#endif //NUMA_PLACEMENT_H
@@ -0,0 +1,65 @@
+#include "./region.h"
+
+/** @brief Looks up the handler for the region state and the event, NULL for a missing handler or out of range */
+static inline TEventHandler _getHandler(TRegion *region, TEvent event);
+
+void Region_Initialize(TRegion *region, const TState *initialState, uint32_t statesMax, uint32_t eventsMax,
+                       const TEventHandler transitionTable[statesMax][eventsMax]) {
+    region->state = initialState;
+    region->statesMax = statesMax;
+    region->eventsMax = eventsMax;
+    region->transitionTable = &transitionTable[0][0];
+    region->resume = 0;
+}
+
+void RegionsActiveObject_Initialize(TRegionsActiveObject *me, const uint32_t id, TEvent *events, uint32_t capacity,
+                                    TRegion *regions, uint32_t regionsCount) {
+    ActiveObject_Initialize(&me->super, id, events, capacity);
+    me->regions = regions;
+    me->regionsCount = regionsCount;
+    me->activeRegion = NULL;
+    me->super.state = regionsCount ? regions[0].state : NULL;
+}
+
+uint32_t RegionsActiveObject_ProcessEvent(TRegionsActiveObject *me, TEvent event) {
+    uint32_t transitionsCount = 0;
+
+    for (uint32_t i = 0; i < me->regionsCount; i++) {
+        TRegion *region = &me->regions[i];
+        const TEventHandler eventHandler = _getHandler(region, event);
+
+        if (NULL == eventHandler) continue;
+
+        // Handlers and hooks see the region state and coroutine resume point as the object ones
+        me->activeRegion = region;
+        me->super.state = region->state;
+        me->super.resume = region->resume;
+
+        const TState *nextState = eventHandler(&me->super, event);
+
+        if (nextState && FSM_IsValidState(nextState)) {
+            if (FSM_TraverseAOToNextState(&me->super, nextState)) transitionsCount++;
+            region->state = me->super.state;
+        }
+
+        region->resume = me->super.resume;
+    }
+
+    me->activeRegion = NULL;
+    return transitionsCount;
+}
+
+bool RegionsActiveObject_ProcessQueue(TRegionsActiveObject *me) {
+    if (EventQueue_IsEmpty(&me->super.queue)) return false;
+
+    RegionsActiveObject_ProcessEvent(me, EventQueue_Dequeue(&me->super.queue));
+    return true;
+}
+
+static inline TEventHandler _getHandler(TRegion *region, TEvent event) {
+    if (NULL == region->state || NULL == region->transitionTable) return NULL;
+    if (region->state->name < 0 || (uint32_t) region->state->name >= region->statesMax) return NULL;
+    if (event.sig < 0 || (uint32_t) event.sig >= region->eventsMax) return NULL;
+
+    return region->transitionTable[(uint32_t) region->state->name * region->eventsMax + (uint32_t) event.sig];
+}
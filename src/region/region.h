@@ -0,0 +1,104 @@
+/**
+ * @file region.h
+ *
+ * @brief Orthogonal regions - several concurrent sub-machines in one Active Object
+ * @see fsm.h for the transition tables and hooks of a single machine.
+ *
+ * @details Independent concerns (e.g. connectivity, power, data) reacting to the same events
+ * are modelled as regions of one Active Object instead of separate objects with
+ * duplicated events or a product-state machine. Every region holds its own current state
+ * and transition table, the object holds a single event queue.
+ * A dequeued event is looked up in every region in one pass, in the regions order.
+ *
+ * While a region processes the event, super.state, super.resume and activeRegion point to the region state,
+ * the region coroutine resume point and the region, so regular TEventHandler handlers, coroutine handlers
+ * and state hooks work unchanged.
+ *
+ * ### Example:
+ * @code
+ * TRegion regions[REGIONS_MAX];
+ * TRegionsActiveObject device;
+ *
+ * Region_Initialize(&regions[CONNECTIVITY_REGION], &connectivityStates[OFFLINE_ST], CONNECTIVITY_ST_MAX, DEVICE_SIG_MAX, connectivityTable);
+ * Region_Initialize(&regions[POWER_REGION], &powerStates[BATTERY_ST], POWER_ST_MAX, DEVICE_SIG_MAX, powerTable);
+ * RegionsActiveObject_Initialize(&device, DEVICE_AO_ID, events, QUEUE_MAX_SIZE, regions, REGIONS_MAX);
+ *
+ * ActiveObject_Dispatch(&device.super, (TEvent){.sig = LINK_DOWN_SIG});
+ * RegionsActiveObject_ProcessQueue(&device);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef REGION_H
+#define REGION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+#include "../fsm/fsm.h"
+
+/** @brief Single orthogonal region: current state and transition table */
+typedef struct TRegion {
+    const TState *state;                    /**< Current state of the region */
+    uint32_t statesMax;                     /**< The maximum number of states */
+    uint32_t eventsMax;                     /**< The maximum number of events */
+    const TEventHandler *transitionTable;   /**< Flattened [statesMax][eventsMax] transition table */
+    uint32_t resume;                        /**< Resume point of a coroutine handler of the region state. @see coroutine.h */
+} TRegion;
+
+/** @brief Active Object with orthogonal regions, extends TActiveObject */
+typedef struct TRegionsActiveObject {
+    TActiveObject super;        /**< Base Active Object, super.state mirrors the active region state */
+    TRegion *regions;           /**< Regions array */
+    uint32_t regionsCount;      /**< Number of regions */
+    TRegion *activeRegion;      /**< Region processing the event, NULL outside of processing */
+} TRegionsActiveObject;
+
+/**
+ * @brief Initializes a region
+ * @param region The region
+ * @param initialState Initial state, e.g. EMPTY_STATE entry point
+ * @param statesMax The maximum number of states
+ * @param eventsMax The maximum number of events
+ * @param transitionTable The transition table for state-event pairs
+ */
+void Region_Initialize(TRegion *region, const TState *initialState, uint32_t statesMax, uint32_t eventsMax,
+                       const TEventHandler transitionTable[statesMax][eventsMax]);
+
+/**
+ * @brief Initializes an Active Object with orthogonal regions
+ * @note The events and regions arrays must be allocated by the user.
+ *
+ * @param me The Active Object
+ * @param id Object ID
+ * @param events Pointer to the event array
+ * @param capacity Capacity of the event queue
+ * @param regions Initialized regions
+ * @param regionsCount Number of regions
+ */
+void RegionsActiveObject_Initialize(TRegionsActiveObject *me, const uint32_t id, TEvent *events, uint32_t capacity,
+                                    TRegion *regions, uint32_t regionsCount);
+
+/**
+ * @brief Processes an event in every region
+ * @details For every region looks up the handler for the region state and the event,
+ * and transitions the region to the returned state with FSM_TraverseAOToNextState.
+ * Regions without a handler or with an empty/invalid next state keep their state.
+ *
+ * @param me The Active Object
+ * @param event The event
+ * @return Number of regions that transitioned successfully
+ */
+uint32_t RegionsActiveObject_ProcessEvent(TRegionsActiveObject *me, TEvent event);
+
+/**
+ * @brief Dequeues a single event and processes it in every region
+ * @param me The Active Object
+ * @return true if an event was processed, false if the queue is empty
+ */
+bool RegionsActiveObject_ProcessQueue(TRegionsActiveObject *me);
+
+#endif //REGION_H
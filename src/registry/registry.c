@@ -0,0 +1,165 @@
+#include "./registry.h"
+
+/** @brief Free list terminator of a shard */
+#define REGISTRY_NO_SLOT    (REGISTRY_SHARD_SIZE)
+
+/** @brief Returns the shard of a slot index, NULL for a shard which is not added */
+static inline TRegistryShard *_getShard(TRegistry *registry, uint32_t index);
+
+/** @brief Resolves an id to its slot in the locked shard, NULL for a free slot or stale generation */
+static inline TRegistrySlot *_resolve(TRegistryShard *shard, TRegistryId id);
+
+/** @brief Takes a free slot of the shard for the object, REGISTRY_INVALID_ID if the shard is full */
+static inline TRegistryId _registerInShard(TRegistry *registry, uint32_t shardIndex, TActiveObject *activeObject);
+
+void Registry_Initialize(TRegistry *registry) {
+    registry->shardsCount = 0;
+    registry->freeShard = 0;
+    registry->count = 0;
+}
+
+bool Registry_AddShard(TRegistry *registry, TRegistryShard *shard) {
+    if (NULL == shard) return false;
+
+    uint32_t shardsCount = registry->shardsCount;
+
+    if (shardsCount >= REGISTRY_SHARDS_MAX) return false;
+
+    // Link the slots lowest index first
+    for (uint32_t i = 0; i < REGISTRY_SHARD_SIZE; i++) {
+        shard->slots[i].activeObject = NULL;
+        shard->slots[i].generation = HANDLE_GENERATION_FIRST;
+        shard->slots[i].nextFree = i + 1;
+    }
+
+    shard->freeHead = 0;
+    shard->count = 0;
+
+    // Lookups see the shard once it is initialized, registrations go to the new shard
+    registry->shards[shardsCount] = shard;
+    REGISTRY_STORE_RELEASE(&registry->shardsCount, shardsCount + 1);
+    REGISTRY_STORE_RELEASE(&registry->freeShard, shardsCount);
+
+    return true;
+}
+
+TRegistryId Registry_Register(TRegistry *registry, TActiveObject *activeObject) {
+    if (NULL == activeObject) return REGISTRY_INVALID_ID;
+
+    uint32_t shardsCount = REGISTRY_LOAD_ACQUIRE(&registry->shardsCount);
+    uint32_t first = REGISTRY_LOAD_ACQUIRE(&registry->freeShard);
+
+    // Start at the last shard with free slots, fall back to the others in order
+    for (uint32_t i = 0; i < shardsCount; i++) {
+        uint32_t shardIndex = (first + i) % shardsCount;
+        TRegistryId id = _registerInShard(registry, shardIndex, activeObject);
+
+        if (REGISTRY_INVALID_ID != id) {
+            if (i) REGISTRY_STORE_RELEASE(&registry->freeShard, shardIndex);
+            return id;
+        }
+    }
+
+    return REGISTRY_INVALID_ID;
+}
+
+bool Registry_Unregister(TRegistry *registry, TRegistryId id) {
+    TRegistryShard *shard = _getShard(registry, Handle_GetIndex(id));
+
+    if (NULL == shard) return false;
+
+    REGISTRY_ENTER_CRITICAL(shard);
+
+    TRegistrySlot *slot = _resolve(shard, id);
+
+    if (NULL == slot) {
+        REGISTRY_EXIT_CRITICAL(shard);
+        return false;
+    }
+
+    slot->activeObject = NULL;
+    shard->count--;
+
+    // Bump generation to make all copies of the id stale, a saturated slot is retired
+    if (Handle_NextGeneration(&slot->generation)) {
+        slot->nextFree = shard->freeHead;
+        shard->freeHead = Handle_GetIndex(id) & (REGISTRY_SHARD_SIZE - 1u);
+    }
+
+    REGISTRY_EXIT_CRITICAL(shard);
+
+    REGISTRY_ADD(&registry->count, (uint32_t) -1);
+    return true;
+}
+
+TActiveObject *Registry_Lookup(TRegistry *registry, TRegistryId id) {
+    TRegistryShard *shard = _getShard(registry, Handle_GetIndex(id));
+
+    if (NULL == shard) return NULL;
+
+    REGISTRY_ENTER_CRITICAL(shard);
+
+    TRegistrySlot *slot = _resolve(shard, id);
+    TActiveObject *activeObject = slot ? slot->activeObject : NULL;
+
+    REGISTRY_EXIT_CRITICAL(shard);
+    return activeObject;
+}
+
+bool Registry_DispatchById(TRegistry *registry, TRegistryId id, TEvent event) {
+    TRegistryShard *shard = _getShard(registry, Handle_GetIndex(id));
+    bool isDispatched = false;
+
+    if (NULL == shard) return false;
+
+    // Keep the object registered until the event is enqueued
+    REGISTRY_ENTER_CRITICAL(shard);
+
+    TRegistrySlot *slot = _resolve(shard, id);
+    if (slot) isDispatched = ActiveObject_Dispatch(slot->activeObject, event);
+
+    REGISTRY_EXIT_CRITICAL(shard);
+    return isDispatched;
+}
+
+static inline TRegistryShard *_getShard(TRegistry *registry, uint32_t index) {
+    uint32_t shardIndex = index >> REGISTRY_SHARD_SIZE_LOG2;
+
+    if (shardIndex >= REGISTRY_LOAD_ACQUIRE(&registry->shardsCount)) return NULL;
+
+    return registry->shards[shardIndex];
+}
+
+static inline TRegistrySlot *_resolve(TRegistryShard *shard, TRegistryId id) {
+    TRegistrySlot *slot = &shard->slots[Handle_GetIndex(id) & (REGISTRY_SHARD_SIZE - 1u)];
+
+    if (NULL == slot->activeObject || slot->generation != Handle_GetGeneration(id)) return NULL;
+
+    return slot;
+}
+
+static inline TRegistryId _registerInShard(TRegistry *registry, uint32_t shardIndex, TActiveObject *activeObject) {
+    TRegistryShard *shard = registry->shards[shardIndex];
+
+    REGISTRY_ENTER_CRITICAL(shard);
+
+    uint32_t index = shard->freeHead;
+
+    if (REGISTRY_NO_SLOT == index) {
+        REGISTRY_EXIT_CRITICAL(shard);
+        return REGISTRY_INVALID_ID;
+    }
+
+    TRegistrySlot *slot = &shard->slots[index];
+
+    shard->freeHead = slot->nextFree;
+    shard->count++;
+    slot->activeObject = activeObject;
+
+    TRegistryId id = Handle_Make((shardIndex << REGISTRY_SHARD_SIZE_LOG2) | index, slot->generation);
+
+    REGISTRY_EXIT_CRITICAL(shard);
+
+    REGISTRY_ADD(&registry->count, 1u);
+    return id;
+}
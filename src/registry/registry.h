@@ -0,0 +1,166 @@
+/**
+ * @file registry.h
+ *
+ * @brief Active Object Registry - O(1) id to Active Object routing
+ * @see active_object.h for the registered object.
+ *
+ * @details The registry maps generation-tagged ids to active objects.
+ * Slots live in fixed-size shards supplied by the user (static memory allocation only),
+ * so the registry capacity can be extended at runtime without moving already registered objects.
+ * The id encodes the slot index and the slot generation (see handle.h): lookup is a shard index,
+ * a slot index and a generation compare. Ids of unregistered objects become stale
+ * and are rejected, even after the slot is reused: a slot is retired when its 32-bit generation saturates.
+ *
+ * Every shard keeps its own LIFO list of free slots, so register/unregister churn is O(1)
+ * and keeps reusing recently touched (cache-hot) slots. Registration starts at the last shard with free slots.
+ *
+ * Concurrent access is guarded per shard by REGISTRY_ENTER_CRITICAL(shard) / REGISTRY_EXIT_CRITICAL(shard),
+ * which are empty by default and should be defined by the port (e.g. a mutex per shard, IRQ masking)
+ * when the registry is shared between threads or interrupts. Threads working with different shards don't contend.
+ * The port may keep its lock in the shard lock field. Shards are added by one thread at a time,
+ * concurrently with lookups and registrations.
+ *
+ * ### Example:
+ * @code
+ * TRegistry registry;
+ * TRegistryShard shard;
+ *
+ * Registry_Initialize(&registry);
+ * Registry_AddShard(&registry, &shard);
+ *
+ * TRegistryId id = Registry_Register(&registry, &activeObject);
+ * Registry_DispatchById(&registry, id, (TEvent){.sig = EVENT_SIG_1});
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+#include "../handle/handle.h"
+
+/** @brief Log2 of the slots number in a single shard */
+#ifndef REGISTRY_SHARD_SIZE_LOG2
+#define REGISTRY_SHARD_SIZE_LOG2    (8)
+#endif
+
+/** @brief Max shards number in a single registry */
+#ifndef REGISTRY_SHARDS_MAX
+#define REGISTRY_SHARDS_MAX         (256)
+#endif
+
+/** @brief Slots number in a single shard */
+#define REGISTRY_SHARD_SIZE         (1u << REGISTRY_SHARD_SIZE_LOG2)
+
+/** @brief Bits of the id holding the slot index, the rest holds the slot generation */
+#define REGISTRY_INDEX_BITS         (HANDLE_INDEX_BITS)
+#define REGISTRY_INDEX_MASK         (HANDLE_INDEX_MASK)
+
+/** @brief Id which is never given to a registered object */
+#define REGISTRY_INVALID_ID         (HANDLE_INVALID)
+
+/** @brief Critical section guards of a shard, empty for single threaded systems */
+#ifndef REGISTRY_ENTER_CRITICAL
+#define REGISTRY_ENTER_CRITICAL(SHARD)
+#endif
+
+#ifndef REGISTRY_EXIT_CRITICAL
+#define REGISTRY_EXIT_CRITICAL(SHARD)
+#endif
+
+/** @brief Atomic access to the registry fields shared by all shards, GCC/Clang atomic builtins by default */
+#ifndef REGISTRY_LOAD_ACQUIRE
+#define REGISTRY_LOAD_ACQUIRE(PTR)          __atomic_load_n((PTR), __ATOMIC_ACQUIRE)
+#endif
+
+#ifndef REGISTRY_STORE_RELEASE
+#define REGISTRY_STORE_RELEASE(PTR, VALUE)  __atomic_store_n((PTR), (VALUE), __ATOMIC_RELEASE)
+#endif
+
+#ifndef REGISTRY_ADD
+#define REGISTRY_ADD(PTR, VALUE)            __atomic_add_fetch((PTR), (VALUE), __ATOMIC_RELAXED)
+#endif
+
+/** @brief Generation-tagged Active Object id: [generation:32][slot index:32] */
+typedef THandle TRegistryId;
+
+/** @brief Registry slot */
+typedef struct TRegistrySlot {
+    TActiveObject *activeObject;    /**< Registered object, NULL for a free or retired slot */
+    uint32_t nextFree;              /**< Next free slot in the shard, valid for a free slot only */
+    uint32_t generation;            /**< Incremented on every unregister, the slot is retired when it saturates */
+} TRegistrySlot;
+
+/** @brief Shard of REGISTRY_SHARD_SIZE slots with its own free list, should be allocated by user */
+typedef struct TRegistryShard {
+    TRegistrySlot slots[REGISTRY_SHARD_SIZE];   /**< Slots */
+    uint32_t freeHead;                          /**< First free slot in the shard, REGISTRY_SHARD_SIZE for none */
+    uint32_t count;                             /**< Number of registered objects in the shard */
+    void *lock;                                 /**< Port lock of the shard, untouched by the registry */
+} TRegistryShard;
+
+/** @brief Sharded registry of Active Objects */
+typedef struct TRegistry {
+    TRegistryShard *shards[REGISTRY_SHARDS_MAX];    /**< Shards */
+    uint32_t shardsCount;                           /**< Number of added shards */
+    uint32_t freeShard;                             /**< Shard to start the next registration at */
+    uint32_t count;                                 /**< Number of registered objects */
+} TRegistry;
+
+/**
+ * @brief Initializes an empty registry with no shards
+ * @param registry The registry to initialize
+ */
+void Registry_Initialize(TRegistry *registry);
+
+/**
+ * @brief Extends the registry with a shard of REGISTRY_SHARD_SIZE slots
+ * @note The shard must be allocated by the user and outlive the registry, its lock field is kept as is.
+ *
+ * @param registry The registry
+ * @param shard The shard
+ * @return true for success, false if the registry has no room for one more shard
+ */
+bool Registry_AddShard(TRegistry *registry, TRegistryShard *shard);
+
+/**
+ * @brief Registers an Active Object
+ * @param registry The registry
+ * @param activeObject The Active Object to register
+ * @return id of the registered object
+ * @returns REGISTRY_INVALID_ID if there is no free slot in any shard
+ */
+TRegistryId Registry_Register(TRegistry *registry, TActiveObject *activeObject);
+
+/**
+ * @brief Unregisters an Active Object, so its id becomes stale
+ * @param registry The registry
+ * @param id Id of the registered object
+ * @return true for success, false for stale or invalid id
+ */
+bool Registry_Unregister(TRegistry *registry, TRegistryId id);
+
+/**
+ * @brief Looks up an Active Object by id in O(1)
+ * @param registry The registry
+ * @param id Id of the registered object
+ * @return Pointer to the Active Object, NULL for stale or invalid id
+ */
+TActiveObject *Registry_Lookup(TRegistry *registry, TRegistryId id);
+
+/**
+ * @brief Dispatches an event to the Active Object with the given id
+ * @param registry The registry
+ * @param id Id of the registered object
+ * @param event The event to be dispatched
+ * @return true if the event was enqueued, false for stale id or full queue
+ */
+bool Registry_DispatchById(TRegistry *registry, TRegistryId id, TEvent event);
+
+#endif //REGISTRY_H
@@ -0,0 +1,175 @@
+#include "./request.h"
+
+/** @brief List terminator */
+#define REQUEST_NO_SLOT     (REQUEST_INDEX_MASK)
+
+/** @brief Wrap-safe "a is earlier than b" */
+static inline bool _isBefore(uint32_t a, uint32_t b);
+
+/** @brief Resolves a token to its pending slot, NULL for out of range index or stale generation */
+static inline TRequestSlot *_resolve(TRequestTable *table, TRequestToken token);
+
+/** @brief Unlinks a pending slot, makes its token stale and returns it to the free list unless it is retired */
+static void _complete(TRequestTable *table, uint32_t index);
+
+void Request_Initialize(TRequestTable *table, TRequestSlot *slots, uint32_t capacity, uint32_t timeout, int timeoutSig) {
+    if (capacity > REQUEST_SLOTS_MAX) capacity = REQUEST_SLOTS_MAX;
+
+    table->slots = slots;
+    table->capacity = capacity;
+    table->timeout = timeout;
+    table->timeoutSig = timeoutSig;
+    table->freeHead = capacity ? 0 : REQUEST_NO_SLOT;
+    table->pendingHead = REQUEST_NO_SLOT;
+    table->pendingTail = REQUEST_NO_SLOT;
+    table->pendingCount = 0;
+    table->timeoutCount = 0;
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        slots[i].requester = NULL;
+        slots[i].generation = HANDLE_GENERATION_FIRST;
+        slots[i].next = (i + 1 < capacity) ? i + 1 : REQUEST_NO_SLOT;
+    }
+}
+
+TRequestToken Request_Send(TRequestTable *table, TActiveObject *requester, TActiveObject *target, TEvent request,
+                           uint32_t now) {
+    if (NULL == requester || NULL == target || NULL == request.payload) return REQUEST_INVALID_TOKEN;
+
+    REQUEST_ENTER_CRITICAL();
+
+    uint32_t index = table->freeHead;
+
+    if (REQUEST_NO_SLOT == index) {
+        REQUEST_EXIT_CRITICAL();
+        return REQUEST_INVALID_TOKEN;
+    }
+
+    TRequestSlot *slot = &table->slots[index];
+    TRequestToken token = Handle_Make(index, slot->generation);
+
+    // The target may handle the request right away, so the token is written before the dispatch
+    ((TRequestHeader *) request.payload)->token = token;
+
+    if (!ActiveObject_Dispatch(target, request)) {
+        REQUEST_EXIT_CRITICAL();
+        return REQUEST_INVALID_TOKEN;
+    }
+
+    table->freeHead = slot->next;
+
+    slot->requester = requester;
+    slot->request = request;
+    slot->deadline = now + table->timeout;
+    slot->prev = table->pendingTail;
+    slot->next = REQUEST_NO_SLOT;
+
+    if (REQUEST_NO_SLOT == table->pendingTail) {
+        table->pendingHead = index;
+    } else {
+        table->slots[table->pendingTail].next = index;
+    }
+
+    table->pendingTail = index;
+    table->pendingCount++;
+
+    REQUEST_EXIT_CRITICAL();
+    return token;
+}
+
+bool Request_Reply(TRequestTable *table, TRequestToken token, TEvent reply) {
+    REQUEST_ENTER_CRITICAL();
+
+    TRequestSlot *slot = _resolve(table, token);
+
+    if (NULL == slot) {
+        REQUEST_EXIT_CRITICAL();
+        return false;
+    }
+
+    if (reply.payload) ((TRequestHeader *) reply.payload)->token = token;
+
+    TDispatchResult result = ActiveObject_Submit(slot->requester, reply);
+
+    // A reply rejected by the requester filter completes the request, it would never be taken
+    if (ACTIVE_OBJECT_DISPATCH_FULL != result) _complete(table, Handle_GetIndex(token));
+
+    REQUEST_EXIT_CRITICAL();
+    return ACTIVE_OBJECT_DISPATCH_ENQUEUED == result || ACTIVE_OBJECT_DISPATCH_DEFERRED == result;
+}
+
+bool Request_IsPending(TRequestTable *table, TRequestToken token) {
+    REQUEST_ENTER_CRITICAL();
+
+    bool isPending = NULL != _resolve(table, token);
+
+    REQUEST_EXIT_CRITICAL();
+    return isPending;
+}
+
+uint32_t Request_Tick(TRequestTable *table, uint32_t now) {
+    uint32_t expiredCount = 0;
+
+    REQUEST_ENTER_CRITICAL();
+
+    // Deadlines grow in the send order, the first not expired request ends the scan
+    while (REQUEST_NO_SLOT != table->pendingHead) {
+        uint32_t index = table->pendingHead;
+        TRequestSlot *slot = &table->slots[index];
+
+        if (_isBefore(now, slot->deadline)) break;
+
+        TEvent timeout = {.sig = table->timeoutSig, .payload = slot->request.payload, .size = slot->request.size};
+
+        // A timeout rejected by the requester filter expires the request too, only a full queue keeps it pending
+        if (ACTIVE_OBJECT_DISPATCH_FULL == ActiveObject_Submit(slot->requester, timeout)) break;
+
+        _complete(table, index);
+        table->timeoutCount++;
+        expiredCount++;
+    }
+
+    REQUEST_EXIT_CRITICAL();
+    return expiredCount;
+}
+
+static inline bool _isBefore(uint32_t a, uint32_t b) {
+    return (int32_t) (a - b) < 0;
+}
+
+static inline TRequestSlot *_resolve(TRequestTable *table, TRequestToken token) {
+    uint32_t index = Handle_GetIndex(token);
+
+    if (index >= table->capacity) return NULL;
+
+    TRequestSlot *slot = &table->slots[index];
+
+    if (NULL == slot->requester || slot->generation != Handle_GetGeneration(token)) return NULL;
+
+    return slot;
+}
+
+static void _complete(TRequestTable *table, uint32_t index) {
+    TRequestSlot *slot = &table->slots[index];
+
+    if (REQUEST_NO_SLOT == slot->prev) {
+        table->pendingHead = slot->next;
+    } else {
+        table->slots[slot->prev].next = slot->next;
+    }
+
+    if (REQUEST_NO_SLOT == slot->next) {
+        table->pendingTail = slot->prev;
+    } else {
+        table->slots[slot->next].prev = slot->prev;
+    }
+
+    slot->requester = NULL;
+    table->pendingCount--;
+
+    // Bump generation to make all copies of the token stale, a saturated slot is retired
+    if (Handle_NextGeneration(&slot->generation)) {
+        slot->next = table->freeHead;
+        table->freeHead = index;
+    }
+}
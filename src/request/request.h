@@ -0,0 +1,166 @@
+/**
+ * @file request.h
+ *
+ * @brief Asynchronous request/reply between Active Objects with correlation tokens and timeouts
+ * @see active_object.h for the requester and target objects.
+ *
+ * @details Request_Send dispatches a request event to the target and returns a correlation token.
+ * The target handler replies through the token with Request_Reply, the reply is dispatched into the requester queue,
+ * so the target doesn't need to know the requester and no routing object is needed.
+ *
+ * Pending requests live in a slab table allocated by the user (static memory allocation only).
+ * The token encodes the slot index and the slot generation (see handle.h): reply lookup is an index and a generation compare.
+ * Tokens of replied or timed out requests become stale and are rejected, even after the slot is reused:
+ * a slot is retired when its 32-bit generation saturates.
+ *
+ * Every table has a single timeout, so pending requests expire in the send order:
+ * they are kept in a send-ordered list, Request_Tick pops the expired head only and a reply unlinks its slot in O(1).
+ * An expired request is answered with the table timeout signal on behalf of the target.
+ *
+ * Request and reply payloads must start with TRequestHeader, the token is written there:
+ * the target reads the token of the request, the requester matches replies against the token it got from Request_Send.
+ * The timeout event carries the request payload, the request payload should outlive the request.
+ *
+ * Time is in user ticks (uint32_t), compared wrap-safe: the timeout should be less than 2^31 ticks.
+ * Concurrent access is guarded by REQUEST_ENTER_CRITICAL() / REQUEST_EXIT_CRITICAL(),
+ * which are empty by default and should be defined by the port when the table is shared between threads.
+ *
+ * ### Example:
+ * @code
+ * typedef struct { TRequestHeader header; uint32_t address; } TReadRequest;
+ * typedef struct { TRequestHeader header; uint32_t value; } TReadReply;
+ *
+ * TRequestSlot slots[REQUESTS_MAX];
+ * Request_Initialize(&requests, slots, REQUESTS_MAX, READ_TIMEOUT_TICKS, READ_TIMEOUT_SIG);
+ *
+ * // requester
+ * readRequest.address = 0x10;
+ * pendingToken = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequest}, now());
+ *
+ * // target handler
+ * TRequestToken token = ((TRequestHeader *)event.payload)->token;
+ * Request_Reply(&requests, token, (TEvent){.sig = READ_DONE_SIG, .payload = &readReply});
+ *
+ * // requester handler of READ_DONE_SIG and READ_TIMEOUT_SIG
+ * if (((TRequestHeader *)event.payload)->token != pendingToken) return activeObject->state; // stale
+ *
+ * // periodically
+ * Request_Tick(&requests, now());
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef REQUEST_H
+#define REQUEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+#include "../handle/handle.h"
+
+/** @brief Bits of the token holding the slot index, the rest holds the slot generation */
+#define REQUEST_INDEX_BITS          (HANDLE_INDEX_BITS)
+#define REQUEST_INDEX_MASK          (HANDLE_INDEX_MASK)
+
+/** @brief Max slots number in a single table */
+#define REQUEST_SLOTS_MAX           (REQUEST_INDEX_MASK)
+
+/** @brief Token which is never given to a pending request */
+#define REQUEST_INVALID_TOKEN       (HANDLE_INVALID)
+
+/** @brief Critical section guards, empty for single threaded systems */
+#ifndef REQUEST_ENTER_CRITICAL
+#define REQUEST_ENTER_CRITICAL()
+#endif
+
+#ifndef REQUEST_EXIT_CRITICAL
+#define REQUEST_EXIT_CRITICAL()
+#endif
+
+/** @brief Generation-tagged correlation token: [generation:32][slot index:32] */
+typedef THandle TRequestToken;
+
+/** @brief Header of request and reply payloads */
+typedef struct TRequestHeader {
+    TRequestToken token;    /**< Correlation token, written by Request_Send and Request_Reply */
+} TRequestHeader;
+
+/** @brief Pending request slot, should be allocated by user */
+typedef struct TRequestSlot {
+    TActiveObject *requester;   /**< Object waiting for the reply, NULL for a free slot */
+    TEvent request;             /**< Request event, its payload goes with the timeout event */
+    uint32_t deadline;          /**< Expiration time, ticks */
+    uint32_t prev;              /**< Previous pending slot in the send order */
+    uint32_t next;              /**< Next pending slot in the send order, or next free slot */
+    uint32_t generation;        /**< Incremented on every completion, the slot is retired when it saturates */
+} TRequestSlot;
+
+/** @brief Request table */
+typedef struct TRequestTable {
+    TRequestSlot *slots;        /**< Slots array */
+    uint32_t capacity;          /**< Capacity of the slots array */
+    uint32_t timeout;           /**< Timeout of every request, ticks */
+    int timeoutSig;             /**< Signal of the timeout event */
+    uint32_t freeHead;          /**< First free slot index */
+    uint32_t pendingHead;       /**< Oldest pending slot index */
+    uint32_t pendingTail;       /**< Newest pending slot index */
+    uint32_t pendingCount;      /**< Number of pending requests */
+    uint32_t timeoutCount;      /**< Total timed out requests */
+} TRequestTable;
+
+/**
+ * @brief Initializes an empty table
+ * @param table The table
+ * @param slots Slots array, allocated by the user
+ * @param capacity Capacity of the slots array, up to REQUEST_SLOTS_MAX
+ * @param timeout Timeout of every request, ticks
+ * @param timeoutSig Signal of the event dispatched to the requester when a request expires
+ */
+void Request_Initialize(TRequestTable *table, TRequestSlot *slots, uint32_t capacity, uint32_t timeout, int timeoutSig);
+
+/**
+ * @brief Sends a request: writes a new token into the request header and dispatches the request to the target
+ * @param table The table
+ * @param requester Object to receive the reply or the timeout event
+ * @param target Object to handle the request
+ * @param request The request event, its payload starts with TRequestHeader
+ * @param now Current time, ticks
+ * @return Correlation token
+ * @returns REQUEST_INVALID_TOKEN for invalid args, no free slot or full target queue
+ */
+TRequestToken Request_Send(TRequestTable *table, TActiveObject *requester, TActiveObject *target, TEvent request,
+                           uint32_t now);
+
+/**
+ * @brief Replies to a pending request: writes the token into the reply header and dispatches the reply to the requester
+ * @details The request is completed and its token becomes stale. A request stays pending if the requester queue is full.
+ * A reply rejected by the requester signal filter is dropped and completes the request.
+ * @param table The table
+ * @param token Token of the request
+ * @param reply The reply event, its payload starts with TRequestHeader or is NULL
+ * @return true if the reply was enqueued or deferred, false for stale token, full requester queue or rejected reply
+ */
+bool Request_Reply(TRequestTable *table, TRequestToken token, TEvent reply);
+
+/**
+ * @brief Checks if a request waits for the reply
+ * @param table The table
+ * @param token Token of the request
+ * @return true for a pending request, false for replied, timed out or invalid token
+ */
+bool Request_IsPending(TRequestTable *table, TRequestToken token);
+
+/**
+ * @brief Expires requests sent timeout ticks ago or earlier, dispatching the timeout event to their requesters
+ * @details The timeout event carries the request payload. A request stays pending if the requester queue is full,
+ * a timeout event rejected by the requester signal filter is dropped and the request expires.
+ * @param table The table
+ * @param now Current time, ticks
+ * @return Number of expired requests
+ */
+uint32_t Request_Tick(TRequestTable *table, uint32_t now);
+
+#endif //REQUEST_H
@@ -0,0 +1,161 @@
+#include "./scheduler.h"
+
+/** @brief Wrap-safe "a is earlier than b" */
+static inline bool _isBefore(uint32_t a, uint32_t b);
+
+/** @brief Deadline of the task head event */
+static inline uint32_t _getHeadDeadline(TScheduler *scheduler, uint32_t task);
+
+/** @brief Places the task at the heap position */
+static inline void _setHeapSlot(TScheduler *scheduler, uint32_t position, uint32_t task);
+
+/** @brief Moves the task at the position up to restore the heap order */
+static void _siftUp(TScheduler *scheduler, uint32_t position);
+
+/** @brief Moves the task at the position down to restore the heap order */
+static void _siftDown(TScheduler *scheduler, uint32_t position);
+
+void Scheduler_Initialize(TScheduler *scheduler, TSchedulerTask *tasks, uint32_t *heap, uint32_t tasksMax) {
+    scheduler->tasks = tasks;
+    scheduler->heap = heap;
+    scheduler->tasksMax = tasksMax;
+    scheduler->tasksCount = 0;
+    scheduler->heapSize = 0;
+    scheduler->missCount = 0;
+}
+
+uint32_t Scheduler_AddTask(TScheduler *scheduler, TActiveObject *activeObject, uint32_t budget,
+                           uint32_t *deadlines, uint32_t deadlinesCapacity) {
+    if (NULL == activeObject || NULL == deadlines || 0 == deadlinesCapacity) return SCHEDULER_INVALID_TASK;
+    if (scheduler->tasksCount >= scheduler->tasksMax) return SCHEDULER_INVALID_TASK;
+
+    uint32_t task = scheduler->tasksCount++;
+
+    scheduler->tasks[task] = (TSchedulerTask) {
+        .activeObject = activeObject,
+        .budget = budget,
+        .deadlines = deadlines,
+        .deadlinesCapacity = deadlinesCapacity,
+        .deadlinesHead = 0,
+        .deadlinesCount = 0,
+        .heapIndex = SCHEDULER_NOT_IN_HEAP,
+        .missCount = 0,
+    };
+
+    return task;
+}
+
+bool Scheduler_Dispatch(TScheduler *scheduler, uint32_t task, TEvent event, uint32_t now) {
+    if (task >= scheduler->tasksCount) return false;
+
+    return Scheduler_DispatchWithDeadline(scheduler, task, event, now + scheduler->tasks[task].budget);
+}
+
+bool Scheduler_DispatchWithDeadline(TScheduler *scheduler, uint32_t task, TEvent event, uint32_t deadline) {
+    if (task >= scheduler->tasksCount) return false;
+
+    TSchedulerTask *schedulerTask = &scheduler->tasks[task];
+
+    if (schedulerTask->deadlinesCount >= schedulerTask->deadlinesCapacity) return false;
+
+    TDispatchResult result = ActiveObject_Submit(schedulerTask->activeObject, event);
+
+    // Deadlines run parallel to the event queue, events kept out of the queue get none
+    if (ACTIVE_OBJECT_DISPATCH_ENQUEUED != result) return ACTIVE_OBJECT_DISPATCH_DEFERRED == result;
+
+    uint32_t tail = (schedulerTask->deadlinesHead + schedulerTask->deadlinesCount) % schedulerTask->deadlinesCapacity;
+    schedulerTask->deadlines[tail] = deadline;
+    schedulerTask->deadlinesCount++;
+
+    // A queued event behind the head doesn't change the task key, FIFO order is kept
+    if (SCHEDULER_NOT_IN_HEAP == schedulerTask->heapIndex) {
+        _setHeapSlot(scheduler, scheduler->heapSize++, task);
+        _siftUp(scheduler, schedulerTask->heapIndex);
+    }
+
+    return true;
+}
+
+TActiveObject *Scheduler_Next(TScheduler *scheduler, uint32_t now, TEvent *event) {
+    if (0 == scheduler->heapSize) return NULL;
+
+    uint32_t task = scheduler->heap[0];
+    TSchedulerTask *schedulerTask = &scheduler->tasks[task];
+    uint32_t deadline = schedulerTask->deadlines[schedulerTask->deadlinesHead];
+
+    if (_isBefore(deadline, now)) {
+        schedulerTask->missCount++;
+        scheduler->missCount++;
+    }
+
+    *event = ActiveObject_ProcessQueue(schedulerTask->activeObject);
+    schedulerTask->deadlinesHead = (schedulerTask->deadlinesHead + 1) % schedulerTask->deadlinesCapacity;
+    schedulerTask->deadlinesCount--;
+
+    if (schedulerTask->deadlinesCount) {
+        // The task stays at the root or sinks, an earlier next head keeps it at the root
+        _siftDown(scheduler, 0);
+    } else {
+        schedulerTask->heapIndex = SCHEDULER_NOT_IN_HEAP;
+        if (--scheduler->heapSize) {
+            _setHeapSlot(scheduler, 0, scheduler->heap[scheduler->heapSize]);
+            _siftDown(scheduler, 0);
+        }
+    }
+
+    return schedulerTask->activeObject;
+}
+
+static inline bool _isBefore(uint32_t a, uint32_t b) {
+    return (int32_t) (a - b) < 0;
+}
+
+static inline uint32_t _getHeadDeadline(TScheduler *scheduler, uint32_t task) {
+    TSchedulerTask *schedulerTask = &scheduler->tasks[task];
+    return schedulerTask->deadlines[schedulerTask->deadlinesHead];
+}
+
+static inline void _setHeapSlot(TScheduler *scheduler, uint32_t position, uint32_t task) {
+    scheduler->heap[position] = task;
+    scheduler->tasks[task].heapIndex = position;
+}
+
+static void _siftUp(TScheduler *scheduler, uint32_t position) {
+    uint32_t task = scheduler->heap[position];
+    uint32_t deadline = _getHeadDeadline(scheduler, task);
+
+    while (position > 0) {
+        uint32_t parent = (position - 1) / 2;
+
+        if (!_isBefore(deadline, _getHeadDeadline(scheduler, scheduler->heap[parent]))) break;
+
+        _setHeapSlot(scheduler, position, scheduler->heap[parent]);
+        position = parent;
+    }
+
+    _setHeapSlot(scheduler, position, task);
+}
+
+static void _siftDown(TScheduler *scheduler, uint32_t position) {
+    uint32_t task = scheduler->heap[position];
+    uint32_t deadline = _getHeadDeadline(scheduler, task);
+
+    for (;;) {
+        uint32_t child = 2 * position + 1;
+
+        if (child >= scheduler->heapSize) break;
+
+        if (child + 1 < scheduler->heapSize
+            && _isBefore(_getHeadDeadline(scheduler, scheduler->heap[child + 1]),
+                         _getHeadDeadline(scheduler, scheduler->heap[child]))) {
+            child++;
+        }
+
+        if (!_isBefore(_getHeadDeadline(scheduler, scheduler->heap[child]), deadline)) break;
+
+        _setHeapSlot(scheduler, position, scheduler->heap[child]);
+        position = child;
+    }
+
+    _setHeapSlot(scheduler, position, task);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file scheduler.h
+ *
+ * @brief Earliest-deadline-first (EDF) scheduler of Active Objects
+ * @see active_object.h for the scheduled objects.
+ *
+ * @details Every queued event carries a deadline: either absolute (Scheduler_DispatchWithDeadline)
+ * or the dispatch time plus the object relative budget (Scheduler_Dispatch).
+ * Deadlines are kept in a user-allocated FIFO per object, parallel to its event queue.
+ * Objects with pending events are kept in an indexed min-heap keyed by the deadline of the head event,
+ * so Scheduler_Next always picks the object whose head event is due first in O(log n),
+ * and a latency-sensitive object is never starved by bulk-processing ones.
+ *
+ * Time is in user ticks (uint32_t), compared wrap-safe: deadlines should be less than 2^31 ticks ahead.
+ * An event started after its deadline is counted as a miss, per object and in total.
+ *
+ * @note Events of the scheduled objects should be dispatched through the scheduler only.
+ * @note Only enqueued events get a deadline: an event rejected or deferred by the object signal filter gets none.
+ * Scheduled objects should not recall deferred events, a recalled event would have no deadline in the FIFO.
+ *
+ * ### Example:
+ * @code
+ * TSchedulerTask tasks[TASKS_MAX];
+ * uint32_t heap[TASKS_MAX];
+ * uint32_t controlDeadlines[QUEUE_MAX_SIZE];
+ *
+ * Scheduler_Initialize(&scheduler, tasks, heap, TASKS_MAX);
+ * uint32_t control = Scheduler_AddTask(&scheduler, &controlLoop, CONTROL_BUDGET_TICKS, controlDeadlines, QUEUE_MAX_SIZE);
+ *
+ * Scheduler_Dispatch(&scheduler, control, (TEvent){.sig = SAMPLE_SIG}, now());
+ *
+ * TEvent event;
+ * TActiveObject *activeObject;
+ * while ((activeObject = Scheduler_Next(&scheduler, now(), &event))) {
+ *     const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(activeObject, event, ...);
+ *     FSM_TraverseAOToNextState(activeObject, nextState);
+ * }
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+
+/** @brief Task id which is never returned by Scheduler_AddTask */
+#define SCHEDULER_INVALID_TASK      (UINT32_MAX)
+
+/** @brief Heap position of a task without pending events */
+#define SCHEDULER_NOT_IN_HEAP       (UINT32_MAX)
+
+/** @brief Scheduled Active Object */
+typedef struct TSchedulerTask {
+    TActiveObject *activeObject;    /**< Scheduled object */
+    uint32_t budget;                /**< Relative deadline of an event, ticks */
+    uint32_t *deadlines;            /**< FIFO of queued events deadlines */
+    uint32_t deadlinesCapacity;     /**< Capacity of the deadlines FIFO */
+    uint32_t deadlinesHead;         /**< Index of the head event deadline */
+    uint32_t deadlinesCount;        /**< Number of queued events deadlines */
+    uint32_t heapIndex;             /**< Position in the heap, SCHEDULER_NOT_IN_HEAP if idle */
+    uint32_t missCount;             /**< Events started after their deadline */
+} TSchedulerTask;
+
+/** @brief EDF scheduler */
+typedef struct TScheduler {
+    TSchedulerTask *tasks;  /**< Tasks array */
+    uint32_t *heap;         /**< Min-heap of task ids by the head event deadline */
+    uint32_t tasksMax;      /**< Capacity of the tasks and heap arrays */
+    uint32_t tasksCount;    /**< Number of added tasks */
+    uint32_t heapSize;      /**< Number of tasks with pending events */
+    uint32_t missCount;     /**< Total deadline misses */
+} TScheduler;
+
+/**
+ * @brief Initializes an empty scheduler
+ * @param scheduler The scheduler
+ * @param tasks Tasks array, allocated by the user
+ * @param heap Heap array of the same capacity, allocated by the user
+ * @param tasksMax Capacity of the tasks and heap arrays
+ */
+void Scheduler_Initialize(TScheduler *scheduler, TSchedulerTask *tasks, uint32_t *heap, uint32_t tasksMax);
+
+/**
+ * @brief Adds an Active Object to the scheduler
+ * @param scheduler The scheduler
+ * @param activeObject Initialized Active Object with an empty queue
+ * @param budget Relative deadline of the object events, ticks
+ * @param deadlines Deadlines FIFO array, allocated by the user, usually of the object queue capacity
+ * @param deadlinesCapacity Capacity of the deadlines FIFO
+ * @return Task id
+ * @returns SCHEDULER_INVALID_TASK if there is no room
+ */
+uint32_t Scheduler_AddTask(TScheduler *scheduler, TActiveObject *activeObject, uint32_t budget,
+                           uint32_t *deadlines, uint32_t deadlinesCapacity);
+
+/**
+ * @brief Dispatches an event due in the task budget
+ * @param scheduler The scheduler
+ * @param task Task id
+ * @param event The event
+ * @param now Current time, ticks
+ * @return true if the event was enqueued or deferred, false for invalid task, full queue or deadlines FIFO, rejected event
+ */
+bool Scheduler_Dispatch(TScheduler *scheduler, uint32_t task, TEvent event, uint32_t now);
+
+/**
+ * @brief Dispatches an event with an absolute deadline
+ * @param scheduler The scheduler
+ * @param task Task id
+ * @param event The event
+ * @param deadline Absolute deadline, ticks
+ * @return true if the event was enqueued or deferred, false for invalid task, full queue or deadlines FIFO, rejected event
+ */
+bool Scheduler_DispatchWithDeadline(TScheduler *scheduler, uint32_t task, TEvent event, uint32_t deadline);
+
+/**
+ * @brief Dequeues the head event of the object with the earliest head deadline
+ * @param scheduler The scheduler
+ * @param now Current time, ticks, to count deadline misses
+ * @param[out] event The dequeued event
+ * @return The object to process the event, NULL if there are no pending events
+ */
+TActiveObject *Scheduler_Next(TScheduler *scheduler, uint32_t now, TEvent *event);
+
+#endif //SCHEDULER_H
@@ -0,0 +1,151 @@
+#include <string.h>
+
+#include "./shared_queue.h"
+
+/** @brief Rounds slot size up to keep slots 8 bytes aligned */
+#define SHARED_QUEUE_SLOT_ALIGNMENT     (8u)
+
+/** @brief Returns the slot size for the payload max size */
+static inline uint32_t _getSlotSize(uint32_t payloadMaxSize);
+
+/** @brief Returns the slot by a free running index */
+static inline TSharedQueueSlot *_getSlot(TSharedQueue *queue, uint32_t index);
+
+size_t SharedQueue_GetRegionSize(uint32_t capacity, uint32_t payloadMaxSize) {
+    return sizeof(TSharedQueueHeader) + (size_t) capacity * _getSlotSize(payloadMaxSize);
+}
+
+bool SharedQueue_Create(TSharedQueue *queue, void *region, size_t regionSize, uint32_t capacity, uint32_t payloadMaxSize) {
+    // Capacity must be a power of two to wrap free running indices with a mask
+    if (NULL == region || 0 == capacity || 0 != (capacity & (capacity - 1u))) return false;
+    if (regionSize < SharedQueue_GetRegionSize(capacity, payloadMaxSize)) return false;
+
+    TSharedQueueHeader *header = (TSharedQueueHeader *) region;
+
+    memset(header, 0, sizeof(TSharedQueueHeader));
+    header->capacity = capacity;
+    header->slotSize = _getSlotSize(payloadMaxSize);
+    header->payloadMaxSize = payloadMaxSize;
+    header->slotsOffset = sizeof(TSharedQueueHeader);
+
+    // Publish the format last, so an attaching process sees a complete header
+    __atomic_store_n(&header->magic, SHARED_QUEUE_MAGIC, __ATOMIC_RELEASE);
+
+    return SharedQueue_Attach(queue, region, regionSize);
+}
+
+bool SharedQueue_Attach(TSharedQueue *queue, void *region, size_t regionSize) {
+    TSharedQueueHeader *header = (TSharedQueueHeader *) region;
+
+    if (NULL == region || regionSize < sizeof(TSharedQueueHeader)) return false;
+    if (SHARED_QUEUE_MAGIC != __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE)) return false;
+
+    // The header is written by the peer: read the geometry once and validate the copy
+    const uint32_t capacity = header->capacity;
+    const uint32_t slotSize = header->slotSize;
+    const uint32_t payloadMaxSize = header->payloadMaxSize;
+    const uint32_t slotsOffset = header->slotsOffset;
+
+    if (0 == capacity || 0 != (capacity & (capacity - 1u))) return false;
+    if ((uint64_t) slotSize < sizeof(TSharedQueueSlot) + (uint64_t) payloadMaxSize) return false;
+    if (0 != slotSize % SHARED_QUEUE_SLOT_ALIGNMENT || 0 != slotsOffset % SHARED_QUEUE_SLOT_ALIGNMENT) return false;
+    if (slotsOffset < sizeof(TSharedQueueHeader)) return false;
+    if ((uint64_t) regionSize < slotsOffset + (uint64_t) capacity * slotSize) return false;
+
+    queue->header = header;
+    queue->slots = (uint8_t *) region + slotsOffset;
+    queue->wake = NULL;
+    queue->mask = capacity - 1u;
+    queue->slotSize = slotSize;
+    queue->payloadMaxSize = payloadMaxSize;
+    queue->corruptedCount = 0;
+
+    return true;
+}
+
+void SharedQueue_SetWake(TSharedQueue *queue, TSharedQueueWake wake) {
+    queue->wake = wake;
+}
+
+bool SharedQueue_Enqueue(TSharedQueue *queue, TEvent event) {
+    TSharedQueueHeader *header = queue->header;
+    const uint32_t tail = header->tail;
+
+    if (event.size > queue->payloadMaxSize) return false;
+    if (tail - __atomic_load_n(&header->head, __ATOMIC_ACQUIRE) > queue->mask) return false;
+
+    TSharedQueueSlot *slot = _getSlot(queue, tail);
+    slot->sig = (int32_t) event.sig;
+    slot->size = (uint32_t) event.size;
+    if (event.size) memcpy(slot + 1, event.payload, event.size);
+
+    __atomic_store_n(&header->tail, tail + 1u, __ATOMIC_RELEASE);
+
+    // Wake the consumer only if it announced sleeping, the fence orders the tail store before the flag load
+    if (queue->wake) {
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_exchange_n(&header->isSleeping, 0, __ATOMIC_ACQ_REL)) queue->wake(&header->tail);
+    }
+
+    return true;
+}
+
+TEvent SharedQueue_Peek(TSharedQueue *queue) {
+    TSharedQueueHeader *header = queue->header;
+    const uint32_t head = header->head;
+
+    if (head == __atomic_load_n(&header->tail, __ATOMIC_ACQUIRE)) return EVENT_EMPTY;
+
+    TSharedQueueSlot *slot = _getSlot(queue, head);
+    const uint32_t size = slot->size;
+
+    // The size is written by the peer, a payload over the max would run past the slot
+    if (size > queue->payloadMaxSize) {
+        queue->corruptedCount++;
+        return EVENT_EMPTY;
+    }
+
+    return EVENT_MAKE(slot->sig, size ? (void *) (slot + 1) : NULL, size);
+}
+
+void SharedQueue_Release(TSharedQueue *queue) {
+    TSharedQueueHeader *header = queue->header;
+    const uint32_t head = header->head;
+
+    if (head == __atomic_load_n(&header->tail, __ATOMIC_ACQUIRE)) return;
+
+    __atomic_store_n(&header->head, head + 1u, __ATOMIC_RELEASE);
+}
+
+bool SharedQueue_IsEmpty(TSharedQueue *queue) {
+    return queue->header->head == __atomic_load_n(&queue->header->tail, __ATOMIC_ACQUIRE);
+}
+
+bool SharedQueue_PrepareWait(TSharedQueue *queue, uint32_t **address, uint32_t *expected) {
+    TSharedQueueHeader *header = queue->header;
+
+    if (!SharedQueue_IsEmpty(queue)) return false;
+
+    // Announce sleeping, then re-check: the producer either sees the flag or we see its tail
+    __atomic_store_n(&header->isSleeping, 1, __ATOMIC_SEQ_CST);
+
+    const uint32_t tail = __atomic_load_n(&header->tail, __ATOMIC_SEQ_CST);
+
+    if (tail != header->head) {
+        __atomic_store_n(&header->isSleeping, 0, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    *address = &header->tail;
+    *expected = tail;
+    return true;
+}
+
+static inline uint32_t _getSlotSize(uint32_t payloadMaxSize) {
+    uint32_t size = (uint32_t) sizeof(TSharedQueueSlot) + payloadMaxSize;
+    return (size + SHARED_QUEUE_SLOT_ALIGNMENT - 1u) & ~(SHARED_QUEUE_SLOT_ALIGNMENT - 1u);
+}
+
+static inline TSharedQueueSlot *_getSlot(TSharedQueue *queue, uint32_t index) {
+    return (TSharedQueueSlot *) (queue->slots + (size_t) (index & queue->mask) * queue->slotSize);
+}
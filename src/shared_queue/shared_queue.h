@@ -0,0 +1,169 @@
+/**
+ * @file shared_queue.h
+ *
+ * @brief Position-independent SPSC event queue for shared memory
+ * @see event_queue.h for the process local queue.
+ *
+ * @details The queue lives entirely inside a user-provided memory region,
+ * e.g. a memfd/shm_open segment mapped by two processes (at different addresses),
+ * or a dual-port RAM shared by two cores. The region holds a header with indices
+ * and an array of slots, every slot keeps the event signal, payload size and an inline payload copy.
+ * Only offsets are stored in the region, no pointers, so any process can attach to it.
+ *
+ * One process enqueues, another one dequeues. Dequeued event payload points into the slot
+ * (zero copy) and stays valid until SharedQueue_Release.
+ * The peer process is not trusted: the region geometry is validated on attach and copied into the local handle,
+ * the operations never re-read it from the region, and a slot payload size over the max is treated as corruption.
+ *
+ * Optional wakeup: the consumer announces it's going to sleep with SharedQueue_PrepareWait
+ * and waits on the returned address (e.g. futex wait), the producer calls the wake function
+ * (e.g. futex wake) only if the consumer is sleeping.
+ *
+ * ### Example:
+ * @code
+ * size_t regionSize = SharedQueue_GetRegionSize(QUEUE_CAPACITY, PAYLOAD_MAX_SIZE);
+ * void *region = mmap(NULL, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+ *
+ * // producer process
+ * SharedQueue_Create(&queue, region, regionSize, QUEUE_CAPACITY, PAYLOAD_MAX_SIZE);
+ * SharedQueue_Enqueue(&queue, (TEvent){.sig = DATA_SIG, .payload = &data, .size = sizeof(data)});
+ *
+ * // consumer process
+ * SharedQueue_Attach(&queue, region, regionSize);
+ * TEvent event = SharedQueue_Peek(&queue);
+ * ActiveObject_Dispatch(&activeObject, event); // or copy the payload out
+ * SharedQueue_Release(&queue);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef SHARED_QUEUE_H
+#define SHARED_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../event_queue/event_queue.h"
+
+/** @brief Cache line size, producer and consumer indices are kept on separate lines */
+#ifndef SHARED_QUEUE_CACHE_LINE_SIZE
+#define SHARED_QUEUE_CACHE_LINE_SIZE    (64)
+#endif
+
+/** @brief Region format marker and version */
+#define SHARED_QUEUE_MAGIC              (0x53514531u) // "SQE1"
+
+/** @brief Wake function, e.g. futex wake on the address */
+typedef void (*TSharedQueueWake)(uint32_t *const address);
+
+/** @brief Region header, placed at the region start */
+typedef struct TSharedQueueHeader {
+    uint32_t magic;             /**< SHARED_QUEUE_MAGIC when formatted */
+    uint32_t capacity;          /**< Slots number, a power of two */
+    uint32_t slotSize;          /**< Size of a single slot */
+    uint32_t payloadMaxSize;    /**< Max inline payload size */
+    uint32_t slotsOffset;       /**< Offset of the first slot from the region start */
+    uint8_t headerPadding[SHARED_QUEUE_CACHE_LINE_SIZE - 5 * sizeof(uint32_t)];
+    uint32_t tail;              /**< Producer: free running write index, also the wait address */
+    uint8_t producerPadding[SHARED_QUEUE_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    uint32_t head;              /**< Consumer: free running read index */
+    uint32_t isSleeping;        /**< Consumer: waits for the tail to change */
+    uint8_t consumerPadding[SHARED_QUEUE_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
+} TSharedQueueHeader;
+
+/** @brief Slot header, followed by the inline payload */
+typedef struct TSharedQueueSlot {
+    int32_t sig;                /**< Signal */
+    uint32_t size;              /**< Payload size */
+} TSharedQueueSlot;
+
+/** @brief Process local handle of a shared queue, keeps the geometry validated on attach */
+typedef struct TSharedQueue {
+    TSharedQueueHeader *header;     /**< Region start in this process address space */
+    uint8_t *slots;                 /**< First slot in this process address space */
+    TSharedQueueWake wake;          /**< Optional wake function, producer side */
+    uint32_t mask;                  /**< Capacity - 1, local copy */
+    uint32_t slotSize;              /**< Size of a single slot, local copy */
+    uint32_t payloadMaxSize;        /**< Max inline payload size, local copy */
+    uint32_t corruptedCount;        /**< Peeked slots with a payload size over payloadMaxSize */
+} TSharedQueue;
+
+/**
+ * @brief Get the region size required for the queue
+ * @param capacity Slots number, a power of two
+ * @param payloadMaxSize Max inline payload size
+ * @return Region size in bytes
+ */
+size_t SharedQueue_GetRegionSize(uint32_t capacity, uint32_t payloadMaxSize);
+
+/**
+ * @brief Formats an empty queue in the region, called once by the region owner
+ * @param queue The local handle to initialize
+ * @param region The mapped region
+ * @param regionSize Size of the region
+ * @param capacity Slots number, a power of two
+ * @param payloadMaxSize Max inline payload size
+ * @return true for success, false for invalid args or too small region
+ */
+bool SharedQueue_Create(TSharedQueue *queue, void *region, size_t regionSize, uint32_t capacity, uint32_t payloadMaxSize);
+
+/**
+ * @brief Attaches to a queue formatted by another process
+ * @param queue The local handle to initialize
+ * @param region The mapped region
+ * @param regionSize Size of the region
+ * @return true for success, false for not formatted, inconsistent (capacity not a power of two,
+ * slots smaller than the max payload, slots outside of the region) or too small region
+ */
+bool SharedQueue_Attach(TSharedQueue *queue, void *region, size_t regionSize);
+
+/**
+ * @brief Sets the wake function, producer side
+ * @param queue The local handle
+ * @param wake The wake function, NULL to disable wakeups
+ */
+void SharedQueue_SetWake(TSharedQueue *queue, TSharedQueueWake wake);
+
+/**
+ * @brief Enqueues an event, copying its payload inline, producer side only
+ * @param queue The local handle
+ * @param event The event, payload size up to payloadMaxSize
+ * @return true for success, false if the queue is full or the payload is too big
+ */
+bool SharedQueue_Enqueue(TSharedQueue *queue, TEvent event);
+
+/**
+ * @brief Peeks the oldest event, consumer side only
+ * @param queue The local handle
+ * @return The event with payload pointing into the slot, EVENT_EMPTY if the queue is empty
+ * @returns EVENT_EMPTY for a corrupted slot, counted in corruptedCount, it should be released as usual
+ */
+TEvent SharedQueue_Peek(TSharedQueue *queue);
+
+/**
+ * @brief Releases the oldest event slot back to the producer, consumer side only
+ * @param queue The local handle
+ */
+void SharedQueue_Release(TSharedQueue *queue);
+
+/**
+ * @brief Checks if the queue is empty
+ * @param queue The local handle
+ * @return true if empty, false if not empty
+ */
+bool SharedQueue_IsEmpty(TSharedQueue *queue);
+
+/**
+ * @brief Announces the consumer is going to sleep, consumer side only
+ * @details Should be followed by a wait (e.g. futex wait) on the address while it holds the expected value.
+ *
+ * @param queue The local handle
+ * @param[out] address Address to wait on
+ * @param[out] expected Value to wait while it's unchanged
+ * @return true if the consumer should wait, false if the queue is not empty
+ */
+bool SharedQueue_PrepareWait(TSharedQueue *queue, uint32_t **address, uint32_t *expected);
+
+#endif //SHARED_QUEUE_H
@@ -0,0 +1,238 @@
+#include "./simulation.h"
+
+/** @brief Checks if the event a is due before the event b, equal-time events in the schedule order */
+static inline bool _isBefore(const TSimulationEvent *a, const TSimulationEvent *b);
+
+/** @brief Melds two pairing heaps, either may be NULL */
+static inline TSimulationEvent *_meld(TSimulationEvent *a, TSimulationEvent *b);
+
+/** @brief Two-pass merge of the root children into a new heap */
+static TSimulationEvent *_mergePairs(TSimulationEvent *first);
+
+/** @brief Unlinks a node from the calendar, the node children are merged back */
+static void _unlink(TSimulation *simulation, TSimulationEvent *node);
+
+/** @brief Makes the node tokens stale and returns it to the free list unless it is retired */
+static inline void _release(TSimulation *simulation, TSimulationEvent *node);
+
+/** @brief Processes queued events of the objects until all queues are empty */
+static void _drain(TSimulation *simulation);
+
+void Simulation_Initialize(TSimulation *simulation, TSimulationEvent *events, uint32_t eventsMax,
+                           TSimulationObject *objects, uint32_t objectsMax) {
+    if (eventsMax > SIMULATION_EVENTS_MAX) eventsMax = SIMULATION_EVENTS_MAX;
+
+    simulation->events = events;
+    simulation->eventsMax = eventsMax;
+    simulation->root = NULL;
+    simulation->freeHead = eventsMax ? &events[0] : NULL;
+    simulation->objects = objects;
+    simulation->objectsMax = objectsMax;
+    simulation->objectsCount = 0;
+    simulation->now = 0;
+    simulation->order = 0;
+    simulation->pendingCount = 0;
+    simulation->droppedCount = 0;
+    simulation->processedCount = 0;
+
+    for (uint32_t i = 0; i < eventsMax; i++) {
+        events[i].target = NULL;
+        events[i].child = NULL;
+        events[i].sibling = (i + 1 < eventsMax) ? &events[i + 1] : NULL;
+        events[i].generation = HANDLE_GENERATION_FIRST;
+    }
+}
+
+bool Simulation_AddObject(TSimulation *simulation, TActiveObject *activeObject,
+                          uint32_t statesMax, uint32_t eventsMax, const TEventHandler *transitionTable) {
+    if (NULL == activeObject || NULL == transitionTable) return false;
+    if (simulation->objectsCount >= simulation->objectsMax) return false;
+
+    simulation->objects[simulation->objectsCount++] = (TSimulationObject) {
+        .activeObject = activeObject,
+        .statesMax = statesMax,
+        .eventsMax = eventsMax,
+        .transitionTable = transitionTable,
+    };
+
+    return true;
+}
+
+TSimulationTimer Simulation_Schedule(TSimulation *simulation, TActiveObject *target, TEvent event, uint64_t delay) {
+    TSimulationEvent *node = simulation->freeHead;
+
+    if (NULL == target || NULL == node) return SIMULATION_INVALID_TIMER;
+
+    simulation->freeHead = node->sibling;
+
+    node->target = target;
+    node->event = event;
+    node->time = delay > SIMULATION_FOREVER - simulation->now ? SIMULATION_FOREVER : simulation->now + delay;
+    node->order = simulation->order++;
+    node->child = NULL;
+    node->sibling = NULL;
+    node->prev = NULL;
+
+    simulation->root = _meld(simulation->root, node);
+    simulation->pendingCount++;
+
+    return Handle_Make((uint32_t) (node - simulation->events), node->generation);
+}
+
+bool Simulation_Cancel(TSimulation *simulation, TSimulationTimer timer) {
+    uint32_t index = Handle_GetIndex(timer);
+
+    if (index >= simulation->eventsMax) return false;
+
+    TSimulationEvent *node = &simulation->events[index];
+
+    if (NULL == node->target || node->generation != Handle_GetGeneration(timer)) return false;
+
+    _unlink(simulation, node);
+    _release(simulation, node);
+    simulation->pendingCount--;
+    return true;
+}
+
+uint64_t Simulation_Now(const TSimulation *simulation) {
+    return simulation->now;
+}
+
+uint64_t Simulation_Run(TSimulation *simulation, uint64_t until) {
+    uint64_t processedCount = simulation->processedCount;
+
+    // Events dispatched before the run are processed at the current time
+    _drain(simulation);
+
+    while (simulation->root && simulation->root->time <= until) {
+        simulation->now = simulation->root->time;
+
+        // Dispatch every event due now, including ones scheduled with no delay by the previous pass
+        while (simulation->root && simulation->root->time == simulation->now) {
+            TSimulationEvent *node = simulation->root;
+
+            simulation->root = _mergePairs(node->child);
+            simulation->pendingCount--;
+
+            // Rejected events are counted by the target
+            if (ACTIVE_OBJECT_DISPATCH_FULL == ActiveObject_Submit(node->target, node->event)) simulation->droppedCount++;
+
+            _release(simulation, node);
+        }
+
+        _drain(simulation);
+    }
+
+    if (SIMULATION_FOREVER != until && until > simulation->now) simulation->now = until;
+
+    return simulation->processedCount - processedCount;
+}
+
+static inline bool _isBefore(const TSimulationEvent *a, const TSimulationEvent *b) {
+    return a->time < b->time || (a->time == b->time && a->order < b->order);
+}
+
+static inline TSimulationEvent *_meld(TSimulationEvent *a, TSimulationEvent *b) {
+    if (NULL == a) return b;
+    if (NULL == b) return a;
+
+    if (_isBefore(b, a)) {
+        TSimulationEvent *root = b;
+        b = a;
+        a = root;
+    }
+
+    // The later heap becomes the first child of the earlier root
+    b->sibling = a->child;
+    if (b->sibling) b->sibling->prev = b;
+    b->prev = a;
+    a->child = b;
+    return a;
+}
+
+static TSimulationEvent *_mergePairs(TSimulationEvent *first) {
+    TSimulationEvent *pairs = NULL;
+
+    // Left to right: meld siblings in pairs, the melded pairs are linked in reverse
+    while (first) {
+        TSimulationEvent *a = first;
+        TSimulationEvent *b = a->sibling;
+
+        first = b ? b->sibling : NULL;
+        a->sibling = NULL;
+        if (b) b->sibling = NULL;
+
+        TSimulationEvent *pair = _meld(a, b);
+        pair->sibling = pairs;
+        pairs = pair;
+    }
+
+    // Right to left: meld the pairs into a single heap
+    TSimulationEvent *root = NULL;
+
+    while (pairs) {
+        TSimulationEvent *next = pairs->sibling;
+
+        pairs->sibling = NULL;
+        root = _meld(root, pairs);
+        pairs = next;
+    }
+
+    if (root) root->prev = NULL;
+    return root;
+}
+
+static void _unlink(TSimulation *simulation, TSimulationEvent *node) {
+    if (node == simulation->root) {
+        simulation->root = _mergePairs(node->child);
+        return;
+    }
+
+    // Cut the node subtree out of its parent children list
+    if (node->prev->child == node) {
+        node->prev->child = node->sibling;
+    } else {
+        node->prev->sibling = node->sibling;
+    }
+
+    if (node->sibling) node->sibling->prev = node->prev;
+
+    node->sibling = NULL;
+    simulation->root = _meld(simulation->root, _mergePairs(node->child));
+}
+
+static inline void _release(TSimulation *simulation, TSimulationEvent *node) {
+    node->target = NULL;
+    node->child = NULL;
+
+    // Bump generation to make all copies of the token stale, a saturated node is retired
+    if (Handle_NextGeneration(&node->generation)) {
+        node->sibling = simulation->freeHead;
+        simulation->freeHead = node;
+    }
+}
+
+static void _drain(TSimulation *simulation) {
+    bool isBusy = true;
+
+    while (isBusy) {
+        isBusy = false;
+
+        for (uint32_t i = 0; i < simulation->objectsCount; i++) {
+            TSimulationObject *object = &simulation->objects[i];
+            TActiveObject *activeObject = object->activeObject;
+
+            if (EventQueue_IsEmpty(&activeObject->queue)) continue;
+
+            TEvent event = ActiveObject_ProcessQueue(activeObject);
+            const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(
+                    activeObject, event, object->statesMax, object->eventsMax,
+                    (const TEventHandler (*)[object->eventsMax]) object->transitionTable);
+
+            if (FSM_IsValidState(nextState)) FSM_TraverseAOToNextState(activeObject, nextState);
+
+            simulation->processedCount++;
+            isBusy = true;
+        }
+    }
+}
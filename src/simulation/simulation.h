@@ -0,0 +1,165 @@
+/**
+ * @file simulation.h
+ *
+ * @brief Virtual-time discrete-event simulation of Active Objects driven by transition tables
+ * @see fsm.h for the event processing and the state hooks.
+ *
+ * @details The simulation keeps a virtual clock and a global calendar of future events,
+ * a pairing heap of user-allocated nodes ordered by (time, schedule order), so equal-time events
+ * run in the order they were scheduled and every run of the same scenario is the same.
+ * Simulation_Run jumps the clock straight to the next calendar time, dispatches every event due at that time
+ * and then processes the queues of the added objects round-robin, one event per object per pass in the adding order,
+ * until all of them are empty. Events are processed by FSM_ProcessEventToNextStateFromTransitionTable
+ * and FSM_TraverseAOToNextState, so the same objects, tables and hooks run as on the target.
+ *
+ * Handlers and hooks start timers with Simulation_Schedule and read the clock with Simulation_Now,
+ * which are the port timer service calls under simulation. Events dispatched with ActiveObject_Dispatch
+ * to any added object are processed at the current time. A timer is canceled by its generation-tagged token
+ * (see handle.h), a stale token of a fired or canceled timer is rejected: a node is retired when its 32-bit generation saturates.
+ * A canceled timer is unlinked from the calendar right away, so its node is free for the next Simulation_Schedule.
+ *
+ * Time is in user ticks (uint64_t), e.g. microseconds, and never wraps.
+ * Every due time costs a calendar pop, O(log n) amortized, and a check of every added object queue,
+ * so systems of many rarely active objects simulate slower per event than a few busy ones.
+ *
+ * ### Example:
+ * @code
+ * TSimulationEvent calendar[TIMERS_MAX];
+ * TSimulationObject objects[OBJECTS_MAX];
+ *
+ * Simulation_Initialize(&simulation, calendar, TIMERS_MAX, objects, OBJECTS_MAX);
+ * Simulation_AddObject(&simulation, &blinky, BLINKY_ST_MAX, BLINKY_SIG_MAX, &transitionTable[0][0]);
+ *
+ * // onEnter hook of LED_ON_ST
+ * Simulation_Schedule(&simulation, activeObject, (TEvent){.sig = TIMEOUT_SIG}, BLINK_PERIOD_US);
+ *
+ * Simulation_Schedule(&simulation, &blinky, (TEvent){.sig = START_SIG}, 0);
+ * Simulation_Run(&simulation, 3600ull * 1000000ull);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+#include "../fsm/fsm.h"
+#include "../handle/handle.h"
+
+/** @brief Bits of the timer token holding the calendar node index, the rest holds the node generation */
+#define SIMULATION_INDEX_BITS       (HANDLE_INDEX_BITS)
+#define SIMULATION_INDEX_MASK       (HANDLE_INDEX_MASK)
+
+/** @brief Max nodes number in a single calendar */
+#define SIMULATION_EVENTS_MAX       (SIMULATION_INDEX_MASK)
+
+/** @brief Timer token which is never given to a scheduled event */
+#define SIMULATION_INVALID_TIMER    (HANDLE_INVALID)
+
+/** @brief Horizon of a run until the calendar is empty */
+#define SIMULATION_FOREVER          (UINT64_MAX)
+
+/** @brief Generation-tagged timer token: [generation:32][calendar node index:32] */
+typedef THandle TSimulationTimer;
+
+/** @brief Calendar node, should be allocated by user */
+typedef struct TSimulationEvent {
+    TActiveObject *target;              /**< Object to receive the event, NULL for a free node */
+    TEvent event;                       /**< The scheduled event */
+    uint64_t time;                      /**< Virtual time of the dispatch */
+    uint64_t order;                     /**< Schedule order, breaks equal-time ties */
+    struct TSimulationEvent *child;     /**< First child in the pairing heap */
+    struct TSimulationEvent *sibling;   /**< Next sibling in the pairing heap, or next free node */
+    struct TSimulationEvent *prev;      /**< Parent of a first child, previous sibling otherwise, NULL for the root */
+    uint32_t generation;                /**< Incremented when the node leaves the calendar, the node is retired when it saturates */
+} TSimulationEvent;
+
+/** @brief Simulated Active Object */
+typedef struct TSimulationObject {
+    TActiveObject *activeObject;            /**< The object */
+    uint32_t statesMax;                     /**< The maximum number of states */
+    uint32_t eventsMax;                     /**< The maximum number of events */
+    const TEventHandler *transitionTable;   /**< Flattened [statesMax][eventsMax] transition table */
+} TSimulationObject;
+
+/** @brief Simulation runtime */
+typedef struct TSimulation {
+    TSimulationEvent *events;       /**< Calendar nodes array */
+    uint32_t eventsMax;             /**< Capacity of the calendar nodes array */
+    TSimulationEvent *root;         /**< Pairing heap root, the next event */
+    TSimulationEvent *freeHead;     /**< First free calendar node */
+    TSimulationObject *objects;     /**< Objects array */
+    uint32_t objectsMax;            /**< Capacity of the objects array */
+    uint32_t objectsCount;          /**< Number of added objects */
+    uint64_t now;                   /**< Virtual clock, ticks */
+    uint64_t order;                 /**< Next schedule order */
+    uint32_t pendingCount;          /**< Number of scheduled, not canceled events */
+    uint32_t droppedCount;          /**< Events due while the target queue was full */
+    uint64_t processedCount;        /**< Events processed by the objects */
+} TSimulation;
+
+/**
+ * @brief Initializes a simulation at time 0 with an empty calendar and no objects
+ * @param simulation The simulation
+ * @param events Calendar nodes array, allocated by the user
+ * @param eventsMax Capacity of the calendar nodes array, up to SIMULATION_EVENTS_MAX
+ * @param objects Objects array, allocated by the user
+ * @param objectsMax Capacity of the objects array
+ */
+void Simulation_Initialize(TSimulation *simulation, TSimulationEvent *events, uint32_t eventsMax,
+                           TSimulationObject *objects, uint32_t objectsMax);
+
+/**
+ * @brief Adds an Active Object processed by its transition table
+ * @param simulation The simulation
+ * @param activeObject Initialized Active Object in its initial state
+ * @param statesMax The maximum number of states
+ * @param eventsMax The maximum number of events
+ * @param transitionTable Flattened [statesMax][eventsMax] transition table
+ * @return true for success, false for invalid args or no room
+ */
+bool Simulation_AddObject(TSimulation *simulation, TActiveObject *activeObject,
+                          uint32_t statesMax, uint32_t eventsMax, const TEventHandler *transitionTable);
+
+/**
+ * @brief Schedules an event to the object after a delay of virtual time
+ * @param simulation The simulation
+ * @param target Object to receive the event
+ * @param event The event
+ * @param delay Delay from the current virtual time, ticks, 0 for the current time after the already due events
+ * @return Timer token
+ * @returns SIMULATION_INVALID_TIMER for invalid target or full calendar
+ */
+TSimulationTimer Simulation_Schedule(TSimulation *simulation, TActiveObject *target, TEvent event, uint64_t delay);
+
+/**
+ * @brief Cancels a scheduled event and returns its node to the free list, O(log n) amortized
+ * @param simulation The simulation
+ * @param timer Token of the scheduled event
+ * @return true for success, false for a stale or invalid token
+ */
+bool Simulation_Cancel(TSimulation *simulation, TSimulationTimer timer);
+
+/**
+ * @brief Returns the current virtual time
+ * @param simulation The simulation
+ * @return Virtual time, ticks
+ */
+uint64_t Simulation_Now(const TSimulation *simulation);
+
+/**
+ * @brief Runs the simulation up to the horizon
+ * @details Stops at the first event later than the horizon or when the calendar is empty and moves the clock to the horizon.
+ * A run with SIMULATION_FOREVER leaves the clock at the last event time.
+ * @param simulation The simulation
+ * @param until Horizon, ticks, SIMULATION_FOREVER to run until the calendar is empty
+ * @return Number of events processed by the objects during the run
+ */
+uint64_t Simulation_Run(TSimulation *simulation, uint64_t until);
+
+#endif //SIMULATION_H
@@ -0,0 +1,234 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "./snapshot.h"
+
+/** @brief Records, events and payloads are 8 bytes aligned in the image */
+#define SNAPSHOT_ALIGNMENT      (8u)
+
+/** @brief Record flag: the object has a current state */
+#define SNAPSHOT_HAS_STATE      (1u)
+
+/** @brief Object record, followed by the queue events, the deferred events and the user fields */
+typedef struct TSnapshotRecord {
+    int32_t stateName;          /**< Current state name */
+    uint32_t flags;             /**< SNAPSHOT_HAS_STATE */
+    uint32_t eventsCount;       /**< Pending events number */
+    uint32_t deferredCount;     /**< Deferred events number */
+    uint32_t fieldsSize;        /**< User fields size */
+    uint32_t resume;            /**< Coroutine resume point, also keeps the record 8 bytes aligned */
+} TSnapshotRecord;
+
+/** @brief Event header, followed by the inline payload */
+typedef struct TSnapshotEvent {
+    int32_t sig;                /**< Signal */
+    uint32_t size;              /**< Payload size */
+} TSnapshotEvent;
+
+/** @brief Rounds size up to SNAPSHOT_ALIGNMENT */
+static inline size_t _align(size_t size);
+
+/** @brief Writes all queue events at the offset, advances the offset */
+static inline bool _writeEvents(TEventQueue *queue, uint8_t *image, size_t imageSize, size_t *offset);
+
+/** @brief Writes the object record at the offset, advances the offset */
+static inline bool _writeRecord(TActiveObject *activeObject, uint8_t *image, size_t imageSize, size_t *offset,
+                                TSnapshotSaveFields saveFields, void *const ctx);
+
+/** @brief Walks count events at the offset, enqueues them if the queue is not NULL, advances the offset */
+static inline bool _readEvents(TSnapshot *snapshot, uint32_t count, TEventQueue *queue, size_t *offset);
+
+/** @brief Index entries order by id, for qsort and bsearch */
+static int _compareIndexEntries(const void *a, const void *b);
+
+size_t Snapshot_Write(TRegistry *registry, void *image, size_t imageSize, TSnapshotSaveFields saveFields, void *const ctx) {
+    uint8_t *bytes = (uint8_t *) image;
+    TSnapshotHeader *header = (TSnapshotHeader *) image;
+    TSnapshotIndexEntry *index = (TSnapshotIndexEntry *) (bytes + sizeof(TSnapshotHeader));
+    uint32_t shardsCount = REGISTRY_LOAD_ACQUIRE(&registry->shardsCount);
+    uint32_t registeredCount = 0;
+    uint32_t count = 0;
+    size_t offset = 0;
+    bool isWritten = NULL != image;
+
+    if (!isWritten) return 0;
+
+    // Shards are locked in order for a consistent image of the whole registry
+    for (uint32_t shard = 0; shard < shardsCount; shard++) {
+        REGISTRY_ENTER_CRITICAL(registry->shards[shard]);
+        registeredCount += registry->shards[shard]->count;
+    }
+
+    // The index size is taken under the locks, no registration can grow it past the first record
+    offset = _align(sizeof(TSnapshotHeader) + (size_t) registeredCount * sizeof(TSnapshotIndexEntry));
+    isWritten = offset <= imageSize;
+
+    for (uint32_t shard = 0; shard < shardsCount && isWritten; shard++) {
+        for (uint32_t i = 0; i < REGISTRY_SHARD_SIZE && isWritten; i++) {
+            TActiveObject *activeObject = registry->shards[shard]->slots[i].activeObject;
+
+            if (NULL == activeObject) continue;
+
+            index[count].id = activeObject->id;
+            index[count].offset = (uint32_t) offset;
+
+            isWritten = _writeRecord(activeObject, bytes, imageSize, &offset, saveFields, ctx);
+            count++;
+        }
+    }
+
+    for (uint32_t shard = shardsCount; shard > 0; shard--) REGISTRY_EXIT_CRITICAL(registry->shards[shard - 1]);
+
+    if (!isWritten || offset > UINT32_MAX) return 0;
+
+    qsort(index, count, sizeof(TSnapshotIndexEntry), _compareIndexEntries);
+
+    // Records are looked up by the object id, objects sharing an id can't be restored unambiguously
+    for (uint32_t i = 1; i < count; i++) {
+        if (index[i - 1].id == index[i].id) return 0;
+    }
+
+    header->magic = SNAPSHOT_MAGIC;
+    header->version = SNAPSHOT_VERSION;
+    header->count = count;
+    header->imageSize = (uint32_t) offset;
+
+    return offset;
+}
+
+bool Snapshot_Open(TSnapshot *snapshot, void *image, size_t imageSize) {
+    TSnapshotHeader *header = (TSnapshotHeader *) image;
+
+    if (NULL == image || imageSize < sizeof(TSnapshotHeader)) return false;
+    if (SNAPSHOT_MAGIC != header->magic || SNAPSHOT_VERSION != header->version) return false;
+    if (header->imageSize > imageSize) return false;
+    if (sizeof(TSnapshotHeader) + (size_t) header->count * sizeof(TSnapshotIndexEntry) > header->imageSize) return false;
+
+    snapshot->image = (uint8_t *) image;
+    snapshot->imageSize = header->imageSize;
+    snapshot->index = (const TSnapshotIndexEntry *) (snapshot->image + sizeof(TSnapshotHeader));
+    snapshot->count = header->count;
+
+    return true;
+}
+
+bool Snapshot_Restore(TSnapshot *snapshot, TActiveObject *activeObject, const TState *states, uint32_t statesMax,
+                      TSnapshotLoadFields loadFields, void *const ctx) {
+    TSnapshotIndexEntry key = {.id = activeObject->id};
+    const TSnapshotIndexEntry *entry = bsearch(&key, snapshot->index, snapshot->count,
+                                               sizeof(TSnapshotIndexEntry), _compareIndexEntries);
+
+    if (NULL == entry || (size_t) entry->offset + sizeof(TSnapshotRecord) > snapshot->imageSize) return false;
+
+    const TSnapshotRecord *record = (const TSnapshotRecord *) (snapshot->image + entry->offset);
+    const TState *state = NULL;
+
+    if (record->flags & SNAPSHOT_HAS_STATE) {
+        if (NULL == states || record->stateName < 0 || (uint32_t) record->stateName >= statesMax) return false;
+        state = &states[record->stateName];
+    }
+
+    if (record->eventsCount > EventQueue_GetFreeSize(&activeObject->queue)) return false;
+    if (record->deferredCount > EventQueue_GetFreeSize(&activeObject->deferredQueue)) return false;
+
+    // Validate the whole record before touching the object, so a truncated image leaves it intact
+    size_t eventsOffset = entry->offset + sizeof(TSnapshotRecord);
+    size_t offset = eventsOffset;
+
+    if (!_readEvents(snapshot, record->eventsCount + record->deferredCount, NULL, &offset)) return false;
+    if (offset + record->fieldsSize > snapshot->imageSize) return false;
+
+    const uint8_t *fields = snapshot->image + offset;
+
+    // Only a ring allocation of a growable queue may fail here
+    offset = eventsOffset;
+    if (!_readEvents(snapshot, record->eventsCount, &activeObject->queue, &offset)) return false;
+    if (!_readEvents(snapshot, record->deferredCount, &activeObject->deferredQueue, &offset)) return false;
+    activeObject->state = state;
+    activeObject->resume = record->resume;
+
+    if (loadFields) return loadFields(activeObject, fields, record->fieldsSize, ctx);
+
+    return true;
+}
+
+static inline size_t _align(size_t size) {
+    return (size + SNAPSHOT_ALIGNMENT - 1u) & ~((size_t) SNAPSHOT_ALIGNMENT - 1u);
+}
+
+static inline bool _writeEvents(TEventQueue *queue, uint8_t *image, size_t imageSize, size_t *offset) {
+    uint32_t size = EventQueue_GetSize(queue);
+
+    for (uint32_t i = 0; i < size; i++) {
+        TEvent event = EventQueue_PeekAt(queue, i);
+        size_t payloadSize = event.payload ? event.size : 0;
+
+        if (*offset + sizeof(TSnapshotEvent) + payloadSize > imageSize || payloadSize > UINT32_MAX) return false;
+
+        TSnapshotEvent *snapshotEvent = (TSnapshotEvent *) (image + *offset);
+        snapshotEvent->sig = (int32_t) event.sig;
+        snapshotEvent->size = (uint32_t) payloadSize;
+        if (payloadSize) memcpy(snapshotEvent + 1, event.payload, payloadSize);
+
+        *offset = _align(*offset + sizeof(TSnapshotEvent) + payloadSize);
+    }
+
+    return true;
+}
+
+static inline bool _writeRecord(TActiveObject *activeObject, uint8_t *image, size_t imageSize, size_t *offset,
+                                TSnapshotSaveFields saveFields, void *const ctx) {
+    if (*offset + sizeof(TSnapshotRecord) > imageSize) return false;
+
+    TSnapshotRecord *record = (TSnapshotRecord *) (image + *offset);
+
+    record->stateName = activeObject->state ? (int32_t) activeObject->state->name : 0;
+    record->flags = activeObject->state ? SNAPSHOT_HAS_STATE : 0;
+    record->eventsCount = EventQueue_GetSize(&activeObject->queue);
+    record->deferredCount = EventQueue_GetSize(&activeObject->deferredQueue);
+    record->fieldsSize = 0;
+    record->resume = activeObject->resume;
+    *offset += sizeof(TSnapshotRecord);
+
+    if (!_writeEvents(&activeObject->queue, image, imageSize, offset)) return false;
+    if (!_writeEvents(&activeObject->deferredQueue, image, imageSize, offset)) return false;
+
+    if (saveFields) {
+        size_t fieldsSize = saveFields(activeObject, image + *offset, imageSize - *offset, ctx);
+
+        if (fieldsSize > imageSize - *offset || fieldsSize > UINT32_MAX) return false;
+
+        record->fieldsSize = (uint32_t) fieldsSize;
+        *offset = _align(*offset + fieldsSize);
+    }
+
+    return true;
+}
+
+static inline bool _readEvents(TSnapshot *snapshot, uint32_t count, TEventQueue *queue, size_t *offset) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (*offset + sizeof(TSnapshotEvent) > snapshot->imageSize) return false;
+
+        TSnapshotEvent *snapshotEvent = (TSnapshotEvent *) (snapshot->image + *offset);
+
+        if (*offset + sizeof(TSnapshotEvent) + snapshotEvent->size > snapshot->imageSize) return false;
+
+        if (queue) {
+            TEvent event = EVENT_MAKE(snapshotEvent->sig, snapshotEvent->size ? (void *) (snapshotEvent + 1) : NULL,
+                                      snapshotEvent->size);
+
+            if (!EventQueue_Enqueue(queue, event)) return false;
+        }
+
+        *offset = _align(*offset + sizeof(TSnapshotEvent) + snapshotEvent->size);
+    }
+
+    return true;
+}
+
+static int _compareIndexEntries(const void *a, const void *b) {
+    uint32_t idA = ((const TSnapshotIndexEntry *) a)->id;
+    uint32_t idB = ((const TSnapshotIndexEntry *) b)->id;
+
+    return (idA > idB) - (idA < idB);
+}
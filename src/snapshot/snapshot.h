@@ -0,0 +1,136 @@
+/**
+ * @file snapshot.h
+ *
+ * @brief Checkpoint/restore of registered Active Objects to a binary image
+ * @see registry.h for the checkpointed objects.
+ *
+ * @details Snapshot_Write serializes every registered Active Object into a compact versioned image
+ * in a user buffer, so it can be stored with one sequential write. For every object the image keeps
+ * the current state name, the coroutine resume point, the pending and deferred events with inline payload copies,
+ * and user extension fields written by a callback.
+ *
+ * The image starts with a header and an index of (object id, record offset) entries sorted by id.
+ * Records are keyed by the TActiveObject id given to ActiveObject_Initialize, not by the registry id
+ * which changes between runs, so the ids of the registered objects must be unique.
+ * Snapshot_Open only validates the header, it doesn't touch the records,
+ * so the image can be memory-mapped and objects are rehydrated lazily with Snapshot_Restore
+ * on first access: a binary search in the index and a single record read.
+ * Startup time depends on the restored objects only.
+ *
+ * Restored event payloads point into the image (zero copy), so the image must outlive the events,
+ * map it writable (e.g. MAP_PRIVATE) if handlers modify payloads.
+ *
+ * ### Example:
+ * @code
+ * // checkpoint
+ * size_t imageSize = Snapshot_Write(&registry, image, sizeof(image), saveFields, NULL);
+ * write(fd, image, imageSize);
+ *
+ * // restore after restart
+ * void *image = mmap(NULL, imageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+ * Snapshot_Open(&snapshot, image, imageSize);
+ *
+ * // on first access of the object
+ * ActiveObject_Initialize(&activeObject, REQUEST_AO_ID, events, QUEUE_MAX_SIZE);
+ * Snapshot_Restore(&snapshot, &activeObject, statesList, STATES_MAX, loadFields, NULL);
+ * @endcode
+ *
+ * @author apolisskyi
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../active_object/active_object.h"
+#include "../registry/registry.h"
+
+/** @brief Image format marker */
+#define SNAPSHOT_MAGIC          (0x414F534Eu) // "AOSN"
+
+/** @brief Image format version, incremented on every layout change */
+#define SNAPSHOT_VERSION        (1u)
+
+/** @brief Image header */
+typedef struct TSnapshotHeader {
+    uint32_t magic;             /**< SNAPSHOT_MAGIC */
+    uint32_t version;           /**< SNAPSHOT_VERSION */
+    uint32_t count;             /**< Number of objects in the index */
+    uint32_t imageSize;         /**< Size of the whole image */
+} TSnapshotHeader;
+
+/** @brief Index entry, the index follows the header and is sorted by id */
+typedef struct TSnapshotIndexEntry {
+    uint32_t id;                /**< Active Object id */
+    uint32_t offset;            /**< Record offset from the image start */
+} TSnapshotIndexEntry;
+
+/**
+ * @brief Writes user extension fields of the object, e.g. of a sub Active Object
+ * @param activeObject The object being checkpointed
+ * @param buffer Where to write the fields
+ * @param bufferSize Free space in the buffer
+ * @param ctx User context
+ * @return Number of written bytes, a value greater than bufferSize means there is no room
+ */
+typedef size_t (*TSnapshotSaveFields)(const TActiveObject *const activeObject, uint8_t *buffer, size_t bufferSize, void *const ctx);
+
+/**
+ * @brief Reads user extension fields back to the object
+ * @param activeObject The object being restored
+ * @param fields The fields written by TSnapshotSaveFields
+ * @param size Size of the fields
+ * @param ctx User context
+ * @return true for success, false to fail the restore
+ */
+typedef bool (*TSnapshotLoadFields)(TActiveObject *const activeObject, const uint8_t *fields, size_t size, void *const ctx);
+
+/** @brief Opened image */
+typedef struct TSnapshot {
+    uint8_t *image;                     /**< Image start */
+    size_t imageSize;                   /**< Image size */
+    const TSnapshotIndexEntry *index;   /**< Sorted index */
+    uint32_t count;                     /**< Number of objects in the index */
+} TSnapshot;
+
+/**
+ * @brief Checkpoints all registered Active Objects into the image
+ * @param registry The registry of the objects
+ * @param image Buffer for the image, 8 bytes aligned
+ * @param imageSize Size of the buffer
+ * @param saveFields Optional user fields writer, NULL for no fields
+ * @param ctx User context passed to saveFields
+ * @return Size of the written image, 0 if the buffer is too small or registered objects share an id
+ */
+size_t Snapshot_Write(TRegistry *registry, void *image, size_t imageSize, TSnapshotSaveFields saveFields, void *const ctx);
+
+/**
+ * @brief Opens the image without reading the records
+ * @param snapshot The snapshot to initialize
+ * @param image The image, e.g. memory-mapped file
+ * @param imageSize Size of the image
+ * @return true for success, false for a foreign, other version or truncated image
+ */
+bool Snapshot_Open(TSnapshot *snapshot, void *image, size_t imageSize);
+
+/**
+ * @brief Rehydrates an initialized Active Object with the same id from the image
+ * @note The object queues should be set up (ActiveObject_Initialize, ActiveObject_InitializeDeferredQueue) and empty.
+ * Growable queues are checked against the rings they may grow to, a failed ring allocation fails the restore
+ * with the events restored so far left in the queue.
+ *
+ * @param snapshot The opened snapshot
+ * @param activeObject The object to restore, looked up by its id
+ * @param states States list indexed by state name
+ * @param statesMax Number of states in the list
+ * @param loadFields Optional user fields reader, NULL to skip the fields
+ * @param ctx User context passed to loadFields
+ * @return true for success, false if the object is not in the image, its state is unknown or queues are too small
+ */
+bool Snapshot_Restore(TSnapshot *snapshot, TActiveObject *activeObject, const TState *states, uint32_t statesMax,
+                      TSnapshotLoadFields loadFields, void *const ctx);
+
+#endif //SNAPSHOT_H
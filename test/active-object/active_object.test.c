@@ -5,7 +5,7 @@
 #define ACTIVE_OBJECT_ID 1
 
 typedef enum { NO_STATE, STATE_1 = 1, STATES_MAX } TEST_STATE; // state names
-typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENT_SIG_2 = 2, EVENT_SIG_3 = 3, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
 
 void setUp(void) {
     // Set up stuff here
@@ -28,7 +28,7 @@ void test_initializeActiveObject(void) {
 void test_dispatchEvent(void) {
     TEvent eventArray[QUEUE_MAX_SIZE];
     TActiveObject activeObject;
-    TEvent testEvent = {EVENT_SIG_1, NULL, 0};
+    TEvent testEvent = EVENT_MAKE(EVENT_SIG_1, NULL, 0);
     ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, QUEUE_MAX_SIZE);
     
     ActiveObject_Dispatch(&activeObject, testEvent);
@@ -38,7 +38,7 @@ void test_dispatchEvent(void) {
 void test_processQueue_WithEvent(void) {
     TEvent eventArray[QUEUE_MAX_SIZE];
     TActiveObject activeObject;
-    TEvent testEvent = {EVENT_SIG_1, NULL, 0};
+    TEvent testEvent = EVENT_MAKE(EVENT_SIG_1, NULL, 0);
     ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, QUEUE_MAX_SIZE);
     
     ActiveObject_Dispatch(&activeObject, testEvent);
@@ -57,12 +57,143 @@ void test_processQueue_EmptyQueue(void) {
     TEST_ASSERT_EQUAL(NO_SIG, processedEvent.size);
 }
 
+void test_defer_NoDeferredQueue(void) {
+    TEvent eventArray[QUEUE_MAX_SIZE];
+    TActiveObject activeObject;
+    ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, QUEUE_MAX_SIZE);
+
+    TEST_ASSERT_FALSE(ActiveObject_Defer(&activeObject, EVENT_MAKE(EVENT_SIG_1, NULL, 0)));
+    TEST_ASSERT_FALSE(ActiveObject_RecallOne(&activeObject));
+    TEST_ASSERT_EQUAL_UINT32(0, ActiveObject_RecallAll(&activeObject));
+}
+
+void test_defer_RecallOne(void) {
+    TEvent eventArray[QUEUE_MAX_SIZE];
+    TEvent deferredEventArray[QUEUE_MAX_SIZE];
+    TActiveObject activeObject;
+    ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, QUEUE_MAX_SIZE);
+    ActiveObject_InitializeDeferredQueue(&activeObject, deferredEventArray, QUEUE_MAX_SIZE);
+
+    ActiveObject_Dispatch(&activeObject, EVENT_MAKE(EVENT_SIG_3, NULL, 0));
+    TEST_ASSERT_TRUE(ActiveObject_Defer(&activeObject, EVENT_MAKE(EVENT_SIG_1, NULL, 0)));
+    TEST_ASSERT_TRUE(ActiveObject_Defer(&activeObject, EVENT_MAKE(EVENT_SIG_2, NULL, 0)));
+
+    TEST_ASSERT_TRUE(ActiveObject_RecallOne(&activeObject));
+
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, ActiveObject_ProcessQueue(&activeObject).sig);
+    TEST_ASSERT_EQUAL(EVENT_SIG_3, ActiveObject_ProcessQueue(&activeObject).sig);
+    TEST_ASSERT_EQUAL(EVENT_SIG_2, EventQueue_Peek(&activeObject.deferredQueue).sig);
+}
+
+void test_defer_RecallAll(void) {
+    TEvent eventArray[QUEUE_MAX_SIZE];
+    TEvent deferredEventArray[QUEUE_MAX_SIZE];
+    TActiveObject activeObject;
+    ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, QUEUE_MAX_SIZE);
+    ActiveObject_InitializeDeferredQueue(&activeObject, deferredEventArray, QUEUE_MAX_SIZE);
+
+    ActiveObject_Dispatch(&activeObject, EVENT_MAKE(EVENT_SIG_3, NULL, 0));
+    ActiveObject_Defer(&activeObject, EVENT_MAKE(EVENT_SIG_1, NULL, 0));
+    ActiveObject_Defer(&activeObject, EVENT_MAKE(EVENT_SIG_2, NULL, 0));
+
+    TEST_ASSERT_EQUAL_UINT32(2, ActiveObject_RecallAll(&activeObject));
+
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&activeObject.deferredQueue));
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, ActiveObject_ProcessQueue(&activeObject).sig);
+    TEST_ASSERT_EQUAL(EVENT_SIG_2, ActiveObject_ProcessQueue(&activeObject).sig);
+    TEST_ASSERT_EQUAL(EVENT_SIG_3, ActiveObject_ProcessQueue(&activeObject).sig);
+}
+
+// STATE_1 handles EVENT_SIG_1 only, EVENT_SIG_2 is deferrable
+const TState filterStates[STATES_MAX] = {[NO_STATE] = {.name = NO_STATE}, [STATE_1] = {.name = STATE_1}};
+const TSignalMask filterAccepted[STATES_MAX][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)] = {
+    [NO_STATE] = {(1u << EVENT_SIG_1) | (1u << EVENT_SIG_2) | (1u << EVENT_SIG_3)},
+    [STATE_1] = {1u << EVENT_SIG_1},
+};
+const TSignalMask filterDeferrable[ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)] = {1u << EVENT_SIG_2};
+const TSignalFilter filter = {.accepted = &filterAccepted[0][0], .deferrable = filterDeferrable,
+                              .statesMax = STATES_MAX, .eventsMax = EVENTS_MAX};
+
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+void test_signalFilter_RejectsAndDefers(void) {
+    TEvent eventArray[QUEUE_MAX_SIZE];
+    TEvent deferredEventArray[QUEUE_MAX_SIZE];
+    TActiveObject activeObject;
+    ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, QUEUE_MAX_SIZE);
+    ActiveObject_InitializeDeferredQueue(&activeObject, deferredEventArray, QUEUE_MAX_SIZE);
+    TEST_ASSERT_TRUE(ActiveObject_SetSignalFilter(&activeObject, &filter));
+
+    // No state yet, every signal passes
+    TEST_ASSERT_TRUE(ActiveObject_Dispatch(&activeObject, EVENT_MAKE(EVENT_SIG_3, NULL, 0)));
+    ActiveObject_ProcessQueue(&activeObject);
+
+    activeObject.state = &filterStates[STATE_1];
+
+    TEST_ASSERT_TRUE(ActiveObject_Dispatch(&activeObject, EVENT_MAKE(EVENT_SIG_1, NULL, 0)));
+    TEST_ASSERT_FALSE(ActiveObject_Dispatch(&activeObject, EVENT_MAKE(EVENT_SIG_3, NULL, 0)));
+    TEST_ASSERT_TRUE(ActiveObject_Dispatch(&activeObject, EVENT_MAKE(EVENT_SIG_2, NULL, 0)));
+
+    TEST_ASSERT_EQUAL_UINT32(1, activeObject.rejectedCount);
+    TEST_ASSERT_EQUAL_UINT32(1, EventQueue_GetSize(&activeObject.queue));
+    TEST_ASSERT_EQUAL(EVENT_SIG_2, EventQueue_Peek(&activeObject.deferredQueue).sig);
+
+    // Out of the filter signals pass
+    TEST_ASSERT_TRUE(ActiveObject_Dispatch(&activeObject, EVENT_MAKE(EVENTS_MAX, NULL, 0)));
+}
+
+void test_signalFilter_DeferrableWithoutDeferredQueue(void) {
+    TEvent eventArray[QUEUE_MAX_SIZE];
+    TActiveObject activeObject;
+    ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, QUEUE_MAX_SIZE);
+    ActiveObject_SetSignalFilter(&activeObject, &filter);
+    activeObject.state = &filterStates[STATE_1];
+
+    TEST_ASSERT_FALSE(ActiveObject_Dispatch(&activeObject, EVENT_MAKE(EVENT_SIG_2, NULL, 0)));
+    TEST_ASSERT_EQUAL_UINT32(1, activeObject.rejectedCount);
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&activeObject.queue));
+}
+
+void test_signalFilter_DispatchBulk(void) {
+    TEvent eventArray[2];
+    TActiveObject activeObject;
+    TEvent events[4] = {EVENT_MAKE(EVENT_SIG_1, NULL, 0), EVENT_MAKE(EVENT_SIG_3, NULL, 0),
+                        EVENT_MAKE(EVENT_SIG_1, NULL, 0), EVENT_MAKE(EVENT_SIG_1, NULL, 0)};
+    ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, 2);
+    ActiveObject_SetSignalFilter(&activeObject, &filter);
+    activeObject.state = &filterStates[STATE_1];
+
+    // Rejected event is taken, the full queue stops the bulk
+    TEST_ASSERT_EQUAL_UINT32(3, ActiveObject_DispatchBulk(&activeObject, events, 4));
+    TEST_ASSERT_EQUAL_UINT32(1, activeObject.rejectedCount);
+    TEST_ASSERT_TRUE(EventQueue_IsFull(&activeObject.queue));
+}
+#else
+void test_signalFilter_Disabled(void) {
+    TEvent eventArray[QUEUE_MAX_SIZE];
+    TActiveObject activeObject;
+    ActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, eventArray, QUEUE_MAX_SIZE);
+
+    TEST_ASSERT_FALSE(ActiveObject_SetSignalFilter(&activeObject, &filter));
+    TEST_ASSERT_TRUE(ActiveObject_SetSignalFilter(&activeObject, NULL));
+}
+#endif
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_initializeActiveObject);
     RUN_TEST(test_dispatchEvent);
     RUN_TEST(test_processQueue_WithEvent);
     RUN_TEST(test_processQueue_EmptyQueue);
+    RUN_TEST(test_defer_NoDeferredQueue);
+    RUN_TEST(test_defer_RecallOne);
+    RUN_TEST(test_defer_RecallAll);
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+    RUN_TEST(test_signalFilter_RejectsAndDefers);
+    RUN_TEST(test_signalFilter_DeferrableWithoutDeferredQueue);
+    RUN_TEST(test_signalFilter_DispatchBulk);
+#else
+    RUN_TEST(test_signalFilter_Disabled);
+#endif
     return UNITY_END();
 }
 
@@ -0,0 +1,100 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object_impl.h"
+#include "../../src/fsm/fsm_impl.h"
+
+#define TEST_AO TEST_AO
+#define QUEUE_MAX_SIZE 4
+#define ACTIVE_OBJECT_ID 3
+
+typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENT_SIG_2 = 2, SIG_MAX } TEST_EVENT_SIG; // event signals names
+typedef enum { NO_STATE, STATE_1 = 1, STATE_2 = 2, STATES_MAX } TEST_STATE; // state names
+
+typedef struct {
+    TEST_EVENT_SIG sig;
+    uint8_t value;
+} TTestEvent;
+
+typedef struct {
+    uint8_t lastValue;
+} TTestFields;
+
+DECLARE_ACTIVE_OBJECT(TEST_AO, TTestEvent, TEST_STATE, TTestFields, QUEUE_MAX_SIZE);
+ACTIVE_OBJECT_IMPLEMENTATION(TEST_AO, TTestEvent, TEST_STATE, TTestFields, QUEUE_MAX_SIZE);
+DECLARE_FSM(TEST_AO, TTestEvent, TEST_STATE, SIG_MAX, STATES_MAX);
+FSM_IMPLEMENTATION(TEST_AO, TTestEvent, TEST_STATE, SIG_MAX, STATES_MAX);
+
+TEST_STATE _goToState1(TEST_AO *const activeObject, TTestEvent event) {
+    activeObject->fields.lastValue = event.value;
+    return STATE_1;
+};
+
+TEST_STATE _goToState2(TEST_AO *const activeObject, TTestEvent event) { return STATE_2; };
+
+bool _isValueSet(TEST_AO *const activeObject, TTestEvent event) { return 0 != event.value; };
+
+DECLARE_TYPED_GUARD(TEST_AO, TTestEvent, _isValueSet, _goToState1, _goToState2);
+
+const TTestEvent_HANDLE_F transitionTable[STATES_MAX][SIG_MAX] = {
+    [NO_STATE]  = { [EVENT_SIG_1] = _goToState1 },
+    [STATE_1]   = { [EVENT_SIG_2] = GUARD(_isValueSet, _goToState1, _goToState2) },
+};
+
+TEST_AO activeObject;
+
+TEST_STATE _processEventToNextState(TEST_AO *const activeObject, TTestEvent event) {
+    return TEST_AO_FSM_ProcessEventToNextStateFromTransitionTable(activeObject, event, transitionTable);
+}
+
+void setUp(void) {
+    TEST_AO_Ctor(&activeObject, ACTIVE_OBJECT_ID, NO_STATE, (TTestFields){.lastValue = 0});
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Ctor(void) {
+    TEST_ASSERT_EQUAL_UINT32(ACTIVE_OBJECT_ID, activeObject.id);
+    TEST_ASSERT_EQUAL(NO_STATE, activeObject.state);
+    TEST_ASSERT_TRUE(TEST_AO_QUEUE_IsEmpty(&activeObject.queue));
+    TEST_ASSERT_EQUAL_size_t(sizeof(TTestEvent) * QUEUE_MAX_SIZE, sizeof(activeObject.queue.events));
+}
+
+void test_Dispatch_QueueFull(void) {
+    for (uint8_t i = 0; i < QUEUE_MAX_SIZE; i++) {
+        TEST_ASSERT_TRUE(TEST_AO_Dispatch(&activeObject, (TTestEvent){.sig = EVENT_SIG_1, .value = i}));
+    }
+
+    TEST_ASSERT_TRUE(TEST_AO_QUEUE_IsFull(&activeObject.queue));
+    TEST_ASSERT_FALSE(TEST_AO_Dispatch(&activeObject, (TTestEvent){.sig = EVENT_SIG_1}));
+}
+
+void test_ProcessQueue_TransitionsThroughTable(void) {
+    TEST_AO_Dispatch(&activeObject, (TTestEvent){.sig = EVENT_SIG_1, .value = 7});
+    TEST_AO_Dispatch(&activeObject, (TTestEvent){.sig = EVENT_SIG_2, .value = 0});
+
+    TEST_ASSERT_TRUE(TEST_AO_ProcessQueue(&activeObject, _processEventToNextState, TEST_AO_basicTransitionToNextState, NULL));
+    TEST_ASSERT_EQUAL(STATE_1, activeObject.state);
+    TEST_ASSERT_EQUAL_UINT8(7, activeObject.fields.lastValue);
+
+    TEST_ASSERT_TRUE(TEST_AO_ProcessQueue(&activeObject, _processEventToNextState, TEST_AO_basicTransitionToNextState, NULL));
+    TEST_ASSERT_EQUAL(STATE_2, activeObject.state);
+
+    TEST_ASSERT_FALSE(TEST_AO_ProcessQueue(&activeObject, _processEventToNextState, TEST_AO_basicTransitionToNextState, NULL));
+}
+
+void test_FSM_ProcessEvent_NoHandler_KeepsState(void) {
+    activeObject.state = STATE_2;
+
+    TEST_ASSERT_EQUAL(STATE_2, _processEventToNextState(&activeObject, (TTestEvent){.sig = EVENT_SIG_1}));
+    TEST_ASSERT_EQUAL(STATE_2, _processEventToNextState(&activeObject, (TTestEvent){.sig = SIG_MAX}));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Ctor);
+    RUN_TEST(test_Dispatch_QueueFull);
+    RUN_TEST(test_ProcessQueue_TransitionsThroughTable);
+    RUN_TEST(test_FSM_ProcessEvent_NoHandler_KeepsState);
+    return UNITY_END();
+}
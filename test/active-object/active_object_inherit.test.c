@@ -20,12 +20,6 @@ typedef enum {
     STATES_MAX,
 } TEST_STATE;
 
-typedef struct TTestEvent {
-    TEST_EVENT_SIG sig;
-    void* payload;
-    size_t size;
-} TTestEvent;
-
 /** @extends TActiveObject */
 typedef struct {
     TActiveObject super;
@@ -36,8 +30,8 @@ TState statesList[STATES_MAX] = {   [STATE_1] = {.name = STATE_1, .onEnter = NUL
                                     [STATE_2] = {.name = STATE_2, .onEnter = NULL, .onTraverse = NULL, .onExit = NULL},
                                     [STATE_3] = {.name = STATE_3, .onEnter = NULL, .onTraverse = NULL, .onExit = NULL}};
 
-void TSubActiveObject_Initialize(TSubActiveObject* me, const uint8_t id, TTestEvent* events, uint32_t capacity) {
-    ActiveObject_Initialize(&(me->super), id, (TEvent*)events, capacity);
+void TSubActiveObject_Initialize(TSubActiveObject* me, const uint8_t id, TEvent* events, uint32_t capacity) {
+    ActiveObject_Initialize(&(me->super), id, events, capacity);
     me->additionalField = false;
 }                                   
 
@@ -50,7 +44,7 @@ void tearDown(void) {
 }
 
 void test_initializeActiveObject(void) {
-    TTestEvent events[QUEUE_MAX_SIZE];
+    TEvent events[QUEUE_MAX_SIZE];
     TSubActiveObject subActiveObject;
     TSubActiveObject_Initialize(&subActiveObject, ACTIVE_OBJECT_ID, events, QUEUE_MAX_SIZE);
     
@@ -60,27 +54,27 @@ void test_initializeActiveObject(void) {
 }
 
 void test_dispatchEvent(void) {
-    TTestEvent events[QUEUE_MAX_SIZE];
+    TEvent events[QUEUE_MAX_SIZE];
     TSubActiveObject subActiveObject;
     TSubActiveObject_Initialize(&subActiveObject, ACTIVE_OBJECT_ID, events, QUEUE_MAX_SIZE);
     
-    ActiveObject_Dispatch(&subActiveObject.super, (TEvent){EVENT_SIG_1, NULL, 0});
+    ActiveObject_Dispatch(&subActiveObject.super, EVENT_MAKE(EVENT_SIG_1, NULL, 0));
 
     TEST_ASSERT_FALSE(EventQueue_IsEmpty(&subActiveObject.super.queue));
 }
 
 void test_processQueue_WithEvent(void) {
-    TTestEvent events[QUEUE_MAX_SIZE];
+    TEvent events[QUEUE_MAX_SIZE];
     TSubActiveObject subActiveObject;
     TSubActiveObject_Initialize(&subActiveObject, ACTIVE_OBJECT_ID, events, QUEUE_MAX_SIZE);
     
-    ActiveObject_Dispatch(&subActiveObject.super, (TEvent){EVENT_SIG_1, NULL, 0});
+    ActiveObject_Dispatch(&subActiveObject.super, EVENT_MAKE(EVENT_SIG_1, NULL, 0));
     TEvent processedEvent = ActiveObject_ProcessQueue(&subActiveObject.super);
     TEST_ASSERT_EQUAL(EVENT_SIG_1, processedEvent.sig);
 }
 
 void test_setActiveObjectState(void) {
-    TTestEvent events[QUEUE_MAX_SIZE];
+    TEvent events[QUEUE_MAX_SIZE];
     TSubActiveObject subActiveObject;
     TSubActiveObject_Initialize(&subActiveObject, ACTIVE_OBJECT_ID, events, QUEUE_MAX_SIZE);
     
@@ -0,0 +1,105 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/active_object_pool/active_object_pool.h"
+
+#define QUEUE_MAX_SIZE 4
+#define BLOCKS_MAX 3
+
+typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+
+/** @extends TActiveObject */
+typedef struct {
+    TActiveObject super;
+    uint32_t retries;
+} TSubActiveObject;
+
+TActiveObjectPoolUnit storage[ACTIVE_OBJECT_POOL_STORAGE_UNITS(TSubActiveObject, QUEUE_MAX_SIZE, BLOCKS_MAX)];
+TActiveObjectPool pool;
+
+void setUp(void) {
+    ActiveObjectPool_Initialize(&pool, storage, sizeof(storage), sizeof(TSubActiveObject), QUEUE_MAX_SIZE);
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_ActiveObjectPool_Initialize(void) {
+    TEST_ASSERT_EQUAL_UINT32(BLOCKS_MAX, pool.blocksCount);
+    TEST_ASSERT_EQUAL_UINT32(BLOCKS_MAX, pool.freeCount);
+    TEST_ASSERT_FALSE(ActiveObjectPool_Initialize(&pool, storage, sizeof(storage), sizeof(uint8_t), QUEUE_MAX_SIZE));
+}
+
+void test_ActiveObjectPool_Allocate_CoLocatesQueue(void) {
+    TSubActiveObject *subActiveObject = (TSubActiveObject *) ActiveObjectPool_Allocate(&pool, 7);
+
+    TEST_ASSERT_NOT_NULL(subActiveObject);
+    TEST_ASSERT_EQUAL_UINT32(7, subActiveObject->super.id);
+    TEST_ASSERT_EQUAL_UINT32(0, subActiveObject->retries);
+    TEST_ASSERT_NULL(subActiveObject->super.state);
+    TEST_ASSERT_EQUAL_PTR((uint8_t *) subActiveObject + pool.eventsOffset, subActiveObject->super.queue.events);
+    TEST_ASSERT_EQUAL_UINT32(QUEUE_MAX_SIZE, subActiveObject->super.queue.capacity);
+
+    TEST_ASSERT_TRUE(ActiveObject_Dispatch(&subActiveObject->super, (TEvent){.sig = EVENT_SIG_1}));
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, ActiveObject_ProcessQueue(&subActiveObject->super).sig);
+}
+
+void test_ActiveObjectPool_Allocate_Exhausted(void) {
+    for (uint32_t i = 0; i < BLOCKS_MAX; i++) {
+        TEST_ASSERT_NOT_NULL(ActiveObjectPool_Allocate(&pool, i));
+    }
+
+    TEST_ASSERT_NULL(ActiveObjectPool_Allocate(&pool, BLOCKS_MAX));
+    TEST_ASSERT_EQUAL_UINT32(0, pool.freeCount);
+}
+
+void test_ActiveObjectPool_Release_Recycles(void) {
+    TActiveObject *activeObject = ActiveObjectPool_Allocate(&pool, 1);
+    ((TSubActiveObject *) activeObject)->retries = 3;
+
+    TEST_ASSERT_TRUE(ActiveObjectPool_Release(&pool, activeObject));
+    TEST_ASSERT_EQUAL_UINT32(BLOCKS_MAX, pool.freeCount);
+
+    TActiveObject *recycled = ActiveObjectPool_Allocate(&pool, 2);
+
+    TEST_ASSERT_EQUAL_PTR(activeObject, recycled);
+    TEST_ASSERT_EQUAL_UINT32(0, ((TSubActiveObject *) recycled)->retries);
+}
+
+void test_ActiveObjectPool_Release_Twice(void) {
+    TActiveObject *activeObject = ActiveObjectPool_Allocate(&pool, 1);
+
+    TEST_ASSERT_TRUE(ActiveObjectPool_Release(&pool, activeObject));
+    TEST_ASSERT_FALSE(ActiveObjectPool_Release(&pool, activeObject));
+    TEST_ASSERT_EQUAL_UINT32(BLOCKS_MAX, pool.freeCount);
+
+    // The free list holds every block once
+    TActiveObject *first = ActiveObjectPool_Allocate(&pool, 2);
+    TActiveObject *second = ActiveObjectPool_Allocate(&pool, 3);
+
+    TEST_ASSERT_NOT_EQUAL(first, second);
+    TEST_ASSERT_TRUE(ActiveObjectPool_Release(&pool, first));
+}
+
+void test_ActiveObjectPool_Release_ForeignObject(void) {
+    TEvent events[QUEUE_MAX_SIZE];
+    TActiveObject foreign;
+    ActiveObject_Initialize(&foreign, 1, events, QUEUE_MAX_SIZE);
+
+    TActiveObject *activeObject = ActiveObjectPool_Allocate(&pool, 1);
+
+    TEST_ASSERT_FALSE(ActiveObjectPool_Release(&pool, &foreign));
+    TEST_ASSERT_FALSE(ActiveObjectPool_Release(&pool, (TActiveObject *) ((uint8_t *) activeObject + sizeof(TActiveObjectPoolUnit))));
+    TEST_ASSERT_EQUAL_UINT32(BLOCKS_MAX - 1, pool.freeCount);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ActiveObjectPool_Initialize);
+    RUN_TEST(test_ActiveObjectPool_Allocate_CoLocatesQueue);
+    RUN_TEST(test_ActiveObjectPool_Allocate_Exhausted);
+    RUN_TEST(test_ActiveObjectPool_Release_Recycles);
+    RUN_TEST(test_ActiveObjectPool_Release_Twice);
+    RUN_TEST(test_ActiveObjectPool_Release_ForeignObject);
+    return UNITY_END();
+}
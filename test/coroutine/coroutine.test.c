@@ -0,0 +1,159 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/fsm/fsm.h"
+#include "../../src/coroutine/coroutine.h"
+
+#define QUEUE_MAX_SIZE 4
+#define RETRIES_MAX 2
+
+typedef enum {
+    NO_SIG,
+    CONNECT_SIG,
+    HELLO_ACK_SIG,
+    CONFIG_ACK_SIG,
+    TIMEOUT_SIG,
+    DISCONNECT_SIG,
+    EVENTS_MAX
+} TEST_EVENT_SIG; // event signals names
+
+typedef enum { NO_STATE, LINK_IDLE_ST, LINK_CONNECTING_ST, LINK_UP_ST, LINK_ERROR_ST, STATES_MAX } TEST_STATE_NAME;
+
+typedef struct {
+    TActiveObject super;
+    uint32_t retries;
+    uint32_t hellosCount;
+    uint32_t configsCount;
+} TLink;
+
+const TState *handshake(TActiveObject *const activeObject, TEvent event);
+const TState *connect(TActiveObject *const activeObject, TEvent event);
+const TState *disconnect(TActiveObject *const activeObject, TEvent event);
+
+const TState statesList[STATES_MAX] = {
+        [NO_STATE] = EMPTY_STATE,
+        [LINK_IDLE_ST] = {.name = LINK_IDLE_ST},
+        [LINK_CONNECTING_ST] = {.name = LINK_CONNECTING_ST},
+        [LINK_UP_ST] = {.name = LINK_UP_ST},
+        [LINK_ERROR_ST] = {.name = LINK_ERROR_ST},
+};
+
+const TEventHandler transitionTable[STATES_MAX][EVENTS_MAX] = {
+        [LINK_IDLE_ST] = {[CONNECT_SIG] = connect},
+        [LINK_CONNECTING_ST] = {[CONNECT_SIG] = handshake, [HELLO_ACK_SIG] = handshake, [CONFIG_ACK_SIG] = handshake,
+                                [TIMEOUT_SIG] = handshake, [DISCONNECT_SIG] = disconnect},
+};
+
+TEvent eventArray[QUEUE_MAX_SIZE];
+TLink link;
+
+const TState *handshake(TActiveObject *const activeObject, TEvent event) {
+    TLink *me = (TLink *) activeObject;
+
+    CO_BEGIN(activeObject);
+    for (me->retries = 0; me->retries < RETRIES_MAX; me->retries++) {
+        me->hellosCount++;
+        CO_AWAIT_UNTIL(activeObject, HELLO_ACK_SIG == event.sig || TIMEOUT_SIG == event.sig);
+        if (HELLO_ACK_SIG == event.sig) break;
+    }
+    if (me->retries == RETRIES_MAX) CO_EXIT(activeObject, &statesList[LINK_ERROR_ST]);
+
+    me->configsCount++;
+    CO_AWAIT(activeObject, event, CONFIG_ACK_SIG);
+    CO_EXIT(activeObject, &statesList[LINK_UP_ST]);
+    CO_END(activeObject);
+}
+
+const TState *connect(TActiveObject *const activeObject, TEvent event) {
+    ActiveObject_Dispatch(activeObject, event); // the handshake starts with the same event
+    return &statesList[LINK_CONNECTING_ST];
+}
+
+const TState *disconnect(TActiveObject *const activeObject, TEvent event) {
+    return &statesList[LINK_IDLE_ST];
+}
+
+static void processEvent(int sig) {
+    TActiveObject *activeObject = &link.super;
+
+    ActiveObject_Dispatch(activeObject, (TEvent) {.sig = sig});
+
+    while (!EventQueue_IsEmpty(&activeObject->queue)) {
+        TEvent event = ActiveObject_ProcessQueue(activeObject);
+        const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(
+                activeObject, event, STATES_MAX, EVENTS_MAX, transitionTable);
+
+        if (FSM_IsValidState(nextState)) FSM_TraverseAOToNextState(activeObject, nextState);
+    }
+}
+
+void setUp(void) {
+    ActiveObject_Initialize(&link.super, 0, eventArray, QUEUE_MAX_SIZE);
+    link.super.state = &statesList[LINK_IDLE_ST];
+    link.retries = link.hellosCount = link.configsCount = 0;
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Coroutine_Handshake_InSingleState(void) {
+    processEvent(CONNECT_SIG);
+
+    TEST_ASSERT_EQUAL_INT(LINK_CONNECTING_ST, link.super.state->name);
+    TEST_ASSERT_TRUE(CO_IS_RUNNING(&link.super));
+    TEST_ASSERT_EQUAL_UINT32(1, link.hellosCount);
+
+    processEvent(HELLO_ACK_SIG);
+
+    TEST_ASSERT_EQUAL_INT(LINK_CONNECTING_ST, link.super.state->name);
+    TEST_ASSERT_EQUAL_UINT32(1, link.configsCount);
+
+    processEvent(CONFIG_ACK_SIG);
+
+    TEST_ASSERT_EQUAL_INT(LINK_UP_ST, link.super.state->name);
+    TEST_ASSERT_FALSE(CO_IS_RUNNING(&link.super));
+}
+
+void test_Coroutine_Await_IgnoresOtherSignals(void) {
+    processEvent(CONNECT_SIG);
+    processEvent(CONFIG_ACK_SIG);
+    processEvent(CONNECT_SIG);
+
+    TEST_ASSERT_EQUAL_INT(LINK_CONNECTING_ST, link.super.state->name);
+    TEST_ASSERT_EQUAL_UINT32(1, link.hellosCount);
+    TEST_ASSERT_EQUAL_UINT32(0, link.configsCount);
+}
+
+void test_Coroutine_Retries_ExitToError(void) {
+    processEvent(CONNECT_SIG);
+
+    for (uint32_t i = 0; i < RETRIES_MAX; i++) processEvent(TIMEOUT_SIG);
+
+    TEST_ASSERT_EQUAL_UINT32(RETRIES_MAX, link.hellosCount);
+    TEST_ASSERT_EQUAL_INT(LINK_ERROR_ST, link.super.state->name);
+    TEST_ASSERT_FALSE(CO_IS_RUNNING(&link.super));
+}
+
+void test_Coroutine_LeavingState_RestartsFlow(void) {
+    processEvent(CONNECT_SIG);
+    processEvent(HELLO_ACK_SIG);
+    processEvent(DISCONNECT_SIG);
+
+    TEST_ASSERT_EQUAL_INT(LINK_IDLE_ST, link.super.state->name);
+    TEST_ASSERT_FALSE(CO_IS_RUNNING(&link.super));
+
+    // Back in the state the flow starts over with a new hello
+    processEvent(CONNECT_SIG);
+
+    TEST_ASSERT_EQUAL_UINT32(2, link.hellosCount);
+    TEST_ASSERT_EQUAL_UINT32(1, link.configsCount);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Coroutine_Handshake_InSingleState);
+    RUN_TEST(test_Coroutine_Await_IgnoresOtherSignals);
+    RUN_TEST(test_Coroutine_Retries_ExitToError);
+    RUN_TEST(test_Coroutine_LeavingState_RestartsFlow);
+    return UNITY_END();
+}
@@ -0,0 +1,100 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/dispatch_stage/dispatch_stage.h"
+
+#define QUEUE_MAX_SIZE 4
+#define STAGE_CAPACITY 4
+
+typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENT_SIG_2 = 2, EVENT_SIG_3 = 3, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+
+TEvent eventsA[QUEUE_MAX_SIZE];
+TEvent eventsB[QUEUE_MAX_SIZE];
+TActiveObject activeObjectA;
+TActiveObject activeObjectB;
+
+TDispatchStageEntry entries[STAGE_CAPACITY];
+TEvent scratch[STAGE_CAPACITY];
+TDispatchStage stage;
+
+void setUp(void) {
+    ActiveObject_Initialize(&activeObjectA, 1, eventsA, QUEUE_MAX_SIZE);
+    ActiveObject_Initialize(&activeObjectB, 2, eventsB, QUEUE_MAX_SIZE);
+    DispatchStage_Initialize(&stage, entries, scratch, STAGE_CAPACITY);
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_DispatchStage_Flush_KeepsOrderPerDestination(void) {
+    DispatchStage_Dispatch(&stage, &activeObjectA, (TEvent){.sig = EVENT_SIG_1});
+    DispatchStage_Dispatch(&stage, &activeObjectB, (TEvent){.sig = EVENT_SIG_2});
+    DispatchStage_Dispatch(&stage, &activeObjectA, (TEvent){.sig = EVENT_SIG_3});
+
+    // Nothing is delivered until the flush
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&activeObjectA.queue));
+
+    TEST_ASSERT_EQUAL_UINT32(3, DispatchStage_Flush(&stage));
+    TEST_ASSERT_EQUAL_UINT32(0, stage.count);
+
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, ActiveObject_ProcessQueue(&activeObjectA).sig);
+    TEST_ASSERT_EQUAL(EVENT_SIG_3, ActiveObject_ProcessQueue(&activeObjectA).sig);
+    TEST_ASSERT_EQUAL(EVENT_SIG_2, ActiveObject_ProcessQueue(&activeObjectB).sig);
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&activeObjectB.queue));
+}
+
+void test_DispatchStage_Dispatch_FlushesWhenFull(void) {
+    for (int i = 0; i < STAGE_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(DispatchStage_Dispatch(&stage, &activeObjectA, (TEvent){.sig = EVENT_SIG_1}));
+    }
+
+    TEST_ASSERT_TRUE(DispatchStage_Dispatch(&stage, &activeObjectB, (TEvent){.sig = EVENT_SIG_2}));
+    TEST_ASSERT_EQUAL_UINT32(QUEUE_MAX_SIZE, EventQueue_GetSize(&activeObjectA.queue));
+    TEST_ASSERT_EQUAL_UINT32(1, stage.count);
+    TEST_ASSERT_FALSE(DispatchStage_Dispatch(&stage, NULL, (TEvent){.sig = EVENT_SIG_2}));
+}
+
+void test_DispatchStage_Flush_CountsDrops(void) {
+    ActiveObject_Dispatch(&activeObjectA, (TEvent){.sig = EVENT_SIG_1});
+    ActiveObject_Dispatch(&activeObjectA, (TEvent){.sig = EVENT_SIG_1});
+
+    for (int i = 0; i < STAGE_CAPACITY; i++) {
+        DispatchStage_Dispatch(&stage, &activeObjectA, (TEvent){.sig = EVENT_SIG_2});
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(2, DispatchStage_Flush(&stage));
+    TEST_ASSERT_EQUAL_UINT32(2, stage.droppedCount);
+    TEST_ASSERT_TRUE(EventQueue_IsFull(&activeObjectA.queue));
+}
+
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+// STATE_1 handles EVENT_SIG_1 only
+const TState states[2] = {{.name = 0}, {.name = 1}};
+const TSignalMask accepted[2][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)] = {[1] = {1u << EVENT_SIG_1}};
+const TSignalFilter filter = {.accepted = &accepted[0][0], .statesMax = 2, .eventsMax = EVENTS_MAX};
+
+void test_DispatchStage_Flush_CountsRejects(void) {
+    ActiveObject_SetSignalFilter(&activeObjectA, &filter);
+    activeObjectA.state = &states[1];
+
+    DispatchStage_Dispatch(&stage, &activeObjectA, (TEvent){.sig = EVENT_SIG_1});
+    DispatchStage_Dispatch(&stage, &activeObjectA, (TEvent){.sig = EVENT_SIG_2});
+    DispatchStage_Dispatch(&stage, &activeObjectB, (TEvent){.sig = EVENT_SIG_2});
+
+    TEST_ASSERT_EQUAL_UINT32(2, DispatchStage_Flush(&stage));
+    TEST_ASSERT_EQUAL_UINT32(1, stage.rejectedCount);
+    TEST_ASSERT_EQUAL_UINT32(0, stage.droppedCount);
+    TEST_ASSERT_EQUAL_UINT32(1, EventQueue_GetSize(&activeObjectA.queue));
+}
+#endif
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_DispatchStage_Flush_KeepsOrderPerDestination);
+    RUN_TEST(test_DispatchStage_Dispatch_FlushesWhenFull);
+    RUN_TEST(test_DispatchStage_Flush_CountsDrops);
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+    RUN_TEST(test_DispatchStage_Flush_CountsRejects);
+#endif
+    return UNITY_END();
+}
@@ -9,17 +9,11 @@ typedef enum {
     TEST_SIG_3 = 3,
 } TEST_SIG;
 
-typedef struct {
-    TEST_SIG sig;
-    void* payload;
-    size_t size;
-} TTestEvent;
-
-TTestEvent events[QUEUE_MAX_CAPACITY];
+TEvent events[QUEUE_MAX_CAPACITY];
 TEventQueue queue;
 
 void setUp(void) {
-    EventQueue_Initialize(&queue, (TEvent*)&events, QUEUE_MAX_CAPACITY);
+    EventQueue_Initialize(&queue, events, QUEUE_MAX_CAPACITY);
 }
 
 void tearDown(void) {
@@ -32,7 +26,7 @@ void test_EventQueue_Initialize(void) {
 }
 
 void test_EventQueue_Enqueue(void) {
-    TEvent event = {TEST_SIG_1, NULL, 0};
+    TEvent event = EVENT_MAKE(TEST_SIG_1, NULL, 0);
     bool enqueueResult = EventQueue_Enqueue(&queue, event);
 
     TEST_ASSERT_TRUE(enqueueResult);
@@ -42,13 +36,13 @@ void test_EventQueue_Enqueue(void) {
 void test_EventQueue_Enqueue_FullQueue(void) {
     // Fill the queue to its capacity
     for (int i = 0; i < QUEUE_MAX_CAPACITY; ++i) {
-        TEvent event = {i, NULL, 0};
+        TEvent event = EVENT_MAKE(i, NULL, 0);
         bool enqueueResult = EventQueue_Enqueue(&queue, event);
         TEST_ASSERT_TRUE(enqueueResult);
     }
 
     // Try to enqueue one more event
-    TEvent extraEvent = {TEST_SIG_1, NULL, 0};
+    TEvent extraEvent = EVENT_MAKE(TEST_SIG_1, NULL, 0);
     bool enqueueResult = EventQueue_Enqueue(&queue, extraEvent);
 
     // Check that enqueueResult is false, indicating that the queue is full
@@ -57,7 +51,7 @@ void test_EventQueue_Enqueue_FullQueue(void) {
 
 
 void test_EventQueue_Dequeue(void) {
-    TEvent event = {TEST_SIG_1, NULL, 0};
+    TEvent event = EVENT_MAKE(TEST_SIG_1, NULL, 0);
     EventQueue_Enqueue(&queue, event);
 
     TEvent dequeuedEvent = EventQueue_Dequeue(&queue);
@@ -81,7 +75,7 @@ void test_EventQueue_Dequeue_EmptyQueue(void) {
 
 void test_EventQueue_Dequeue_FrontEqualsRear(void) {
     // Enqueue an event
-    TEvent event = {TEST_SIG_1, NULL, 0};
+    TEvent event = EVENT_MAKE(TEST_SIG_1, NULL, 0);
     EventQueue_Enqueue(&queue, event);
 
     // Dequeue the event, causing front and rear to become equal
@@ -94,8 +88,8 @@ void test_EventQueue_Dequeue_FrontEqualsRear(void) {
 
 void test_EventQueue_Dequeue_FrontNotEqualsRear(void) {
     // Enqueue two events
-    TEvent event1 = {TEST_SIG_1, NULL, 0};
-    TEvent event2 = {TEST_SIG_2, NULL, 0};
+    TEvent event1 = EVENT_MAKE(TEST_SIG_1, NULL, 0);
+    TEvent event2 = EVENT_MAKE(TEST_SIG_2, NULL, 0);
     EventQueue_Enqueue(&queue, event1);
     EventQueue_Enqueue(&queue, event2);
 
@@ -108,7 +102,7 @@ void test_EventQueue_Dequeue_FrontNotEqualsRear(void) {
 }
 
 void test_EventQueue_Peek(void) {
-    TEvent event = {TEST_SIG_1, NULL, 0};
+    TEvent event = EVENT_MAKE(TEST_SIG_1, NULL, 0);
     EventQueue_Enqueue(&queue, event);
 
     TEvent peekedEvent = EventQueue_Peek(&queue);
@@ -136,7 +130,7 @@ void test_EventQueue_IsEmpty(void) {
 
 void test_EventQueue_IsFull(void) {
     for (int i = 0; i < QUEUE_MAX_CAPACITY; ++i) {
-        TEvent event = {i, NULL, 0};
+        TEvent event = EVENT_MAKE(i, NULL, 0);
         bool enqueueResult = EventQueue_Enqueue(&queue, event);
         TEST_ASSERT_TRUE(enqueueResult);
     }
@@ -144,6 +138,247 @@ void test_EventQueue_IsFull(void) {
     TEST_ASSERT_TRUE(EventQueue_IsFull(&queue));
 }
 
+void test_EventQueue_GetSize(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, EventQueue_GetSize(&queue));
+
+    for (int i = 0; i < QUEUE_MAX_CAPACITY; ++i) {
+        EventQueue_Enqueue(&queue, EVENT_MAKE(i, NULL, 0));
+    }
+    TEST_ASSERT_EQUAL_UINT32(QUEUE_MAX_CAPACITY, EventQueue_GetSize(&queue));
+
+    // Wrap around
+    EventQueue_Dequeue(&queue);
+    EventQueue_Dequeue(&queue);
+    EventQueue_Enqueue(&queue, EVENT_MAKE(TEST_SIG_1, NULL, 0));
+    TEST_ASSERT_EQUAL_UINT32(QUEUE_MAX_CAPACITY - 1, EventQueue_GetSize(&queue));
+}
+
+void test_EventQueue_MoveToFront(void) {
+    TEvent sourceEvents[4];
+    TEventQueue source;
+    EventQueue_Initialize(&source, sourceEvents, 4);
+
+    EventQueue_Enqueue(&queue, EVENT_MAKE(TEST_SIG_3, NULL, 0));
+    EventQueue_Enqueue(&source, EVENT_MAKE(TEST_SIG_1, NULL, 0));
+    EventQueue_Enqueue(&source, EVENT_MAKE(TEST_SIG_2, NULL, 0));
+
+    TEST_ASSERT_EQUAL_UINT32(2, EventQueue_MoveToFront(&queue, &source, 4));
+
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&source));
+    TEST_ASSERT_EQUAL_UINT32(3, EventQueue_GetSize(&queue));
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_1, EventQueue_Dequeue(&queue).sig);
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_2, EventQueue_Dequeue(&queue).sig);
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_3, EventQueue_Dequeue(&queue).sig);
+}
+
+void test_EventQueue_MoveToFront_LimitedByFreeSpace(void) {
+    TEvent sourceEvents[4];
+    TEventQueue source;
+    EventQueue_Initialize(&source, sourceEvents, 4);
+
+    for (int i = 0; i < QUEUE_MAX_CAPACITY - 1; ++i) {
+        EventQueue_Enqueue(&queue, EVENT_MAKE(TEST_SIG_3, NULL, 0));
+    }
+    EventQueue_Enqueue(&source, EVENT_MAKE(TEST_SIG_1, NULL, 0));
+    EventQueue_Enqueue(&source, EVENT_MAKE(TEST_SIG_2, NULL, 0));
+
+    TEST_ASSERT_EQUAL_UINT32(1, EventQueue_MoveToFront(&queue, &source, 2));
+
+    TEST_ASSERT_TRUE(EventQueue_IsFull(&queue));
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_1, EventQueue_Peek(&queue).sig);
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_2, EventQueue_Peek(&source).sig);
+}
+
+void test_EventQueue_EnqueueBulk_WrapsAndLimitedByFreeSpace(void) {
+    TEvent smallEvents[4];
+    TEventQueue small;
+    TEvent bulk[4] = {EVENT_MAKE(TEST_SIG_1, NULL, 0), EVENT_MAKE(TEST_SIG_2, NULL, 0), EVENT_MAKE(TEST_SIG_3, NULL, 0), EVENT_MAKE(TEST_SIG_1, NULL, 0)};
+
+    EventQueue_Initialize(&small, smallEvents, 4);
+    TEST_ASSERT_EQUAL_UINT32(3, EventQueue_EnqueueBulk(&small, bulk, 3));
+    EventQueue_Dequeue(&small);
+    EventQueue_Dequeue(&small);
+
+    // 1 event left, wraps around the end of the ring
+    TEST_ASSERT_EQUAL_UINT32(3, EventQueue_EnqueueBulk(&small, bulk, 4));
+    TEST_ASSERT_TRUE(EventQueue_IsFull(&small));
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_3, EventQueue_Dequeue(&small).sig);
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_1, EventQueue_Dequeue(&small).sig);
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_2, EventQueue_Dequeue(&small).sig);
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_3, EventQueue_Dequeue(&small).sig);
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&small));
+}
+
+// Rings pool for growable queue tests
+TEvent ringsPool[64];
+uint32_t ringsPoolUsed;
+uint32_t ringsReleased;
+
+TEvent* _allocateRing(uint32_t capacity, void* const ctx) {
+    if (ringsPoolUsed + capacity > 64) return NULL;
+
+    TEvent* ring = &ringsPool[ringsPoolUsed];
+    ringsPoolUsed += capacity;
+    return ring;
+}
+
+void _releaseRing(TEvent* events, uint32_t capacity, void* const ctx) { ringsReleased++; }
+
+void test_EventQueue_Growable_GrowsKeepingFifoAndShrinksWhenIdle(void) {
+    TEvent smallEvents[2];
+    TEventQueue growable;
+    TEventQueueGrowth growth;
+
+    ringsPoolUsed = ringsReleased = 0;
+    EventQueue_Initialize(&growable, smallEvents, 2);
+    EventQueue_SetGrowth(&growable, &growth, _allocateRing, _releaseRing, 16, NULL);
+
+    // 2 in the initial ring, 4 in the linked ring, 8 after migrating the linked ring
+    for (int i = 0; i < 7; ++i) {
+        TEST_ASSERT_TRUE(EventQueue_Enqueue(&growable, EVENT_MAKE(i, NULL, 0)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(7, EventQueue_GetSize(&growable));
+    TEST_ASSERT_EQUAL_UINT32(2, growable.capacity);
+    TEST_ASSERT_EQUAL_UINT32(8, growth.next.capacity);
+    TEST_ASSERT_EQUAL_UINT32(1, ringsReleased);
+
+    for (int i = 0; i < 7; ++i) {
+        TEST_ASSERT_EQUAL_INT(i, EventQueue_Dequeue(&growable).sig);
+    }
+
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&growable));
+    TEST_ASSERT_EQUAL_PTR(smallEvents, growable.events);
+    TEST_ASSERT_EQUAL_UINT32(2, growable.capacity);
+    TEST_ASSERT_EQUAL_UINT32(2, ringsReleased);
+}
+
+void test_EventQueue_Growable_FullAtMaxCapacity(void) {
+    TEvent smallEvents[2];
+    TEventQueue growable;
+    TEventQueueGrowth growth;
+
+    ringsPoolUsed = ringsReleased = 0;
+    EventQueue_Initialize(&growable, smallEvents, 2);
+    EventQueue_SetGrowth(&growable, &growth, _allocateRing, _releaseRing, 4, NULL);
+
+    for (int i = 0; i < 6; ++i) {
+        TEST_ASSERT_TRUE(EventQueue_Enqueue(&growable, EVENT_MAKE(i, NULL, 0)));
+    }
+
+    TEST_ASSERT_TRUE(EventQueue_IsFull(&growable));
+    TEST_ASSERT_FALSE(EventQueue_Enqueue(&growable, EVENT_MAKE(TEST_SIG_1, NULL, 0)));
+
+    // New events go to the linked ring while the initial one drains
+    EventQueue_Dequeue(&growable);
+    TEST_ASSERT_FALSE(EventQueue_Enqueue(&growable, EVENT_MAKE(TEST_SIG_1, NULL, 0)));
+    EventQueue_Dequeue(&growable);
+    TEST_ASSERT_EQUAL_UINT32(4, growable.capacity);
+    TEST_ASSERT_EQUAL_INT(2, EventQueue_Peek(&growable).sig);
+}
+
+void test_EventQueue_Growable_AllocationFailure(void) {
+    TEvent smallEvents[2];
+    TEventQueue growable;
+    TEventQueueGrowth growth;
+
+    ringsPoolUsed = 64;
+    EventQueue_Initialize(&growable, smallEvents, 2);
+    EventQueue_SetGrowth(&growable, &growth, _allocateRing, _releaseRing, 16, NULL);
+
+    EventQueue_Enqueue(&growable, EVENT_MAKE(TEST_SIG_1, NULL, 0));
+    EventQueue_Enqueue(&growable, EVENT_MAKE(TEST_SIG_2, NULL, 0));
+
+    TEST_ASSERT_FALSE(EventQueue_IsFull(&growable));
+    TEST_ASSERT_FALSE(EventQueue_Enqueue(&growable, EVENT_MAKE(TEST_SIG_3, NULL, 0)));
+    TEST_ASSERT_EQUAL_UINT32(2, EventQueue_GetSize(&growable));
+}
+
+void test_EventQueue_MoveToFront_GrowableSource(void) {
+    TEvent smallEvents[2];
+    TEventQueue growable;
+    TEventQueueGrowth growth;
+
+    ringsPoolUsed = ringsReleased = 0;
+    EventQueue_Initialize(&growable, smallEvents, 2);
+    EventQueue_SetGrowth(&growable, &growth, _allocateRing, _releaseRing, 16, NULL);
+
+    // 2 events in the initial ring, 3 in the linked ring
+    for (int i = 0; i < 5; ++i) {
+        EventQueue_Enqueue(&growable, EVENT_MAKE(TEST_SIG_1 + 10 + i, NULL, 0));
+    }
+    EventQueue_Enqueue(&queue, EVENT_MAKE(TEST_SIG_3, NULL, 0));
+
+    TEST_ASSERT_EQUAL_UINT32(5, EventQueue_MoveToFront(&queue, &growable, EventQueue_GetSize(&growable)));
+
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&growable));
+    TEST_ASSERT_EQUAL_PTR(smallEvents, growable.events);
+    TEST_ASSERT_EQUAL_UINT32(1, ringsReleased);
+    TEST_ASSERT_EQUAL_UINT32(6, EventQueue_GetSize(&queue));
+    for (int i = 0; i < 5; ++i) {
+        TEST_ASSERT_EQUAL_INT(TEST_SIG_1 + 10 + i, EventQueue_Dequeue(&queue).sig);
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_3, EventQueue_Dequeue(&queue).sig);
+}
+
+void test_EventQueue_PeekAt_GrowableAcrossRings(void) {
+    TEvent smallEvents[2];
+    TEventQueue growable;
+    TEventQueueGrowth growth;
+
+    ringsPoolUsed = ringsReleased = 0;
+    EventQueue_Initialize(&growable, smallEvents, 2);
+    EventQueue_SetGrowth(&growable, &growth, _allocateRing, _releaseRing, 8, NULL);
+
+    // 2 events in the initial ring, 3 in the linked ring
+    for (int i = 0; i < 5; ++i) {
+        EventQueue_Enqueue(&growable, EVENT_MAKE(TEST_SIG_1 + i, NULL, 0));
+    }
+    EventQueue_Dequeue(&growable);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        TEST_ASSERT_EQUAL_INT(TEST_SIG_2 + i, EventQueue_PeekAt(&growable, i).sig);
+    }
+    TEST_ASSERT_EQUAL_INT(0, EventQueue_PeekAt(&growable, 4).sig);
+    TEST_ASSERT_EQUAL_UINT32(4, EventQueue_GetSize(&growable));
+}
+
+void test_EventQueue_GetFreeSize(void) {
+    TEvent smallEvents[2];
+    TEventQueue growable;
+    TEventQueueGrowth growth;
+
+    TEST_ASSERT_EQUAL_UINT32(QUEUE_MAX_CAPACITY, EventQueue_GetFreeSize(&queue));
+    EventQueue_Enqueue(&queue, EVENT_MAKE(TEST_SIG_1, NULL, 0));
+    TEST_ASSERT_EQUAL_UINT32(QUEUE_MAX_CAPACITY - 1, EventQueue_GetFreeSize(&queue));
+
+    ringsPoolUsed = ringsReleased = 0;
+    EventQueue_Initialize(&growable, smallEvents, 2);
+    EventQueue_SetGrowth(&growable, &growth, _allocateRing, _releaseRing, 4, NULL);
+
+    // The initial ring, then a linked ring of the max capacity
+    TEST_ASSERT_EQUAL_UINT32(6, EventQueue_GetFreeSize(&growable));
+
+    for (int i = 0; i < 3; ++i) {
+        EventQueue_Enqueue(&growable, EVENT_MAKE(TEST_SIG_1, NULL, 0));
+    }
+
+    // Only the linked ring takes new events
+    TEST_ASSERT_EQUAL_UINT32(3, EventQueue_GetFreeSize(&growable));
+}
+
+void test_EventQueue_EventLayout(void) {
+    TEvent event = EVENT_MAKE(TEST_SIG_2, &queue, sizeof(queue));
+
+    TEST_ASSERT_EQUAL_INT(TEST_SIG_2, EVENT_SIG(event));
+    TEST_ASSERT_EQUAL_PTR(&queue, EVENT_PAYLOAD(event));
+    TEST_ASSERT_EQUAL_size_t(sizeof(queue), EVENT_SIZE(event));
+    TEST_ASSERT_EQUAL_INT(0, EVENT_SIG(EVENT_EMPTY));
+#if defined(EVENT_QUEUE_COMPACT_EVENT) && 8 == __SIZEOF_POINTER__
+    TEST_ASSERT_EQUAL_size_t(16, sizeof(TEvent));
+    TEST_ASSERT_EQUAL_size_t(16, __alignof__(TEvent));
+#endif
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_EventQueue_Initialize);
@@ -157,5 +392,16 @@ int main(void) {
     RUN_TEST(test_EventQueue_Peek_EmptyQueue);
     RUN_TEST(test_EventQueue_IsEmpty);
     RUN_TEST(test_EventQueue_IsFull);
+    RUN_TEST(test_EventQueue_GetSize);
+    RUN_TEST(test_EventQueue_MoveToFront);
+    RUN_TEST(test_EventQueue_MoveToFront_LimitedByFreeSpace);
+    RUN_TEST(test_EventQueue_EnqueueBulk_WrapsAndLimitedByFreeSpace);
+    RUN_TEST(test_EventQueue_Growable_GrowsKeepingFifoAndShrinksWhenIdle);
+    RUN_TEST(test_EventQueue_Growable_FullAtMaxCapacity);
+    RUN_TEST(test_EventQueue_Growable_AllocationFailure);
+    RUN_TEST(test_EventQueue_MoveToFront_GrowableSource);
+    RUN_TEST(test_EventQueue_PeekAt_GrowableAcrossRings);
+    RUN_TEST(test_EventQueue_GetFreeSize);
+    RUN_TEST(test_EventQueue_EventLayout);
     return UNITY_END();
 }
@@ -24,13 +24,25 @@ const TState* _goToFailureHooksState(TActiveObject *const activeObject, TEvent e
 
 bool _onTrue(TActiveObject *const activeObject, TEvent event) { return true; };
 
+bool _onFalse(TActiveObject *const activeObject, TEvent event) { return false; };
+bool _hasPayload(TActiveObject *const activeObject, TEvent event) { return NULL != event.payload; };
+
 DECLARE_GUARD(_onTrue, _goToFailureHooksState, _goToSuccessHooksState);
+DECLARE_GUARD_CHAIN(_failureGuardChain,
+    GUARD_CASE(_onFalse, _goToEmmptyHooksState)
+    GUARD_CASE(_hasPayload, _goToSuccessHooksState),
+    _goToFailureHooksState);
 
 const TEventHandler transitionTable[STATES_MAX][EVENTS_MAX] = {
     [NO_STATE]          = { [GO_EMPTY_HOOKS_ST] = _goToEmmptyHooksState },
     [EMPTY_HOOKS_ST]    = { [GO_SUCCESS_HOOKS_ST] = _goToSuccessHooksState },
     [SUCCESS_HOOKS_ST]  = { [GO_FAILURE_HOOKS_ST] = GUARD(_onTrue, _goToFailureHooksState, _goToSuccessHooksState) },
-    [FAILURE_HOOKS_ST]  = { [GO_SUCCESS_HOOKS_ST] = _goToSuccessHooksState },
+    [FAILURE_HOOKS_ST]  = { [GO_SUCCESS_HOOKS_ST] = _goToSuccessHooksState, [GO_FAILURE_HOOKS_ST] = _failureGuardChain },
+};
+
+const TState *const nextStatesTable[STATES_MAX][EVENTS_MAX] = {
+    [NO_STATE]          = { [GO_EMPTY_HOOKS_ST] = &statesList[EMPTY_HOOKS_ST] },
+    [FAILURE_HOOKS_ST]  = { [GO_EMPTY_HOOKS_ST] = &statesList[EMPTY_HOOKS_ST] },
 };
 
 TEvent eventArray[QUEUE_MAX_SIZE];
@@ -98,7 +110,7 @@ void test_FSM_ProcessEventToNextStateFromTransitionTable_Should_TransitionState(
     activeObject.state = &statesList[EMPTY_HOOKS_ST];
     TEvent event = { .sig = GO_SUCCESS_HOOKS_ST };
     
-    const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, event, STATES_MAX, EVENTS_MAX, statesList);
+    const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, event, STATES_MAX, EVENTS_MAX, transitionTable);
     
     TEST_ASSERT_EQUAL_PTR(&statesList[SUCCESS_HOOKS_ST], nextState);
 }
@@ -107,11 +119,170 @@ void test_FSM_ProcessEventToNextStateFromTransitionTable_Should_NotTransitionSta
     activeObject.state = &statesList[SUCCESS_HOOKS_ST];
     TEvent event = { .sig = GO_FAILURE_HOOKS_ST };
     
-    const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, event, STATES_MAX, EVENTS_MAX, statesList);
+    const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, event, STATES_MAX, EVENTS_MAX, transitionTable);
     
     TEST_ASSERT_EQUAL_PTR(&statesList[FAILURE_HOOKS_ST], nextState);
 }
 
+void test_FSM_ProcessEventToNextStateFromTransitionTable_WithGuardChain_Should_PickFirstTrueCase(void) {
+    activeObject.state = &statesList[FAILURE_HOOKS_ST];
+    TEvent event = { .sig = GO_FAILURE_HOOKS_ST, .payload = &activeObject };
+
+    const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, event, STATES_MAX, EVENTS_MAX, transitionTable);
+
+    TEST_ASSERT_EQUAL_PTR(&statesList[SUCCESS_HOOKS_ST], nextState);
+}
+
+void test_FSM_ProcessEventToNextStateFromTransitionTable_WithGuardChain_Should_FallbackToElse(void) {
+    activeObject.state = &statesList[FAILURE_HOOKS_ST];
+    TEvent event = { .sig = GO_FAILURE_HOOKS_ST, .payload = NULL };
+
+    const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, event, STATES_MAX, EVENTS_MAX, transitionTable);
+
+    TEST_ASSERT_EQUAL_PTR(&statesList[FAILURE_HOOKS_ST], nextState);
+}
+
+void test_FSM_ProcessEventToNextStateFromTables_Should_TransitionState_WithoutHandler(void) {
+    activeObject.state = &statesList[FAILURE_HOOKS_ST];
+    TEvent event = { .sig = GO_EMPTY_HOOKS_ST };
+
+    const TState *nextState = FSM_ProcessEventToNextStateFromTables(&activeObject, event, STATES_MAX, EVENTS_MAX, nextStatesTable, NULL);
+
+    TEST_ASSERT_EQUAL_PTR(&statesList[EMPTY_HOOKS_ST], nextState);
+}
+
+void test_FSM_ProcessEventToNextStateFromTables_Should_FallbackToHandler(void) {
+    activeObject.state = &statesList[FAILURE_HOOKS_ST];
+    TEvent event = { .sig = GO_SUCCESS_HOOKS_ST };
+
+    const TState *nextState = FSM_ProcessEventToNextStateFromTables(&activeObject, event, STATES_MAX, EVENTS_MAX, nextStatesTable, transitionTable);
+
+    TEST_ASSERT_EQUAL_PTR(&statesList[SUCCESS_HOOKS_ST], nextState);
+}
+
+void test_FSM_ProcessEventToNextStateFromTables_Should_ReturnEmptyState(void) {
+    activeObject.state = &statesList[EMPTY_HOOKS_ST];
+    TEvent event = { .sig = GO_FAILURE_HOOKS_ST };
+
+    const TState *nextState = FSM_ProcessEventToNextStateFromTables(&activeObject, event, STATES_MAX, EVENTS_MAX, nextStatesTable, transitionTable);
+
+    TEST_ASSERT_EQUAL_INT(EMPTY_STATE.name, nextState->name);
+}
+
+void test_FSM_ProcessEventToNextStateFromTables_Should_ReturnInvalidState(void) {
+    activeObject.state = &statesList[EMPTY_HOOKS_ST];
+    TEvent event = { .sig = EVENTS_MAX };
+
+    const TState *nextState = FSM_ProcessEventToNextStateFromTables(&activeObject, event, STATES_MAX, EVENTS_MAX, nextStatesTable, transitionTable);
+
+    TEST_ASSERT_EQUAL_INT(INVALID_STATE.name, nextState->name);
+}
+
+void test_FSM_CompileTransitionPlans_Should_KeepNonNullHooksOnly(void) {
+    TTransitionPlan plans[STATES_MAX][STATES_MAX];
+
+    FSM_CompileTransitionPlans(statesList, STATES_MAX, plans);
+
+    TEST_ASSERT_EQUAL_UINT8(0, plans[EMPTY_HOOKS_ST][EMPTY_HOOKS_ST].hooksCount);
+    TEST_ASSERT_EQUAL_UINT8(1, plans[SUCCESS_HOOKS_ST][SUCCESS_HOOKS_ST].hooksCount);
+    TEST_ASSERT_EQUAL_UINT8(0, plans[SUCCESS_HOOKS_ST][SUCCESS_HOOKS_ST].exitCount);
+    TEST_ASSERT_EQUAL_UINT8(1, plans[SUCCESS_HOOKS_ST][EMPTY_HOOKS_ST].hooksCount);
+    TEST_ASSERT_EQUAL_UINT8(1, plans[SUCCESS_HOOKS_ST][EMPTY_HOOKS_ST].exitCount);
+    TEST_ASSERT_EQUAL_UINT8(2, plans[EMPTY_HOOKS_ST][SUCCESS_HOOKS_ST].hooksCount);
+    TEST_ASSERT_EQUAL_UINT8(0, plans[EMPTY_HOOKS_ST][SUCCESS_HOOKS_ST].exitCount);
+    TEST_ASSERT_NULL(plans[EMPTY_HOOKS_ST][NO_STATE].target);
+}
+
+void test_FSM_TraverseAOByPlan_Should_MatchTraverseAOToNextState(void) {
+    TTransitionPlan plans[STATES_MAX][STATES_MAX];
+
+    FSM_CompileTransitionPlans(statesList, STATES_MAX, plans);
+
+    activeObject.state = &statesList[NO_STATE];
+    TEST_ASSERT_TRUE(FSM_TraverseAOByPlan(&activeObject, STATES_MAX, plans, &statesList[EMPTY_HOOKS_ST]));
+    TEST_ASSERT_EQUAL_PTR(&statesList[EMPTY_HOOKS_ST], activeObject.state);
+
+    TEST_ASSERT_TRUE(FSM_TraverseAOByPlan(&activeObject, STATES_MAX, plans, &statesList[SUCCESS_HOOKS_ST]));
+    TEST_ASSERT_TRUE(FSM_TraverseAOByPlan(&activeObject, STATES_MAX, plans, &statesList[SUCCESS_HOOKS_ST]));
+    TEST_ASSERT_EQUAL_PTR(&statesList[SUCCESS_HOOKS_ST], activeObject.state);
+
+    // onEnter fails after the state update
+    TEST_ASSERT_FALSE(FSM_TraverseAOByPlan(&activeObject, STATES_MAX, plans, &statesList[FAILURE_HOOKS_ST]));
+    TEST_ASSERT_EQUAL_PTR(&statesList[FAILURE_HOOKS_ST], activeObject.state);
+
+    // onExit fails before the state update
+    TEST_ASSERT_FALSE(FSM_TraverseAOByPlan(&activeObject, STATES_MAX, plans, &statesList[SUCCESS_HOOKS_ST]));
+    TEST_ASSERT_EQUAL_PTR(&statesList[FAILURE_HOOKS_ST], activeObject.state);
+
+    TEST_ASSERT_FALSE(FSM_TraverseAOByPlan(&activeObject, STATES_MAX, plans, &statesList[NO_STATE]));
+}
+
+void test_FSM_CompileAcceptedSignals(void) {
+    TSignalMask accepted[STATES_MAX][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)];
+
+    FSM_CompileAcceptedSignals(STATES_MAX, EVENTS_MAX, nextStatesTable, transitionTable, accepted);
+
+    TEST_ASSERT_EQUAL_UINT32(1u << GO_EMPTY_HOOKS_ST, accepted[NO_STATE][0]);
+    TEST_ASSERT_EQUAL_UINT32(1u << GO_SUCCESS_HOOKS_ST, accepted[EMPTY_HOOKS_ST][0]);
+    TEST_ASSERT_EQUAL_UINT32(1u << GO_FAILURE_HOOKS_ST, accepted[SUCCESS_HOOKS_ST][0]);
+    TEST_ASSERT_EQUAL_UINT32((1u << GO_EMPTY_HOOKS_ST) | (1u << GO_SUCCESS_HOOKS_ST) | (1u << GO_FAILURE_HOOKS_ST),
+                             accepted[FAILURE_HOOKS_ST][0]);
+
+    FSM_CompileAcceptedSignals(STATES_MAX, EVENTS_MAX, NULL, transitionTable, accepted);
+    TEST_ASSERT_EQUAL_UINT32((1u << GO_SUCCESS_HOOKS_ST) | (1u << GO_FAILURE_HOOKS_ST), accepted[FAILURE_HOOKS_ST][0]);
+}
+
+void test_FSM_RemapTransitionTable(void) {
+    // Reverse states and swap the first two signals
+    const uint16_t stateMap[STATES_MAX] = {3, 2, 1, 0};
+    const uint16_t sigMap[EVENTS_MAX] = {1, 0, 2, 3};
+    const uint16_t duplicateMap[EVENTS_MAX] = {1, 1, 2, 3};
+    TEventHandler remappedTable[STATES_MAX][EVENTS_MAX];
+
+    TEST_ASSERT_FALSE(FSM_RemapTransitionTable(STATES_MAX, EVENTS_MAX, transitionTable, stateMap, duplicateMap, remappedTable));
+    TEST_ASSERT_TRUE(FSM_RemapTransitionTable(STATES_MAX, EVENTS_MAX, transitionTable, stateMap, sigMap, remappedTable));
+    TEST_ASSERT_EQUAL_PTR(_goToSuccessHooksState, remappedTable[2][GO_SUCCESS_HOOKS_ST]);
+
+    activeObject.state = &statesList[EMPTY_HOOKS_ST];
+    TEST_ASSERT_EQUAL_PTR(&statesList[SUCCESS_HOOKS_ST], FSM_ProcessEventToNextStateFromRemappedTable(
+            &activeObject, (TEvent){.sig = GO_SUCCESS_HOOKS_ST}, STATES_MAX, EVENTS_MAX, stateMap, sigMap, remappedTable));
+    TEST_ASSERT_EQUAL_INT(EMPTY_STATE.name, FSM_ProcessEventToNextStateFromRemappedTable(
+            &activeObject, (TEvent){.sig = GO_EMPTY_HOOKS_ST}, STATES_MAX, EVENTS_MAX, stateMap, sigMap, remappedTable)->name);
+    TEST_ASSERT_EQUAL_INT(INVALID_STATE.name, FSM_ProcessEventToNextStateFromRemappedTable(
+            &activeObject, (TEvent){.sig = EVENTS_MAX}, STATES_MAX, EVENTS_MAX, stateMap, sigMap, remappedTable)->name);
+}
+
+#ifdef FSM_PROFILE
+void test_FSM_AttachProfile_CountsLookups(void) {
+    uint64_t hits[STATES_MAX][EVENTS_MAX];
+    TFsmProfile profile;
+
+    TEST_ASSERT_TRUE(FSM_AttachProfile(&profile, transitionTable, STATES_MAX, EVENTS_MAX, &hits[0][0]));
+
+    activeObject.state = &statesList[EMPTY_HOOKS_ST];
+    FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, (TEvent){.sig = GO_SUCCESS_HOOKS_ST}, STATES_MAX, EVENTS_MAX, transitionTable);
+    FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, (TEvent){.sig = GO_SUCCESS_HOOKS_ST}, STATES_MAX, EVENTS_MAX, transitionTable);
+    FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, (TEvent){.sig = NO_SIG}, STATES_MAX, EVENTS_MAX, transitionTable);
+
+    TEST_ASSERT_EQUAL_UINT64(2, hits[EMPTY_HOOKS_ST][GO_SUCCESS_HOOKS_ST]);
+    TEST_ASSERT_EQUAL_UINT64(1, hits[EMPTY_HOOKS_ST][NO_SIG]);
+    TEST_ASSERT_EQUAL_UINT64(0, hits[NO_STATE][GO_EMPTY_HOOKS_ST]);
+
+    // Detached profile keeps its counts
+    FSM_DetachProfile(&profile);
+    FSM_ProcessEventToNextStateFromTransitionTable(&activeObject, (TEvent){.sig = GO_SUCCESS_HOOKS_ST}, STATES_MAX, EVENTS_MAX, transitionTable);
+    TEST_ASSERT_EQUAL_UINT64(2, hits[EMPTY_HOOKS_ST][GO_SUCCESS_HOOKS_ST]);
+}
+#else
+void test_FSM_AttachProfile_Disabled(void) {
+    uint64_t hits[STATES_MAX][EVENTS_MAX];
+    TFsmProfile profile;
+
+    TEST_ASSERT_FALSE(FSM_AttachProfile(&profile, transitionTable, STATES_MAX, EVENTS_MAX, &hits[0][0]));
+    FSM_DetachProfile(&profile);
+}
+#endif
+
 int main(void) {
     UNITY_BEGIN();
 
@@ -121,10 +292,29 @@ int main(void) {
     RUN_TEST(test_FSM_TraverseAOToNextState_Self_SuccessHooks_Should_ReturnTrue);
     RUN_TEST(test_FSM_TraverseAOToNextState_FailureHooks_Should_ReturnFalse);
     RUN_TEST(test_FSM_TraverseAOToNextState_from_FailureHooks_Fails);
+
+    // TraverseAOByPlan
+    RUN_TEST(test_FSM_CompileTransitionPlans_Should_KeepNonNullHooksOnly);
+    RUN_TEST(test_FSM_TraverseAOByPlan_Should_MatchTraverseAOToNextState);
     
     // ProcessEventToNextState
     RUN_TEST(test_FSM_ProcessEventToNextStateFromTransitionTable_Should_TransitionState);
     RUN_TEST(test_FSM_ProcessEventToNextStateFromTransitionTable_Should_NotTransitionState_WithGuard);
+    RUN_TEST(test_FSM_ProcessEventToNextStateFromTransitionTable_WithGuardChain_Should_PickFirstTrueCase);
+    RUN_TEST(test_FSM_ProcessEventToNextStateFromTransitionTable_WithGuardChain_Should_FallbackToElse);
+
+    // ProcessEventToNextStateFromTables
+    RUN_TEST(test_FSM_ProcessEventToNextStateFromTables_Should_TransitionState_WithoutHandler);
+    RUN_TEST(test_FSM_ProcessEventToNextStateFromTables_Should_FallbackToHandler);
+    RUN_TEST(test_FSM_ProcessEventToNextStateFromTables_Should_ReturnEmptyState);
+    RUN_TEST(test_FSM_ProcessEventToNextStateFromTables_Should_ReturnInvalidState);
+    RUN_TEST(test_FSM_CompileAcceptedSignals);
+    RUN_TEST(test_FSM_RemapTransitionTable);
+#ifdef FSM_PROFILE
+    RUN_TEST(test_FSM_AttachProfile_CountsLookups);
+#else
+    RUN_TEST(test_FSM_AttachProfile_Disabled);
+#endif
     UNITY_END();
     
     return 0;
@@ -0,0 +1,118 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/fsm_bank/fsm_bank.h"
+
+#define INSTANCES_MAX 8
+#define STEPS_MAX 8
+
+typedef enum { NO_STATE, IDLE_ST, OPEN_ST, CLOSED_ST, STATES_MAX } STATES_NAMES; // state names
+typedef enum { NO_SIG, OPEN_SIG, CLOSE_SIG, DATA_SIG, EVENTS_MAX } EVENT_SIGS; // events signals names
+
+uint32_t dataHandlerCalls;
+uint32_t dataHandlerInstances;
+
+void _onData(TFSMBank *const bank, int sig, const uint32_t *const instances, uint32_t count) {
+    dataHandlerCalls++;
+    dataHandlerInstances += count;
+    for (uint32_t i = 0; i < count; i++) bank->states[instances[i]] = OPEN_ST;
+};
+
+void _onStart(TFSMBank *const bank, int sig, const uint32_t *const instances, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) bank->states[instances[i]] = IDLE_ST;
+};
+
+const TFSMBankHandler handlers[STATES_MAX][EVENTS_MAX] = {
+    [NO_STATE]  = { [OPEN_SIG] = _onStart },
+    [OPEN_ST]   = { [DATA_SIG] = _onData },
+};
+
+const TFSMBankState nextStates[STATES_MAX][EVENTS_MAX] = {
+    [IDLE_ST]   = { [OPEN_SIG] = OPEN_ST },
+    [OPEN_ST]   = { [CLOSE_SIG] = CLOSED_ST },
+};
+
+TFSMBankState states[INSTANCES_MAX];
+uint32_t keys[STEPS_MAX];
+uint32_t runInstances[STEPS_MAX];
+uint32_t runOffsets[STATES_MAX * EVENTS_MAX + 1];
+TFSMBank bank;
+
+void setUp(void) {
+    FSMBank_Initialize(&bank, states, INSTANCES_MAX, STATES_MAX, EVENTS_MAX, handlers, nextStates);
+    FSMBank_SetScratch(&bank, keys, runOffsets, runInstances, STEPS_MAX);
+    dataHandlerCalls = 0;
+    dataHandlerInstances = 0;
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_FSMBank_Initialize(void) {
+    for (uint32_t i = 0; i < INSTANCES_MAX; i++) TEST_ASSERT_EQUAL(NO_STATE, states[i]);
+}
+
+void test_FSMBank_Step_TableOnlyTransitions(void) {
+    states[0] = IDLE_ST;
+    states[1] = OPEN_ST;
+    states[2] = CLOSED_ST;
+    TFSMBankStep steps[] = {{0, OPEN_SIG}, {1, CLOSE_SIG}, {2, OPEN_SIG}};
+
+    TEST_ASSERT_EQUAL_UINT32(3, FSMBank_Step(&bank, steps, 3));
+
+    TEST_ASSERT_EQUAL(OPEN_ST, states[0]);
+    TEST_ASSERT_EQUAL(CLOSED_ST, states[1]);
+    TEST_ASSERT_EQUAL(CLOSED_ST, states[2]); // no transition
+}
+
+void test_FSMBank_Step_HandlerRunsOncePerCell(void) {
+    states[1] = OPEN_ST;
+    states[3] = OPEN_ST;
+    states[5] = OPEN_ST;
+    TFSMBankStep steps[] = {{1, DATA_SIG}, {0, OPEN_SIG}, {3, DATA_SIG}, {5, DATA_SIG}, {4, OPEN_SIG}};
+
+    TEST_ASSERT_EQUAL_UINT32(5, FSMBank_Step(&bank, steps, 5));
+
+    TEST_ASSERT_EQUAL_UINT32(1, dataHandlerCalls);
+    TEST_ASSERT_EQUAL_UINT32(3, dataHandlerInstances);
+    TEST_ASSERT_EQUAL(IDLE_ST, states[0]);
+    TEST_ASSERT_EQUAL(IDLE_ST, states[4]);
+}
+
+void test_FSMBank_Step_SkipsInvalidSteps(void) {
+    TFSMBankStep steps[] = {{INSTANCES_MAX, OPEN_SIG}, {0, EVENTS_MAX}, {0, OPEN_SIG}};
+
+    TEST_ASSERT_EQUAL_UINT32(1, FSMBank_Step(&bank, steps, 3));
+    TEST_ASSERT_EQUAL(IDLE_ST, states[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, FSMBank_Step(&bank, steps, STEPS_MAX + 1));
+}
+
+void test_FSMBank_Step_SkipsOutOfRangeState(void) {
+    states[0] = STATES_MAX;
+    states[1] = IDLE_ST;
+    TFSMBankStep steps[] = {{0, OPEN_SIG}, {1, OPEN_SIG}};
+
+    TEST_ASSERT_EQUAL_UINT32(1, FSMBank_Step(&bank, steps, 2));
+    TEST_ASSERT_EQUAL(STATES_MAX, states[0]);
+    TEST_ASSERT_EQUAL(OPEN_ST, states[1]);
+}
+
+void test_FSMBank_Step_NoStepsOrNoScratch(void) {
+    TFSMBankStep steps[] = {{0, OPEN_SIG}};
+
+    FSMBank_Initialize(&bank, states, INSTANCES_MAX, STATES_MAX, EVENTS_MAX, handlers, nextStates);
+
+    TEST_ASSERT_EQUAL_UINT32(0, FSMBank_Step(&bank, steps, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, FSMBank_Step(&bank, steps, 1));
+    TEST_ASSERT_EQUAL(NO_STATE, states[0]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_FSMBank_Initialize);
+    RUN_TEST(test_FSMBank_Step_TableOnlyTransitions);
+    RUN_TEST(test_FSMBank_Step_HandlerRunsOncePerCell);
+    RUN_TEST(test_FSMBank_Step_SkipsInvalidSteps);
+    RUN_TEST(test_FSMBank_Step_SkipsOutOfRangeState);
+    RUN_TEST(test_FSMBank_Step_NoStepsOrNoScratch);
+    return UNITY_END();
+}
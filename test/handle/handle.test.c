@@ -0,0 +1,47 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/handle/handle.h"
+
+void setUp(void) {
+    // Nothing to set up in this case
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Handle_Make_SplitsBack(void) {
+    THandle handle = Handle_Make(0xABCDEFu, 0x12345678u);
+
+    TEST_ASSERT_EQUAL_UINT32(0xABCDEFu, Handle_GetIndex(handle));
+    TEST_ASSERT_EQUAL_UINT32(0x12345678u, Handle_GetGeneration(handle));
+    TEST_ASSERT_NOT_EQUAL(HANDLE_INVALID, Handle_Make(0, HANDLE_GENERATION_FIRST));
+    TEST_ASSERT_EQUAL_UINT32(0, Handle_GetGeneration(HANDLE_INVALID));
+}
+
+void test_Handle_NextGeneration_MakesHandleStale(void) {
+    uint32_t generation = HANDLE_GENERATION_FIRST;
+    THandle handle = Handle_Make(7, generation);
+
+    TEST_ASSERT_TRUE(Handle_NextGeneration(&generation));
+    TEST_ASSERT_NOT_EQUAL(handle, Handle_Make(7, generation));
+    TEST_ASSERT_EQUAL_UINT32(HANDLE_GENERATION_FIRST + 1, generation);
+}
+
+void test_Handle_NextGeneration_RetiresSaturatedSlot(void) {
+    uint32_t generation = HANDLE_GENERATION_LAST - 1;
+
+    TEST_ASSERT_TRUE(Handle_NextGeneration(&generation));
+    TEST_ASSERT_EQUAL_UINT32(HANDLE_GENERATION_LAST, generation);
+
+    // Never wraps back to a generation of an older handle
+    TEST_ASSERT_FALSE(Handle_NextGeneration(&generation));
+    TEST_ASSERT_EQUAL_UINT32(HANDLE_GENERATION_LAST, generation);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Handle_Make_SplitsBack);
+    RUN_TEST(test_Handle_NextGeneration_MakesHandleStale);
+    RUN_TEST(test_Handle_NextGeneration_RetiresSaturatedSlot);
+    return UNITY_END();
+}
@@ -0,0 +1,208 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/fsm/fsm.h"
+#include "../../src/machine/machine.h"
+
+#define QUEUE_MAX_SIZE 4
+#define WORKERS_MAX 2
+#define RETIRED_MAX 2
+
+typedef enum { NO_SIG, TOGGLE_SIG, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+
+typedef enum { NO_STATE, STATE_OFF, STATE_ON, STATE_STANDBY, STATES_MAX } TEST_STATE_NAME;
+
+const TState *toggleV1(TActiveObject *const activeObject, TEvent event);
+const TState *toggleV2(TActiveObject *const activeObject, TEvent event);
+const TState *mapRenamedStates(const TMachine *next, const TMachine *previous, const TState *state);
+
+// Version 1: OFF <-> ON
+const TState statesV1[STATES_MAX - 1] = {
+        [NO_STATE] = EMPTY_STATE,
+        [STATE_OFF] = {.name = STATE_OFF},
+        [STATE_ON] = {.name = STATE_ON},
+};
+
+const TEventHandler tableV1[STATES_MAX - 1][EVENTS_MAX] = {
+        [STATE_OFF] = {[TOGGLE_SIG] = toggleV1},
+        [STATE_ON] = {[TOGGLE_SIG] = toggleV1},
+};
+
+// Version 2: OFF -> ON -> STANDBY -> OFF
+const TState statesV2[STATES_MAX] = {
+        [NO_STATE] = EMPTY_STATE,
+        [STATE_OFF] = {.name = STATE_OFF},
+        [STATE_ON] = {.name = STATE_ON},
+        [STATE_STANDBY] = {.name = STATE_STANDBY},
+};
+
+const TEventHandler tableV2[STATES_MAX][EVENTS_MAX] = {
+        [STATE_OFF] = {[TOGGLE_SIG] = toggleV2},
+        [STATE_ON] = {[TOGGLE_SIG] = toggleV2},
+        [STATE_STANDBY] = {[TOGGLE_SIG] = toggleV2},
+};
+
+TMachine machineV1;
+TMachine machineV2;
+TMachine machineV3;
+TMachineHandle handle;
+TMachineReader readers[WORKERS_MAX];
+TMachineRetired retired[RETIRED_MAX];
+TEvent eventArray[QUEUE_MAX_SIZE];
+TMachineActiveObject device;
+TMachine *released[RETIRED_MAX];
+uint32_t releasedCount;
+
+const TState *toggleV1(TActiveObject *const activeObject, TEvent event) {
+    return &statesV1[STATE_ON == activeObject->state->name ? STATE_OFF : STATE_ON];
+}
+
+const TState *toggleV2(TActiveObject *const activeObject, TEvent event) {
+    return &statesV2[STATE_STANDBY == activeObject->state->name ? STATE_OFF : activeObject->state->name + 1];
+}
+
+// Version 3 renames ON into STANDBY
+const TState *mapRenamedStates(const TMachine *next, const TMachine *previous, const TState *state) {
+    return &next->states[STATE_ON == state->name ? STATE_STANDBY : state->name];
+}
+
+void releaseMachine(TMachine *machine, void *const ctx) {
+    released[releasedCount++] = machine;
+}
+
+static const TState *processEvent(int sig) {
+    ActiveObject_Dispatch(&device.super, (TEvent) {.sig = sig});
+
+    TEvent event = ActiveObject_ProcessQueue(&device.super);
+    const TState *nextState = MachineActiveObject_ProcessEvent(&device, event);
+
+    if (FSM_IsValidState(nextState)) FSM_TraverseAOToNextState(&device.super, nextState);
+    return device.super.state;
+}
+
+void setUp(void) {
+    machineV1 = (TMachine) {.version = 1, .statesMax = STATES_MAX - 1, .eventsMax = EVENTS_MAX,
+            .states = statesV1, .transitionTable = &tableV1[0][0]};
+    machineV2 = (TMachine) {.version = 2, .statesMax = STATES_MAX, .eventsMax = EVENTS_MAX,
+            .states = statesV2, .transitionTable = &tableV2[0][0]};
+    machineV3 = (TMachine) {.version = 3, .statesMax = STATES_MAX, .eventsMax = EVENTS_MAX,
+            .states = statesV2, .transitionTable = &tableV2[0][0], .mapState = mapRenamedStates};
+    releasedCount = 0;
+
+    Machine_Initialize(&handle, &machineV1, readers, WORKERS_MAX, retired, RETIRED_MAX, releaseMachine, NULL);
+    MachineActiveObject_Initialize(&device, &handle, 0, eventArray, QUEUE_MAX_SIZE, STATE_OFF);
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Machine_ProcessEvent_CurrentVersion(void) {
+    TEST_ASSERT_EQUAL_PTR(&statesV1[STATE_ON], processEvent(TOGGLE_SIG));
+    TEST_ASSERT_EQUAL_PTR(&statesV1[STATE_OFF], processEvent(TOGGLE_SIG));
+    TEST_ASSERT_EQUAL_UINT32(1, machineV1.objectsCount);
+}
+
+void test_Machine_Publish_MigratesOnNextEvent(void) {
+    processEvent(TOGGLE_SIG);
+
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV2));
+    TEST_ASSERT_EQUAL_PTR(&machineV1, device.machine);
+
+    // ON maps to ON of version 2 by name, then version 2 table moves it to STANDBY
+    TEST_ASSERT_EQUAL_PTR(&statesV2[STATE_STANDBY], processEvent(TOGGLE_SIG));
+    TEST_ASSERT_EQUAL_PTR(&machineV2, device.machine);
+    TEST_ASSERT_EQUAL_UINT32(0, machineV1.objectsCount);
+    TEST_ASSERT_EQUAL_UINT32(1, machineV2.objectsCount);
+}
+
+void test_Machine_Publish_MapState(void) {
+    processEvent(TOGGLE_SIG);
+
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV3));
+    TEST_ASSERT_TRUE(MachineActiveObject_Migrate(&device));
+    TEST_ASSERT_EQUAL_PTR(&statesV2[STATE_STANDBY], device.super.state);
+}
+
+void test_Machine_Reclaim_AfterGracePeriodAndMigration(void) {
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV2));
+
+    // No worker has passed a quiescent state yet
+    TEST_ASSERT_EQUAL_UINT32(0, Machine_Reclaim(&handle));
+
+    Machine_Quiescent(&handle, 0);
+    Machine_Quiescent(&handle, 1);
+
+    // The device still runs version 1
+    TEST_ASSERT_EQUAL_UINT32(0, Machine_Reclaim(&handle));
+
+    TEST_ASSERT_TRUE(MachineActiveObject_Migrate(&device));
+    TEST_ASSERT_EQUAL_UINT32(1, Machine_Reclaim(&handle));
+    TEST_ASSERT_EQUAL_PTR(&machineV1, released[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, handle.retiredCount);
+}
+
+void test_Machine_Reclaim_WaitsForEveryWorker(void) {
+    MachineActiveObject_Migrate(&device);
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV2));
+    MachineActiveObject_Migrate(&device);
+
+    Machine_Quiescent(&handle, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, Machine_Reclaim(&handle));
+
+    Machine_Quiescent(&handle, 1);
+    TEST_ASSERT_EQUAL_UINT32(1, Machine_Reclaim(&handle));
+}
+
+void test_Machine_Publish_RetiredFull(void) {
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV2));
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV3));
+
+    TMachine machineV4 = machineV3;
+
+    TEST_ASSERT_FALSE(Machine_Publish(&handle, &machineV4));
+    TEST_ASSERT_FALSE(Machine_Publish(&handle, NULL));
+    TEST_ASSERT_EQUAL_PTR(&machineV3, handle.current);
+
+    // A rollback takes its slot back from the retired descriptors
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV1));
+    TEST_ASSERT_EQUAL_UINT32(RETIRED_MAX, handle.retiredCount);
+}
+
+void test_Machine_Publish_RollbackKeepsCurrent(void) {
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV2));
+    TEST_ASSERT_TRUE(MachineActiveObject_Migrate(&device));
+
+    // Rolled back before any object runs version 1 again
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV1));
+    TEST_ASSERT_EQUAL_UINT32(1, handle.retiredCount);
+    TEST_ASSERT_EQUAL_PTR(&machineV2, handle.retired[0].machine);
+
+    Machine_Quiescent(&handle, 0);
+    Machine_Quiescent(&handle, 1);
+
+    // Version 2 is still used by the device, version 1 is current
+    TEST_ASSERT_EQUAL_UINT32(0, Machine_Reclaim(&handle));
+
+    TEST_ASSERT_TRUE(MachineActiveObject_Migrate(&device));
+    TEST_ASSERT_EQUAL_UINT32(1, Machine_Reclaim(&handle));
+    TEST_ASSERT_EQUAL_PTR(&machineV2, released[0]);
+    TEST_ASSERT_EQUAL_PTR(&machineV1, handle.current);
+}
+
+void test_Machine_Publish_Current(void) {
+    TEST_ASSERT_TRUE(Machine_Publish(&handle, &machineV1));
+    TEST_ASSERT_EQUAL_UINT32(0, handle.retiredCount);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Machine_ProcessEvent_CurrentVersion);
+    RUN_TEST(test_Machine_Publish_MigratesOnNextEvent);
+    RUN_TEST(test_Machine_Publish_MapState);
+    RUN_TEST(test_Machine_Reclaim_AfterGracePeriodAndMigration);
+    RUN_TEST(test_Machine_Reclaim_WaitsForEveryWorker);
+    RUN_TEST(test_Machine_Publish_RetiredFull);
+    RUN_TEST(test_Machine_Publish_RollbackKeepsCurrent);
+    RUN_TEST(test_Machine_Publish_Current);
+    return UNITY_END();
+}
@@ -0,0 +1,147 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/mailbox/mailbox.h"
+
+#define QUEUE_MAX_SIZE 4
+#define MAILBOX_CAPACITY 4
+#define CORES_MAX 2
+
+typedef enum { NO_SIG, PING_SIG, PONG_SIG, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+typedef enum { NO_ST, PING_ST, STATES_MAX } TEST_STATE; // state names
+
+TEvent eventArrays[CORES_MAX][QUEUE_MAX_SIZE];
+TActiveObject activeObjects[CORES_MAX];
+TMailboxMessage messages[CORES_MAX * CORES_MAX * MAILBOX_CAPACITY];
+TMailbox mailboxes[CORES_MAX * CORES_MAX];
+TMailboxMesh mesh;
+
+void setUp(void) {
+    for (uint32_t i = 0; i < CORES_MAX; i++) {
+        ActiveObject_Initialize(&activeObjects[i], i, eventArrays[i], QUEUE_MAX_SIZE);
+    }
+
+    MailboxMesh_Initialize(&mesh, mailboxes, messages, CORES_MAX, MAILBOX_CAPACITY);
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Mailbox_Initialize_InvalidCapacity(void) {
+    TMailbox mailbox;
+
+    TEST_ASSERT_FALSE(Mailbox_Initialize(&mailbox, messages, 3));
+    TEST_ASSERT_FALSE(Mailbox_Initialize(&mailbox, messages, 0));
+    TEST_ASSERT_TRUE(Mailbox_Initialize(&mailbox, messages, MAILBOX_CAPACITY));
+}
+
+void test_MailboxMesh_Initialize_InvalidArgs(void) {
+    TEST_ASSERT_FALSE(MailboxMesh_Initialize(&mesh, mailboxes, NULL, CORES_MAX, MAILBOX_CAPACITY));
+    TEST_ASSERT_FALSE(MailboxMesh_Initialize(&mesh, NULL, messages, CORES_MAX, MAILBOX_CAPACITY));
+    TEST_ASSERT_FALSE(MailboxMesh_Initialize(&mesh, mailboxes, messages, 0, MAILBOX_CAPACITY));
+}
+
+void test_MailboxMesh_Layout_NoSharedLines(void) {
+    // Ring, consumer and producer fields on separate lines
+    TEST_ASSERT_EQUAL_UINT32(0, offsetof(TMailbox, messages) / MAILBOX_CACHE_LINE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(0, offsetof(TMailbox, mask) / MAILBOX_CACHE_LINE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(1, offsetof(TMailbox, head) / MAILBOX_CACHE_LINE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(1, offsetof(TMailbox, cachedTail) / MAILBOX_CACHE_LINE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(2, offsetof(TMailbox, tail) / MAILBOX_CACHE_LINE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(2, offsetof(TMailbox, cachedHead) / MAILBOX_CACHE_LINE_SIZE);
+
+    // Mailboxes of the mesh array start at line boundaries
+    TEST_ASSERT_EQUAL_UINT32(0, sizeof(TMailbox) % MAILBOX_CACHE_LINE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t) &mailboxes[1] % MAILBOX_CACHE_LINE_SIZE);
+}
+
+void test_Mailbox_SendReceive_Fifo(void) {
+    TMailbox *mailbox = &mailboxes[0];
+    TMailboxMessage message;
+
+    TEST_ASSERT_FALSE(Mailbox_Receive(mailbox, &message));
+
+    for (int i = 0; i < MAILBOX_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(Mailbox_Send(mailbox, &activeObjects[0], (TEvent){.sig = i}));
+    }
+    TEST_ASSERT_FALSE(Mailbox_Send(mailbox, &activeObjects[0], (TEvent){.sig = PING_SIG}));
+
+    for (int i = 0; i < MAILBOX_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(Mailbox_Receive(mailbox, &message));
+        TEST_ASSERT_EQUAL(i, message.event.sig);
+        TEST_ASSERT_EQUAL_PTR(&activeObjects[0], message.target);
+    }
+
+    // Room again after the consumer index moved
+    TEST_ASSERT_TRUE(Mailbox_Send(mailbox, &activeObjects[0], (TEvent){.sig = PING_SIG}));
+}
+
+void test_MailboxMesh_Send_Poll(void) {
+    TEST_ASSERT_TRUE(MailboxMesh_Send(&mesh, 0, 1, &activeObjects[1], (TEvent){.sig = PING_SIG}));
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&activeObjects[1].queue));
+
+    TEST_ASSERT_EQUAL_UINT32(0, MailboxMesh_Poll(&mesh, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, MailboxMesh_Poll(&mesh, 1));
+    TEST_ASSERT_EQUAL(PING_SIG, ActiveObject_ProcessQueue(&activeObjects[1]).sig);
+}
+
+void test_MailboxMesh_Send_SameCore_DispatchesDirectly(void) {
+    TEST_ASSERT_TRUE(MailboxMesh_Send(&mesh, 1, 1, &activeObjects[1], (TEvent){.sig = PONG_SIG}));
+    TEST_ASSERT_EQUAL(PONG_SIG, ActiveObject_ProcessQueue(&activeObjects[1]).sig);
+    TEST_ASSERT_FALSE(MailboxMesh_Send(&mesh, 0, CORES_MAX, &activeObjects[1], (TEvent){.sig = PONG_SIG}));
+}
+
+void test_Mailbox_Deliver_KeepsMessages_WhenTargetQueueFull(void) {
+    TMailbox *mailbox = &mailboxes[1];
+    TEvent smallEventArray[1];
+    TActiveObject smallActiveObject;
+    TMailboxMessage message;
+    ActiveObject_Initialize(&smallActiveObject, 2, smallEventArray, 1);
+
+    Mailbox_Send(mailbox, &smallActiveObject, (TEvent){.sig = PING_SIG});
+    Mailbox_Send(mailbox, &smallActiveObject, (TEvent){.sig = PONG_SIG});
+
+    TEST_ASSERT_EQUAL_UINT32(1, Mailbox_Deliver(mailbox, UINT32_MAX));
+    TEST_ASSERT_TRUE(Mailbox_Receive(mailbox, &message));
+    TEST_ASSERT_EQUAL(PONG_SIG, message.event.sig);
+}
+
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+// PING_ST handles PING_SIG only
+const TState states[STATES_MAX] = {[NO_ST] = {.name = NO_ST}, [PING_ST] = {.name = PING_ST}};
+const TSignalMask accepted[STATES_MAX][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)] = {[PING_ST] = {1u << PING_SIG}};
+const TSignalFilter filter = {.accepted = &accepted[0][0], .statesMax = STATES_MAX, .eventsMax = EVENTS_MAX};
+
+void test_Mailbox_Deliver_DiscardsRejectedMessages(void) {
+    TMailbox *mailbox = &mailboxes[1];
+    TMailboxMessage message;
+
+    ActiveObject_SetSignalFilter(&activeObjects[1], &filter);
+    activeObjects[1].state = &states[PING_ST];
+
+    Mailbox_Send(mailbox, &activeObjects[1], (TEvent){.sig = PONG_SIG});
+    Mailbox_Send(mailbox, &activeObjects[1], (TEvent){.sig = PING_SIG});
+
+    // The rejected message doesn't wedge the mailbox
+    TEST_ASSERT_EQUAL_UINT32(1, Mailbox_Deliver(mailbox, UINT32_MAX));
+    TEST_ASSERT_FALSE(Mailbox_Receive(mailbox, &message));
+    TEST_ASSERT_EQUAL_UINT32(1, activeObjects[1].rejectedCount);
+    TEST_ASSERT_EQUAL(PING_SIG, ActiveObject_ProcessQueue(&activeObjects[1]).sig);
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&activeObjects[1].queue));
+}
+#endif
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Mailbox_Initialize_InvalidCapacity);
+    RUN_TEST(test_MailboxMesh_Initialize_InvalidArgs);
+    RUN_TEST(test_MailboxMesh_Layout_NoSharedLines);
+    RUN_TEST(test_Mailbox_SendReceive_Fifo);
+    RUN_TEST(test_MailboxMesh_Send_Poll);
+    RUN_TEST(test_MailboxMesh_Send_SameCore_DispatchesDirectly);
+    RUN_TEST(test_Mailbox_Deliver_KeepsMessages_WhenTargetQueueFull);
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+    RUN_TEST(test_Mailbox_Deliver_DiscardsRejectedMessages);
+#endif
+    return UNITY_END();
+}
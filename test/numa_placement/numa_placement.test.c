@@ -0,0 +1,128 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/numa_placement/numa_placement.h"
+
+#define QUEUE_MAX_SIZE 4
+#define NODES_MAX 2
+#define OBJECTS_PER_NODE 2
+#define PAYLOADS_PER_NODE 2
+
+typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+
+typedef struct {
+    uint32_t value;
+    uint32_t channel;
+} TSample;
+
+// Static storages stand for node-local allocations of the port
+TActiveObjectPoolUnit objectsStorages[NODES_MAX][ACTIVE_OBJECT_POOL_STORAGE_UNITS(TActiveObject, QUEUE_MAX_SIZE, OBJECTS_PER_NODE)];
+TActiveObjectPoolUnit payloadsStorages[NODES_MAX][PAYLOADS_PER_NODE * NUMA_PLACEMENT_PAYLOAD_BLOCK_SIZE(sizeof(TSample)) / sizeof(TActiveObjectPoolUnit)];
+TNumaNode nodes[NODES_MAX];
+uint64_t dispatchCounts[NODES_MAX * NODES_MAX];
+TNumaPlacement placement;
+
+void setUp(void) {
+    NumaPlacement_Initialize(&placement, nodes, NODES_MAX, dispatchCounts);
+
+    for (uint32_t node = 0; node < NODES_MAX; node++) {
+        NumaPlacement_AddNode(&placement, node,
+                              objectsStorages[node], sizeof(objectsStorages[node]), sizeof(TActiveObject), QUEUE_MAX_SIZE,
+                              payloadsStorages[node], sizeof(payloadsStorages[node]), sizeof(TSample));
+    }
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_NumaPlacement_CreateObject_OnNode(void) {
+    TActiveObject *local = NumaPlacement_CreateObject(&placement, 0, 1);
+    TActiveObject *remote = NumaPlacement_CreateObject(&placement, 1, 2);
+
+    TEST_ASSERT_NOT_NULL(local);
+    TEST_ASSERT_NOT_NULL(remote);
+    TEST_ASSERT_EQUAL_UINT32(0, NumaPlacement_GetNode(&placement, local));
+    TEST_ASSERT_EQUAL_UINT32(1, NumaPlacement_GetNode(&placement, remote));
+
+    // The ring lives on the object node too
+    TEST_ASSERT_EQUAL_UINT32(1, NumaPlacement_GetNode(&placement, remote->queue.events));
+    TEST_ASSERT_EQUAL_UINT32(2, remote->id);
+}
+
+void test_NumaPlacement_CreateObject_NodeExhausted(void) {
+    for (uint32_t i = 0; i < OBJECTS_PER_NODE; i++) TEST_ASSERT_NOT_NULL(NumaPlacement_CreateObject(&placement, 0, i));
+
+    TEST_ASSERT_NULL(NumaPlacement_CreateObject(&placement, 0, OBJECTS_PER_NODE));
+    TEST_ASSERT_NULL(NumaPlacement_CreateObject(&placement, NODES_MAX, 0));
+
+    TActiveObject *object = NumaPlacement_CreateObject(&placement, 1, 0);
+    TEST_ASSERT_TRUE(NumaPlacement_DestroyObject(&placement, object));
+    TEST_ASSERT_EQUAL_PTR(object, NumaPlacement_CreateObject(&placement, 1, 0));
+}
+
+void test_NumaPlacement_Payloads_OnNode(void) {
+    TSample *sample = NumaPlacement_AllocatePayload(&placement, 1);
+
+    TEST_ASSERT_NOT_NULL(sample);
+    TEST_ASSERT_EQUAL_UINT32(1, NumaPlacement_GetNode(&placement, sample));
+    TEST_ASSERT_NOT_NULL(NumaPlacement_AllocatePayload(&placement, 1));
+    TEST_ASSERT_NULL(NumaPlacement_AllocatePayload(&placement, 1));
+
+    TEST_ASSERT_TRUE(NumaPlacement_ReleasePayload(&placement, sample));
+    TEST_ASSERT_FALSE(NumaPlacement_ReleasePayload(&placement, (uint8_t *) sample + 1));
+    TEST_ASSERT_FALSE(NumaPlacement_ReleasePayload(&placement, &placement));
+    TEST_ASSERT_EQUAL_PTR(sample, NumaPlacement_AllocatePayload(&placement, 1));
+}
+
+void test_NumaPlacement_ReleasePayload_Twice(void) {
+    TSample *sample = NumaPlacement_AllocatePayload(&placement, 0);
+
+    TEST_ASSERT_TRUE(NumaPlacement_ReleasePayload(&placement, sample));
+    TEST_ASSERT_FALSE(NumaPlacement_ReleasePayload(&placement, sample));
+    TEST_ASSERT_EQUAL_UINT32(PAYLOADS_PER_NODE, nodes[0].payloads.freeCount);
+
+    // Never allocated block
+    TEST_ASSERT_FALSE(NumaPlacement_ReleasePayload(&placement, (uint8_t *) sample + nodes[0].payloads.blockSize));
+
+    // The block is linked once: both blocks and then nothing
+    TEST_ASSERT_NOT_NULL(NumaPlacement_AllocatePayload(&placement, 0));
+    TEST_ASSERT_NOT_NULL(NumaPlacement_AllocatePayload(&placement, 0));
+    TEST_ASSERT_NULL(NumaPlacement_AllocatePayload(&placement, 0));
+}
+
+void test_NumaPlacement_Dispatch_CountsCrossNode(void) {
+    TActiveObject *local = NumaPlacement_CreateObject(&placement, 0, 1);
+    TActiveObject *remote = NumaPlacement_CreateObject(&placement, 1, 2);
+
+    TEST_ASSERT_TRUE(NumaPlacement_Dispatch(&placement, 0, local, (TEvent){.sig = EVENT_SIG_1}));
+    TEST_ASSERT_TRUE(NumaPlacement_Dispatch(&placement, 0, remote, (TEvent){.sig = EVENT_SIG_1}));
+    TEST_ASSERT_TRUE(NumaPlacement_Dispatch(&placement, 0, remote, (TEvent){.sig = EVENT_SIG_1}));
+
+    TEST_ASSERT_EQUAL_UINT64(1, dispatchCounts[0 * NODES_MAX + 0]);
+    TEST_ASSERT_EQUAL_UINT64(2, dispatchCounts[0 * NODES_MAX + 1]);
+    TEST_ASSERT_EQUAL_UINT64(2, placement.crossNodeCount);
+    TEST_ASSERT_EQUAL_UINT32(2, EventQueue_GetSize(&remote->queue));
+}
+
+void test_NumaPlacement_SingleNode(void) {
+    NumaPlacement_Initialize(&placement, nodes, 1, NULL);
+    NumaPlacement_AddNode(&placement, 0, objectsStorages[0], sizeof(objectsStorages[0]), sizeof(TActiveObject),
+                          QUEUE_MAX_SIZE, NULL, 0, 0);
+
+    TActiveObject *object = NumaPlacement_CreateObject(&placement, 0, 1);
+
+    TEST_ASSERT_TRUE(NumaPlacement_Dispatch(&placement, 0, object, (TEvent){.sig = EVENT_SIG_1}));
+    TEST_ASSERT_EQUAL_UINT64(0, placement.crossNodeCount);
+    TEST_ASSERT_NULL(NumaPlacement_AllocatePayload(&placement, 0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_NumaPlacement_CreateObject_OnNode);
+    RUN_TEST(test_NumaPlacement_CreateObject_NodeExhausted);
+    RUN_TEST(test_NumaPlacement_Payloads_OnNode);
+    RUN_TEST(test_NumaPlacement_ReleasePayload_Twice);
+    RUN_TEST(test_NumaPlacement_Dispatch_CountsCrossNode);
+    RUN_TEST(test_NumaPlacement_SingleNode);
+    return UNITY_END();
+}
@@ -0,0 +1,132 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/fsm/fsm.h"
+#include "../../src/region/region.h"
+#include "../../src/coroutine/coroutine.h"
+
+#define QUEUE_MAX_SIZE 4
+#define ACTIVE_OBJECT_ID 1
+
+typedef enum { NO_SIG, LINK_DOWN_SIG, LINK_UP_SIG, CHARGER_SIG, STEP_SIG, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+typedef enum { NO_LINK_ST, ONLINE_ST, OFFLINE_ST, LINK_STATES_MAX } TEST_LINK_STATE; // connectivity region states
+typedef enum { NO_POWER_ST, BATTERY_ST, CHARGING_ST, POWER_STATES_MAX } TEST_POWER_STATE; // power region states
+typedef enum { LINK_REGION, POWER_REGION, REGIONS_MAX } TEST_REGION; // regions names
+
+uint32_t enteredCount;
+TRegion *enteredRegion;
+
+TRegionsActiveObject activeObject;
+TRegion regions[REGIONS_MAX];
+TEvent events[QUEUE_MAX_SIZE];
+
+bool _onEnter(TActiveObject *const AO, void *const ctx) {
+    enteredCount++;
+    enteredRegion = ((TRegionsActiveObject *) AO)->activeRegion;
+    return true;
+};
+
+const TState linkStates[LINK_STATES_MAX] = {
+    [ONLINE_ST]  = {.name = ONLINE_ST, .onEnter = _onEnter},
+    [OFFLINE_ST] = {.name = OFFLINE_ST, .onEnter = _onEnter},
+};
+
+const TState powerStates[POWER_STATES_MAX] = {
+    [BATTERY_ST]  = {.name = BATTERY_ST},
+    [CHARGING_ST] = {.name = CHARGING_ST, .onEnter = _onEnter},
+};
+
+const TState* _goOffline(TActiveObject *const activeObject, TEvent event) { return &linkStates[OFFLINE_ST]; };
+const TState* _goOnline(TActiveObject *const activeObject, TEvent event) { return &linkStates[ONLINE_ST]; };
+const TState* _goBattery(TActiveObject *const activeObject, TEvent event) { return &powerStates[BATTERY_ST]; };
+const TState* _goCharging(TActiveObject *const activeObject, TEvent event) { return &powerStates[CHARGING_ST]; };
+
+// Coroutine flows of both regions suspend on the same signal: 2 steps in the link region, 3 in the power region
+const TState* _linkSteps(TActiveObject *const activeObject, TEvent event) {
+    CO_BEGIN(activeObject);
+    CO_YIELD(activeObject);
+    CO_EXIT(activeObject, &linkStates[OFFLINE_ST]);
+    CO_END(activeObject);
+};
+
+const TState* _powerSteps(TActiveObject *const activeObject, TEvent event) {
+    CO_BEGIN(activeObject);
+    CO_YIELD(activeObject);
+    CO_YIELD(activeObject);
+    CO_EXIT(activeObject, &powerStates[CHARGING_ST]);
+    CO_END(activeObject);
+};
+
+const TEventHandler linkTable[LINK_STATES_MAX][EVENTS_MAX] = {
+    [ONLINE_ST]  = { [LINK_DOWN_SIG] = _goOffline, [STEP_SIG] = _linkSteps },
+    [OFFLINE_ST] = { [LINK_UP_SIG] = _goOnline },
+};
+
+// Both regions react to LINK_DOWN_SIG: the power region falls back to battery
+const TEventHandler powerTable[POWER_STATES_MAX][EVENTS_MAX] = {
+    [BATTERY_ST]  = { [CHARGER_SIG] = _goCharging, [STEP_SIG] = _powerSteps },
+    [CHARGING_ST] = { [LINK_DOWN_SIG] = _goBattery },
+};
+
+void setUp(void) {
+    Region_Initialize(&regions[LINK_REGION], &linkStates[ONLINE_ST], LINK_STATES_MAX, EVENTS_MAX, linkTable);
+    Region_Initialize(&regions[POWER_REGION], &powerStates[BATTERY_ST], POWER_STATES_MAX, EVENTS_MAX, powerTable);
+    RegionsActiveObject_Initialize(&activeObject, ACTIVE_OBJECT_ID, events, QUEUE_MAX_SIZE, regions, REGIONS_MAX);
+    enteredCount = 0;
+    enteredRegion = NULL;
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_RegionsActiveObject_ProcessEvent_OnlyHandlingRegionTransitions(void) {
+    TEST_ASSERT_EQUAL_UINT32(1, RegionsActiveObject_ProcessEvent(&activeObject, (TEvent){.sig = CHARGER_SIG}));
+    TEST_ASSERT_EQUAL_PTR(&linkStates[ONLINE_ST], regions[LINK_REGION].state);
+    TEST_ASSERT_EQUAL_PTR(&powerStates[CHARGING_ST], regions[POWER_REGION].state);
+    TEST_ASSERT_EQUAL_PTR(&regions[POWER_REGION], enteredRegion);
+    TEST_ASSERT_NULL(activeObject.activeRegion);
+}
+
+void test_RegionsActiveObject_ProcessQueue_SameEventInEveryRegion(void) {
+    regions[POWER_REGION].state = &powerStates[CHARGING_ST];
+
+    TEST_ASSERT_TRUE(ActiveObject_Dispatch(&activeObject.super, (TEvent){.sig = LINK_DOWN_SIG}));
+    TEST_ASSERT_TRUE(RegionsActiveObject_ProcessQueue(&activeObject));
+
+    TEST_ASSERT_EQUAL_PTR(&linkStates[OFFLINE_ST], regions[LINK_REGION].state);
+    TEST_ASSERT_EQUAL_PTR(&powerStates[BATTERY_ST], regions[POWER_REGION].state);
+    TEST_ASSERT_EQUAL_UINT32(1, enteredCount);
+    TEST_ASSERT_FALSE(RegionsActiveObject_ProcessQueue(&activeObject));
+}
+
+void test_RegionsActiveObject_ProcessEvent_OutOfRangeEvent(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, RegionsActiveObject_ProcessEvent(&activeObject, (TEvent){.sig = EVENTS_MAX}));
+    TEST_ASSERT_EQUAL_UINT32(0, RegionsActiveObject_ProcessEvent(&activeObject, (TEvent){.sig = LINK_UP_SIG}));
+    TEST_ASSERT_EQUAL_PTR(&linkStates[ONLINE_ST], regions[LINK_REGION].state);
+    TEST_ASSERT_EQUAL_PTR(&powerStates[BATTERY_ST], regions[POWER_REGION].state);
+}
+
+void test_RegionsActiveObject_ProcessEvent_CoroutinePerRegion(void) {
+    // A suspended flow is a self-transition
+    TEST_ASSERT_EQUAL_UINT32(2, RegionsActiveObject_ProcessEvent(&activeObject, (TEvent){.sig = STEP_SIG}));
+    TEST_ASSERT_TRUE(0 != regions[LINK_REGION].resume);
+    TEST_ASSERT_TRUE(0 != regions[POWER_REGION].resume);
+
+    TEST_ASSERT_EQUAL_UINT32(2, RegionsActiveObject_ProcessEvent(&activeObject, (TEvent){.sig = STEP_SIG}));
+    TEST_ASSERT_EQUAL_PTR(&linkStates[OFFLINE_ST], regions[LINK_REGION].state);
+    TEST_ASSERT_EQUAL_PTR(&powerStates[BATTERY_ST], regions[POWER_REGION].state);
+    TEST_ASSERT_EQUAL_UINT32(0, regions[LINK_REGION].resume);
+
+    TEST_ASSERT_EQUAL_UINT32(1, RegionsActiveObject_ProcessEvent(&activeObject, (TEvent){.sig = STEP_SIG}));
+    TEST_ASSERT_EQUAL_PTR(&powerStates[CHARGING_ST], regions[POWER_REGION].state);
+    TEST_ASSERT_EQUAL_UINT32(0, regions[POWER_REGION].resume);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_RegionsActiveObject_ProcessEvent_OnlyHandlingRegionTransitions);
+    RUN_TEST(test_RegionsActiveObject_ProcessQueue_SameEventInEveryRegion);
+    RUN_TEST(test_RegionsActiveObject_ProcessEvent_OutOfRangeEvent);
+    RUN_TEST(test_RegionsActiveObject_ProcessEvent_CoroutinePerRegion);
+    return UNITY_END();
+}
@@ -0,0 +1,125 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/registry/registry.h"
+
+#define QUEUE_MAX_SIZE 4
+#define ACTIVE_OBJECTS_MAX (REGISTRY_SHARD_SIZE + 1)
+
+typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+
+TEvent eventArrays[ACTIVE_OBJECTS_MAX][QUEUE_MAX_SIZE];
+TActiveObject activeObjects[ACTIVE_OBJECTS_MAX];
+TRegistryShard shards[2];
+TRegistry registry;
+
+void setUp(void) {
+    for (uint32_t i = 0; i < ACTIVE_OBJECTS_MAX; i++) {
+        ActiveObject_Initialize(&activeObjects[i], i, eventArrays[i], QUEUE_MAX_SIZE);
+    }
+
+    Registry_Initialize(&registry);
+    Registry_AddShard(&registry, &shards[0]);
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Registry_Register_Lookup(void) {
+    TRegistryId id = Registry_Register(&registry, &activeObjects[0]);
+
+    TEST_ASSERT_NOT_EQUAL(REGISTRY_INVALID_ID, id);
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[0], Registry_Lookup(&registry, id));
+    TEST_ASSERT_EQUAL_UINT32(1, registry.count);
+}
+
+void test_Registry_Lookup_InvalidId(void) {
+    TEST_ASSERT_NULL(Registry_Lookup(&registry, REGISTRY_INVALID_ID));
+    TEST_ASSERT_NULL(Registry_Lookup(&registry, REGISTRY_INDEX_MASK));
+}
+
+void test_Registry_Unregister_MakesIdStale(void) {
+    TRegistryId id = Registry_Register(&registry, &activeObjects[0]);
+
+    TEST_ASSERT_TRUE(Registry_Unregister(&registry, id));
+    TEST_ASSERT_NULL(Registry_Lookup(&registry, id));
+    TEST_ASSERT_FALSE(Registry_Unregister(&registry, id));
+
+    // The slot is reused with a new generation
+    TRegistryId reusedId = Registry_Register(&registry, &activeObjects[1]);
+
+    TEST_ASSERT_EQUAL_UINT32(id & REGISTRY_INDEX_MASK, reusedId & REGISTRY_INDEX_MASK);
+    TEST_ASSERT_NOT_EQUAL(id, reusedId);
+    TEST_ASSERT_NULL(Registry_Lookup(&registry, id));
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[1], Registry_Lookup(&registry, reusedId));
+}
+
+void test_Registry_Unregister_IdStaysStaleAfterManyReuses(void) {
+    TRegistryId staleId = Registry_Register(&registry, &activeObjects[0]);
+
+    Registry_Unregister(&registry, staleId);
+
+    // The free list is LIFO, every cycle reuses the same slot
+    for (uint32_t i = 0; i < 1000; i++) {
+        TRegistryId id = Registry_Register(&registry, &activeObjects[1]);
+
+        TEST_ASSERT_EQUAL_UINT32(staleId & REGISTRY_INDEX_MASK, id & REGISTRY_INDEX_MASK);
+        TEST_ASSERT_NULL(Registry_Lookup(&registry, staleId));
+        TEST_ASSERT_FALSE(Registry_DispatchById(&registry, staleId, (TEvent){.sig = EVENT_SIG_1}));
+        TEST_ASSERT_TRUE(Registry_Unregister(&registry, id));
+    }
+}
+
+void test_Registry_Unregister_RetiresSaturatedSlot(void) {
+    TRegistryId id = Registry_Register(&registry, &activeObjects[0]);
+
+    shards[0].slots[id & REGISTRY_INDEX_MASK].generation = HANDLE_GENERATION_LAST;
+    id = Handle_Make(id & REGISTRY_INDEX_MASK, HANDLE_GENERATION_LAST);
+
+    TEST_ASSERT_TRUE(Registry_Unregister(&registry, id));
+    TEST_ASSERT_NULL(Registry_Lookup(&registry, id));
+
+    // The retired slot is never given out again
+    TRegistryId nextId = Registry_Register(&registry, &activeObjects[1]);
+
+    TEST_ASSERT_NOT_EQUAL(id & REGISTRY_INDEX_MASK, nextId & REGISTRY_INDEX_MASK);
+    TEST_ASSERT_NULL(Registry_Lookup(&registry, id));
+    TEST_ASSERT_EQUAL_UINT32(1, registry.count);
+}
+
+void test_Registry_Register_Full_AddShard(void) {
+    for (uint32_t i = 0; i < REGISTRY_SHARD_SIZE; i++) {
+        TEST_ASSERT_NOT_EQUAL(REGISTRY_INVALID_ID, Registry_Register(&registry, &activeObjects[i]));
+    }
+
+    TEST_ASSERT_EQUAL(REGISTRY_INVALID_ID, Registry_Register(&registry, &activeObjects[REGISTRY_SHARD_SIZE]));
+
+    TEST_ASSERT_TRUE(Registry_AddShard(&registry, &shards[1]));
+    TRegistryId id = Registry_Register(&registry, &activeObjects[REGISTRY_SHARD_SIZE]);
+
+    TEST_ASSERT_EQUAL_UINT32(REGISTRY_SHARD_SIZE, id & REGISTRY_INDEX_MASK);
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[REGISTRY_SHARD_SIZE], Registry_Lookup(&registry, id));
+}
+
+void test_Registry_DispatchById(void) {
+    TRegistryId id = Registry_Register(&registry, &activeObjects[2]);
+
+    TEST_ASSERT_TRUE(Registry_DispatchById(&registry, id, (TEvent){.sig = EVENT_SIG_1}));
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, ActiveObject_ProcessQueue(&activeObjects[2]).sig);
+
+    Registry_Unregister(&registry, id);
+    TEST_ASSERT_FALSE(Registry_DispatchById(&registry, id, (TEvent){.sig = EVENT_SIG_1}));
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&activeObjects[2].queue));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Registry_Register_Lookup);
+    RUN_TEST(test_Registry_Lookup_InvalidId);
+    RUN_TEST(test_Registry_Unregister_MakesIdStale);
+    RUN_TEST(test_Registry_Unregister_IdStaysStaleAfterManyReuses);
+    RUN_TEST(test_Registry_Unregister_RetiresSaturatedSlot);
+    RUN_TEST(test_Registry_Register_Full_AddShard);
+    RUN_TEST(test_Registry_DispatchById);
+    return UNITY_END();
+}
@@ -0,0 +1,219 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/request/request.h"
+
+#define QUEUE_MAX_SIZE 4
+#define REQUESTS_MAX 3
+#define TIMEOUT_TICKS 10
+
+typedef enum { NO_SIG, READ_SIG, READ_DONE_SIG, READ_TIMEOUT_SIG, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+typedef enum { NO_ST, WAITING_ST, STATES_MAX } TEST_STATE; // state names
+
+typedef struct {
+    TRequestHeader header;
+    uint32_t address;
+} TReadRequest;
+
+typedef struct {
+    TRequestHeader header;
+    uint32_t value;
+} TReadReply;
+
+TEvent clientEvents[QUEUE_MAX_SIZE];
+TEvent sensorEvents[QUEUE_MAX_SIZE];
+TActiveObject client;
+TActiveObject sensor;
+TRequestSlot slots[REQUESTS_MAX];
+TRequestTable requests;
+TReadRequest readRequests[REQUESTS_MAX];
+TReadReply readReply;
+
+void setUp(void) {
+    ActiveObject_Initialize(&client, 0, clientEvents, QUEUE_MAX_SIZE);
+    ActiveObject_Initialize(&sensor, 1, sensorEvents, QUEUE_MAX_SIZE);
+    Request_Initialize(&requests, slots, REQUESTS_MAX, TIMEOUT_TICKS, READ_TIMEOUT_SIG);
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Request_Send_Reply(void) {
+    readRequests[0].address = 0x10;
+    TRequestToken token = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[0]}, 0);
+
+    TEST_ASSERT_NOT_EQUAL(REQUEST_INVALID_TOKEN, token);
+    TEST_ASSERT_TRUE(Request_IsPending(&requests, token));
+
+    // The target reads the token from the request header
+    TEvent request = ActiveObject_ProcessQueue(&sensor);
+    TEST_ASSERT_EQUAL_INT(READ_SIG, request.sig);
+    TEST_ASSERT_EQUAL_UINT32(token, ((TRequestHeader *) request.payload)->token);
+
+    readReply.value = 42;
+    TEST_ASSERT_TRUE(Request_Reply(&requests, ((TRequestHeader *) request.payload)->token,
+                                   (TEvent){.sig = READ_DONE_SIG, .payload = &readReply}));
+
+    // The reply lands in the requester queue, tagged with the token
+    TEvent reply = ActiveObject_ProcessQueue(&client);
+    TEST_ASSERT_EQUAL_INT(READ_DONE_SIG, reply.sig);
+    TEST_ASSERT_EQUAL_UINT32(token, ((TReadReply *) reply.payload)->header.token);
+    TEST_ASSERT_EQUAL_UINT32(42, ((TReadReply *) reply.payload)->value);
+
+    TEST_ASSERT_FALSE(Request_IsPending(&requests, token));
+    TEST_ASSERT_EQUAL_UINT32(0, requests.pendingCount);
+}
+
+void test_Request_Reply_StaleToken(void) {
+    TRequestToken token = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[0]}, 0);
+
+    TEST_ASSERT_TRUE(Request_Reply(&requests, token, (TEvent){.sig = READ_DONE_SIG}));
+    TEST_ASSERT_FALSE(Request_Reply(&requests, token, (TEvent){.sig = READ_DONE_SIG}));
+    TEST_ASSERT_FALSE(Request_Reply(&requests, REQUEST_INVALID_TOKEN, (TEvent){.sig = READ_DONE_SIG}));
+
+    // The slot is reused with a new generation, the old token stays stale
+    TRequestToken reusedToken = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[1]}, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(token & REQUEST_INDEX_MASK, reusedToken & REQUEST_INDEX_MASK);
+    TEST_ASSERT_NOT_EQUAL(token, reusedToken);
+    TEST_ASSERT_FALSE(Request_IsPending(&requests, token));
+    TEST_ASSERT_TRUE(Request_IsPending(&requests, reusedToken));
+}
+
+void test_Request_Reply_TokenStaysStaleAfterManyReuses(void) {
+    TRequestToken token = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[0]}, 0);
+
+    TEST_ASSERT_TRUE(Request_Reply(&requests, token, (TEvent){.sig = READ_DONE_SIG}));
+    ActiveObject_ProcessQueue(&sensor);
+    ActiveObject_ProcessQueue(&client);
+
+    // More reuses of the slot than an 8-bit generation could tell apart
+    for (uint32_t i = 0; i < 1000; i++) {
+        TRequestToken reusedToken = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[1]}, 0);
+
+        TEST_ASSERT_EQUAL_UINT32(Handle_GetIndex(token), Handle_GetIndex(reusedToken));
+        TEST_ASSERT_FALSE(Request_IsPending(&requests, token));
+        TEST_ASSERT_TRUE(Request_Reply(&requests, reusedToken, (TEvent){.sig = READ_DONE_SIG}));
+        ActiveObject_ProcessQueue(&sensor);
+        ActiveObject_ProcessQueue(&client);
+    }
+
+    TEST_ASSERT_FALSE(Request_Reply(&requests, token, (TEvent){.sig = READ_DONE_SIG}));
+}
+
+void test_Request_Reply_RetiresSaturatedSlot(void) {
+    TRequestToken token = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[0]}, 0);
+
+    slots[Handle_GetIndex(token)].generation = HANDLE_GENERATION_LAST;
+    token = Handle_Make(Handle_GetIndex(token), HANDLE_GENERATION_LAST);
+
+    TEST_ASSERT_TRUE(Request_Reply(&requests, token, (TEvent){.sig = READ_DONE_SIG}));
+    TEST_ASSERT_FALSE(Request_IsPending(&requests, token));
+
+    // The retired slot is never given out again
+    for (uint32_t i = 1; i < REQUESTS_MAX; i++) {
+        TRequestToken nextToken = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[i]}, 0);
+
+        TEST_ASSERT_NOT_EQUAL(Handle_GetIndex(token), Handle_GetIndex(nextToken));
+    }
+
+    TReadRequest extra;
+    TEST_ASSERT_EQUAL_UINT32(REQUEST_INVALID_TOKEN,
+                             Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &extra}, 0));
+}
+
+void test_Request_Send_Full(void) {
+    for (uint32_t i = 0; i < REQUESTS_MAX; i++) {
+        TEST_ASSERT_NOT_EQUAL(REQUEST_INVALID_TOKEN,
+                              Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[i]}, 0));
+    }
+
+    TReadRequest extra;
+    TEST_ASSERT_EQUAL_UINT32(REQUEST_INVALID_TOKEN,
+                             Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &extra}, 0));
+    TEST_ASSERT_EQUAL_UINT32(REQUEST_INVALID_TOKEN,
+                             Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = NULL}, 0));
+    TEST_ASSERT_EQUAL_UINT32(REQUESTS_MAX, requests.pendingCount);
+}
+
+void test_Request_Tick_ExpiresInSendOrder(void) {
+    TRequestToken first = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[0]}, 0);
+    TRequestToken second = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[1]}, 5);
+    TRequestToken third = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[2]}, 6);
+
+    // The middle request is replied, the rest expire
+    TEST_ASSERT_TRUE(Request_Reply(&requests, second, (TEvent){.sig = READ_DONE_SIG}));
+    ActiveObject_ProcessQueue(&client);
+
+    TEST_ASSERT_EQUAL_UINT32(0, Request_Tick(&requests, TIMEOUT_TICKS - 1));
+    TEST_ASSERT_EQUAL_UINT32(1, Request_Tick(&requests, TIMEOUT_TICKS));
+
+    TEvent timeout = ActiveObject_ProcessQueue(&client);
+    TEST_ASSERT_EQUAL_INT(READ_TIMEOUT_SIG, timeout.sig);
+    TEST_ASSERT_EQUAL_UINT32(first, ((TRequestHeader *) timeout.payload)->token);
+    TEST_ASSERT_FALSE(Request_IsPending(&requests, first));
+    TEST_ASSERT_FALSE(Request_Reply(&requests, first, (TEvent){.sig = READ_DONE_SIG}));
+
+    TEST_ASSERT_EQUAL_UINT32(1, Request_Tick(&requests, 6 + TIMEOUT_TICKS));
+    TEST_ASSERT_EQUAL_UINT32(third, ((TRequestHeader *) ActiveObject_ProcessQueue(&client).payload)->token);
+    TEST_ASSERT_EQUAL_UINT32(0, requests.pendingCount);
+    TEST_ASSERT_EQUAL_UINT32(2, requests.timeoutCount);
+}
+
+void test_Request_Tick_WrapAround(void) {
+    TRequestToken token = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[0]}, UINT32_MAX - 2);
+
+    TEST_ASSERT_EQUAL_UINT32(0, Request_Tick(&requests, 2));
+    TEST_ASSERT_TRUE(Request_IsPending(&requests, token));
+    TEST_ASSERT_EQUAL_UINT32(1, Request_Tick(&requests, TIMEOUT_TICKS));
+}
+
+void test_Request_Reply_FullRequesterQueue_StaysPending(void) {
+    TRequestToken token = Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[0]}, 0);
+
+    for (uint32_t i = 0; i < QUEUE_MAX_SIZE; i++) ActiveObject_Dispatch(&client, (TEvent){.sig = READ_SIG});
+
+    TEST_ASSERT_FALSE(Request_Reply(&requests, token, (TEvent){.sig = READ_DONE_SIG}));
+    TEST_ASSERT_EQUAL_UINT32(0, Request_Tick(&requests, TIMEOUT_TICKS));
+    TEST_ASSERT_TRUE(Request_IsPending(&requests, token));
+
+    ActiveObject_ProcessQueue(&client);
+    TEST_ASSERT_TRUE(Request_Reply(&requests, token, (TEvent){.sig = READ_DONE_SIG}));
+}
+
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+// WAITING_ST handles READ_DONE_SIG only
+const TState states[STATES_MAX] = {[NO_ST] = {.name = NO_ST}, [WAITING_ST] = {.name = WAITING_ST}};
+const TSignalMask accepted[STATES_MAX][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)] = {[WAITING_ST] = {1u << READ_DONE_SIG}};
+const TSignalFilter filter = {.accepted = &accepted[0][0], .statesMax = STATES_MAX, .eventsMax = EVENTS_MAX};
+
+void test_Request_Tick_RejectedTimeout_Expires(void) {
+    Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[0]}, 0);
+    Request_Send(&requests, &client, &sensor, (TEvent){.sig = READ_SIG, .payload = &readRequests[1]}, 1);
+
+    ActiveObject_SetSignalFilter(&client, &filter);
+    client.state = &states[WAITING_ST];
+
+    // A rejected timeout doesn't stop the scan
+    TEST_ASSERT_EQUAL_UINT32(2, Request_Tick(&requests, TIMEOUT_TICKS + 1));
+    TEST_ASSERT_EQUAL_UINT32(0, requests.pendingCount);
+    TEST_ASSERT_EQUAL_UINT32(2, client.rejectedCount);
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&client.queue));
+}
+#endif
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Request_Send_Reply);
+    RUN_TEST(test_Request_Reply_StaleToken);
+    RUN_TEST(test_Request_Reply_TokenStaysStaleAfterManyReuses);
+    RUN_TEST(test_Request_Reply_RetiresSaturatedSlot);
+    RUN_TEST(test_Request_Send_Full);
+    RUN_TEST(test_Request_Tick_ExpiresInSendOrder);
+    RUN_TEST(test_Request_Tick_WrapAround);
+    RUN_TEST(test_Request_Reply_FullRequesterQueue_StaysPending);
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+    RUN_TEST(test_Request_Tick_RejectedTimeout_Expires);
+#endif
+    return UNITY_END();
+}
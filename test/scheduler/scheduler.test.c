@@ -0,0 +1,129 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/scheduler/scheduler.h"
+
+#define QUEUE_MAX_SIZE 4
+#define TASKS_MAX 3
+
+typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENT_SIG_2 = 2, EVENT_SIG_3 = 3, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+typedef enum { BULK_TASK, CONTROL_TASK, OTHER_TASK } TEST_TASK; // task ids in adding order
+typedef enum { NO_ST, CONTROL_ST, STATES_MAX } TEST_STATE; // state names
+
+TEvent eventArrays[TASKS_MAX][QUEUE_MAX_SIZE];
+uint32_t deadlines[TASKS_MAX][QUEUE_MAX_SIZE];
+TActiveObject activeObjects[TASKS_MAX];
+TSchedulerTask tasks[TASKS_MAX];
+uint32_t heap[TASKS_MAX];
+TScheduler scheduler;
+
+void setUp(void) {
+    Scheduler_Initialize(&scheduler, tasks, heap, TASKS_MAX);
+
+    for (uint32_t i = 0; i < TASKS_MAX; i++) {
+        ActiveObject_Initialize(&activeObjects[i], i, eventArrays[i], QUEUE_MAX_SIZE);
+    }
+
+    Scheduler_AddTask(&scheduler, &activeObjects[BULK_TASK], 1000, deadlines[BULK_TASK], QUEUE_MAX_SIZE);
+    Scheduler_AddTask(&scheduler, &activeObjects[CONTROL_TASK], 10, deadlines[CONTROL_TASK], QUEUE_MAX_SIZE);
+    Scheduler_AddTask(&scheduler, &activeObjects[OTHER_TASK], 100, deadlines[OTHER_TASK], QUEUE_MAX_SIZE);
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+// CONTROL_ST handles EVENT_SIG_1 only, EVENT_SIG_2 is deferrable
+const TState states[STATES_MAX] = {[NO_ST] = {.name = NO_ST}, [CONTROL_ST] = {.name = CONTROL_ST}};
+const TSignalMask accepted[STATES_MAX][ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)] = {[CONTROL_ST] = {1u << EVENT_SIG_1}};
+const TSignalMask deferrable[ACTIVE_OBJECT_SIGNAL_MASK_WORDS(EVENTS_MAX)] = {1u << EVENT_SIG_2};
+const TSignalFilter filter = {.accepted = &accepted[0][0], .deferrable = deferrable,
+                              .statesMax = STATES_MAX, .eventsMax = EVENTS_MAX};
+#endif
+
+void test_Scheduler_AddTask_NoRoom(void) {
+    TEST_ASSERT_EQUAL_UINT32(SCHEDULER_INVALID_TASK, Scheduler_AddTask(&scheduler, &activeObjects[0], 1, deadlines[0], QUEUE_MAX_SIZE));
+}
+
+void test_Scheduler_Next_EarliestHeadDeadlineFirst(void) {
+    TEvent event;
+
+    Scheduler_Dispatch(&scheduler, BULK_TASK, (TEvent){.sig = EVENT_SIG_1}, 0);
+    Scheduler_Dispatch(&scheduler, BULK_TASK, (TEvent){.sig = EVENT_SIG_2}, 0);
+    Scheduler_Dispatch(&scheduler, OTHER_TASK, (TEvent){.sig = EVENT_SIG_3}, 0);
+    Scheduler_Dispatch(&scheduler, CONTROL_TASK, (TEvent){.sig = EVENT_SIG_1}, 5);
+
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[CONTROL_TASK], Scheduler_Next(&scheduler, 5, &event));
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, event.sig);
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[OTHER_TASK], Scheduler_Next(&scheduler, 6, &event));
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[BULK_TASK], Scheduler_Next(&scheduler, 7, &event));
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, event.sig);
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[BULK_TASK], Scheduler_Next(&scheduler, 8, &event));
+    TEST_ASSERT_EQUAL(EVENT_SIG_2, event.sig);
+    TEST_ASSERT_NULL(Scheduler_Next(&scheduler, 9, &event));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.missCount);
+}
+
+void test_Scheduler_Next_CountsMissesAcrossTickWrap(void) {
+    TEvent event;
+    uint32_t now = UINT32_MAX - 5;
+
+    // Deadline wraps past 0 and is still ahead of now
+    Scheduler_Dispatch(&scheduler, CONTROL_TASK, (TEvent){.sig = EVENT_SIG_1}, now);
+    Scheduler_DispatchWithDeadline(&scheduler, OTHER_TASK, (TEvent){.sig = EVENT_SIG_2}, now + 1);
+
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[OTHER_TASK], Scheduler_Next(&scheduler, now, &event));
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[CONTROL_TASK], Scheduler_Next(&scheduler, now + 20, &event));
+
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.missCount);
+    TEST_ASSERT_EQUAL_UINT32(1, tasks[CONTROL_TASK].missCount);
+    TEST_ASSERT_EQUAL_UINT32(0, tasks[OTHER_TASK].missCount);
+}
+
+void test_Scheduler_Dispatch_QueueFull(void) {
+    for (uint32_t i = 0; i < QUEUE_MAX_SIZE; i++) {
+        TEST_ASSERT_TRUE(Scheduler_Dispatch(&scheduler, CONTROL_TASK, (TEvent){.sig = EVENT_SIG_1}, i));
+    }
+
+    TEST_ASSERT_FALSE(Scheduler_Dispatch(&scheduler, CONTROL_TASK, (TEvent){.sig = EVENT_SIG_1}, 0));
+    TEST_ASSERT_FALSE(Scheduler_Dispatch(&scheduler, TASKS_MAX, (TEvent){.sig = EVENT_SIG_1}, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.heapSize);
+}
+
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+void test_Scheduler_Dispatch_SignalFilter_DeadlinesOfEnqueuedOnly(void) {
+    TEvent deferredEventArray[QUEUE_MAX_SIZE];
+    TEvent event;
+
+    ActiveObject_InitializeDeferredQueue(&activeObjects[CONTROL_TASK], deferredEventArray, QUEUE_MAX_SIZE);
+    ActiveObject_SetSignalFilter(&activeObjects[CONTROL_TASK], &filter);
+    activeObjects[CONTROL_TASK].state = &states[CONTROL_ST];
+
+    TEST_ASSERT_FALSE(Scheduler_Dispatch(&scheduler, CONTROL_TASK, (TEvent){.sig = EVENT_SIG_3}, 0));
+    TEST_ASSERT_TRUE(Scheduler_Dispatch(&scheduler, CONTROL_TASK, (TEvent){.sig = EVENT_SIG_2}, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, tasks[CONTROL_TASK].deadlinesCount);
+    TEST_ASSERT_EQUAL_UINT32(SCHEDULER_NOT_IN_HEAP, tasks[CONTROL_TASK].heapIndex);
+
+    TEST_ASSERT_TRUE(Scheduler_Dispatch(&scheduler, CONTROL_TASK, (TEvent){.sig = EVENT_SIG_1}, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, tasks[CONTROL_TASK].deadlinesCount);
+
+    // Deadlines and queued events stay in step
+    TEST_ASSERT_EQUAL_PTR(&activeObjects[CONTROL_TASK], Scheduler_Next(&scheduler, 0, &event));
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, event.sig);
+    TEST_ASSERT_NULL(Scheduler_Next(&scheduler, 0, &event));
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&activeObjects[CONTROL_TASK].queue));
+    TEST_ASSERT_EQUAL_UINT32(1, activeObjects[CONTROL_TASK].rejectedCount);
+}
+#endif
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Scheduler_AddTask_NoRoom);
+    RUN_TEST(test_Scheduler_Next_EarliestHeadDeadlineFirst);
+    RUN_TEST(test_Scheduler_Next_CountsMissesAcrossTickWrap);
+    RUN_TEST(test_Scheduler_Dispatch_QueueFull);
+#ifdef ACTIVE_OBJECT_SIGNAL_FILTER
+    RUN_TEST(test_Scheduler_Dispatch_SignalFilter_DeadlinesOfEnqueuedOnly);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,147 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/shared_queue/shared_queue.h"
+
+#define QUEUE_CAPACITY 4
+#define PAYLOAD_MAX_SIZE 16
+
+typedef enum { NO_SIG, DATA_SIG = 1, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+
+uint64_t region[1024]; // region shared by producer and consumer handles
+TSharedQueue producer;
+TSharedQueue consumer;
+uint32_t *wokenAddress;
+
+void _wake(uint32_t *const address) { wokenAddress = address; };
+
+void setUp(void) {
+    SharedQueue_Create(&producer, region, sizeof(region), QUEUE_CAPACITY, PAYLOAD_MAX_SIZE);
+    SharedQueue_Attach(&consumer, region, sizeof(region));
+    wokenAddress = NULL;
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_SharedQueue_Create_InvalidArgs(void) {
+    TSharedQueue queue;
+    uint64_t smallRegion[8] = {0};
+
+    TEST_ASSERT_FALSE(SharedQueue_Create(&queue, region, sizeof(region), 3, PAYLOAD_MAX_SIZE));
+    TEST_ASSERT_FALSE(SharedQueue_Create(&queue, smallRegion, sizeof(smallRegion), QUEUE_CAPACITY, PAYLOAD_MAX_SIZE));
+    TEST_ASSERT_FALSE(SharedQueue_Attach(&queue, smallRegion, sizeof(smallRegion)));
+}
+
+void test_SharedQueue_Attach_InconsistentHeader(void) {
+    TSharedQueue queue;
+    TSharedQueueHeader *header = (TSharedQueueHeader *) region;
+
+    header->capacity = 3;
+    TEST_ASSERT_FALSE(SharedQueue_Attach(&queue, region, sizeof(region)));
+    header->capacity = QUEUE_CAPACITY;
+
+    header->payloadMaxSize = header->slotSize;
+    TEST_ASSERT_FALSE(SharedQueue_Attach(&queue, region, sizeof(region)));
+    header->payloadMaxSize = PAYLOAD_MAX_SIZE;
+
+    header->capacity = 1u << 31;
+    TEST_ASSERT_FALSE(SharedQueue_Attach(&queue, region, sizeof(region)));
+    header->capacity = QUEUE_CAPACITY;
+
+    header->slotsOffset = 4;
+    TEST_ASSERT_FALSE(SharedQueue_Attach(&queue, region, sizeof(region)));
+    header->slotsOffset = sizeof(TSharedQueueHeader);
+
+    TEST_ASSERT_TRUE(SharedQueue_Attach(&queue, region, sizeof(region)));
+}
+
+void test_SharedQueue_Peek_CorruptedSize(void) {
+    uint32_t data = 1;
+
+    SharedQueue_Enqueue(&producer, (TEvent){.sig = DATA_SIG, .payload = &data, .size = sizeof(data)});
+    SharedQueue_Enqueue(&producer, (TEvent){.sig = DATA_SIG, .payload = &data, .size = sizeof(data)});
+
+    // The peer rewrites the slot size and the geometry after the attach
+    ((TSharedQueueSlot *) consumer.slots)->size = UINT32_MAX;
+    ((TSharedQueueHeader *) region)->slotSize = UINT32_MAX;
+
+    TEvent event = SharedQueue_Peek(&consumer);
+
+    TEST_ASSERT_EQUAL(NO_SIG, event.sig);
+    TEST_ASSERT_NULL(event.payload);
+    TEST_ASSERT_EQUAL_UINT32(1, consumer.corruptedCount);
+
+    // The corrupted slot is released as usual, the next one is intact
+    SharedQueue_Release(&consumer);
+    event = SharedQueue_Peek(&consumer);
+
+    TEST_ASSERT_EQUAL(DATA_SIG, event.sig);
+    TEST_ASSERT_EQUAL_UINT32(1, *(uint32_t *) event.payload);
+}
+
+void test_SharedQueue_EnqueuePeek_CopiesPayloadInline(void) {
+    uint32_t data = 0xC0FFEE;
+
+    TEST_ASSERT_TRUE(SharedQueue_IsEmpty(&consumer));
+    TEST_ASSERT_TRUE(SharedQueue_Enqueue(&producer, (TEvent){.sig = DATA_SIG, .payload = &data, .size = sizeof(data)}));
+    data = 0;
+
+    TEvent event = SharedQueue_Peek(&consumer);
+
+    TEST_ASSERT_EQUAL(DATA_SIG, event.sig);
+    TEST_ASSERT_EQUAL_size_t(sizeof(data), event.size);
+    TEST_ASSERT_EQUAL_UINT32(0xC0FFEE, *(uint32_t *) event.payload);
+    TEST_ASSERT_TRUE((uint8_t *) event.payload > (uint8_t *) region);
+
+    SharedQueue_Release(&consumer);
+    TEST_ASSERT_TRUE(SharedQueue_IsEmpty(&consumer));
+    TEST_ASSERT_EQUAL(NO_SIG, SharedQueue_Peek(&consumer).sig);
+}
+
+void test_SharedQueue_Enqueue_FullOrTooBigPayload(void) {
+    uint8_t bigPayload[PAYLOAD_MAX_SIZE + 1];
+
+    TEST_ASSERT_FALSE(SharedQueue_Enqueue(&producer, (TEvent){.sig = DATA_SIG, .payload = bigPayload, .size = sizeof(bigPayload)}));
+
+    for (int i = 0; i < QUEUE_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(SharedQueue_Enqueue(&producer, (TEvent){.sig = i}));
+    }
+    TEST_ASSERT_FALSE(SharedQueue_Enqueue(&producer, (TEvent){.sig = DATA_SIG}));
+
+    for (int i = 0; i < QUEUE_CAPACITY; i++) {
+        TEST_ASSERT_EQUAL(i, SharedQueue_Peek(&consumer).sig);
+        TEST_ASSERT_NULL(SharedQueue_Peek(&consumer).payload);
+        SharedQueue_Release(&consumer);
+    }
+}
+
+void test_SharedQueue_PrepareWait_WakesSleepingConsumer(void) {
+    uint32_t *address = NULL;
+    uint32_t expected = 1;
+
+    SharedQueue_SetWake(&producer, _wake);
+
+    // No wakeup while the consumer doesn't sleep
+    SharedQueue_Enqueue(&producer, (TEvent){.sig = DATA_SIG});
+    TEST_ASSERT_NULL(wokenAddress);
+    TEST_ASSERT_FALSE(SharedQueue_PrepareWait(&consumer, &address, &expected));
+    SharedQueue_Release(&consumer);
+
+    TEST_ASSERT_TRUE(SharedQueue_PrepareWait(&consumer, &address, &expected));
+    TEST_ASSERT_EQUAL_UINT32(1, expected);
+
+    SharedQueue_Enqueue(&producer, (TEvent){.sig = DATA_SIG});
+    TEST_ASSERT_EQUAL_PTR(address, wokenAddress);
+    TEST_ASSERT_NOT_EQUAL(expected, *address);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_SharedQueue_Create_InvalidArgs);
+    RUN_TEST(test_SharedQueue_Attach_InconsistentHeader);
+    RUN_TEST(test_SharedQueue_Peek_CorruptedSize);
+    RUN_TEST(test_SharedQueue_EnqueuePeek_CopiesPayloadInline);
+    RUN_TEST(test_SharedQueue_Enqueue_FullOrTooBigPayload);
+    RUN_TEST(test_SharedQueue_PrepareWait_WakesSleepingConsumer);
+    return UNITY_END();
+}
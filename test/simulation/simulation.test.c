@@ -0,0 +1,253 @@
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/fsm/fsm.h"
+#include "../../src/simulation/simulation.h"
+
+#define QUEUE_MAX_SIZE 4
+#define CALENDAR_MAX 256
+#define OBJECTS_MAX 2
+#define LOG_MAX 256
+#define BLINK_PERIOD 500
+
+typedef enum { NO_SIG, START_SIG, TIMEOUT_SIG, PING_SIG, PONG_SIG, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+
+typedef enum { NO_STATE, STATE_OFF, STATE_ON, STATES_MAX } TEST_STATE_NAME;
+
+bool startBlinkTimer(TActiveObject *const activeObject, void *const ctx);
+const TState *toggle(TActiveObject *const activeObject, TEvent event);
+const TState *record(TActiveObject *const activeObject, TEvent event);
+const TState *ping(TActiveObject *const activeObject, TEvent event);
+
+const TState states[STATES_MAX] = {
+        [NO_STATE] = EMPTY_STATE,
+        [STATE_OFF] = {.name = STATE_OFF, .onEnter = startBlinkTimer},
+        [STATE_ON] = {.name = STATE_ON, .onEnter = startBlinkTimer},
+};
+
+const TEventHandler transitionTable[STATES_MAX][EVENTS_MAX] = {
+        [STATE_OFF] = {[START_SIG] = toggle, [TIMEOUT_SIG] = toggle, [PING_SIG] = ping, [PONG_SIG] = record},
+        [STATE_ON] = {[TIMEOUT_SIG] = toggle, [PING_SIG] = record, [PONG_SIG] = record},
+};
+
+TSimulationEvent calendar[CALENDAR_MAX];
+TSimulationObject objects[OBJECTS_MAX];
+TSimulation simulation;
+TEvent eventArrays[OBJECTS_MAX][QUEUE_MAX_SIZE];
+TActiveObject blinky;
+TActiveObject peer;
+uint32_t togglesCount;
+uint64_t logTimes[LOG_MAX];
+uintptr_t logValues[LOG_MAX];
+uint32_t logCount;
+
+bool startBlinkTimer(TActiveObject *const activeObject, void *const ctx) {
+    return SIMULATION_INVALID_TIMER != Simulation_Schedule(&simulation, activeObject, (TEvent) {.sig = TIMEOUT_SIG}, BLINK_PERIOD);
+}
+
+const TState *toggle(TActiveObject *const activeObject, TEvent event) {
+    togglesCount++;
+    return &states[STATE_ON == activeObject->state->name ? STATE_OFF : STATE_ON];
+}
+
+const TState *record(TActiveObject *const activeObject, TEvent event) {
+    logTimes[logCount] = Simulation_Now(&simulation);
+    logValues[logCount++] = (uintptr_t) event.payload;
+    return &states[NO_STATE];
+}
+
+// Replies right away with a direct dispatch and later with a zero-delay timer
+const TState *ping(TActiveObject *const activeObject, TEvent event) {
+    ActiveObject_Dispatch(&blinky, (TEvent) {.sig = PONG_SIG, .payload = (void *) 1});
+    Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG, .payload = (void *) 2}, 0);
+    return &states[NO_STATE];
+}
+
+void setUp(void) {
+    togglesCount = 0;
+    logCount = 0;
+
+    ActiveObject_Initialize(&blinky, 0, eventArrays[0], QUEUE_MAX_SIZE);
+    ActiveObject_Initialize(&peer, 1, eventArrays[1], QUEUE_MAX_SIZE);
+    blinky.state = &states[STATE_OFF];
+    peer.state = &states[STATE_OFF];
+
+    Simulation_Initialize(&simulation, calendar, CALENDAR_MAX, objects, OBJECTS_MAX);
+    Simulation_AddObject(&simulation, &blinky, STATES_MAX, EVENTS_MAX, &transitionTable[0][0]);
+    Simulation_AddObject(&simulation, &peer, STATES_MAX, EVENTS_MAX, &transitionTable[0][0]);
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Simulation_Run_JumpsToTimers(void) {
+    Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = START_SIG}, 0);
+
+    // START at 0, then a toggle every period up to and including 10 periods
+    TEST_ASSERT_EQUAL_UINT64(11, Simulation_Run(&simulation, 10 * BLINK_PERIOD));
+    TEST_ASSERT_EQUAL_UINT32(11, togglesCount);
+    TEST_ASSERT_EQUAL_PTR(&states[STATE_ON], blinky.state);
+    TEST_ASSERT_EQUAL_UINT64(10 * BLINK_PERIOD, Simulation_Now(&simulation));
+
+    // The clock moves to the horizon between timers
+    Simulation_Run(&simulation, 10 * BLINK_PERIOD + 1);
+    TEST_ASSERT_EQUAL_UINT64(10 * BLINK_PERIOD + 1, Simulation_Now(&simulation));
+    TEST_ASSERT_EQUAL_UINT32(1, simulation.pendingCount);
+}
+
+void test_Simulation_Run_EqualTimesInScheduleOrder(void) {
+    uint64_t delays[8] = {30, 10, 20, 10, 30, 0, 10, 20};
+
+    for (uintptr_t i = 0; i < 8; i++) {
+        Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG, .payload = (void *) i}, delays[i]);
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(8, Simulation_Run(&simulation, SIMULATION_FOREVER));
+
+    uintptr_t expected[8] = {5, 1, 3, 6, 2, 7, 0, 4};
+    for (uint32_t i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_UINT64(delays[expected[i]], logTimes[i]);
+        TEST_ASSERT_EQUAL_UINT32(expected[i], logValues[i]);
+    }
+
+    // The calendar ran empty, the clock stays at the last event
+    TEST_ASSERT_EQUAL_UINT64(30, Simulation_Now(&simulation));
+}
+
+void test_Simulation_Run_ManyTimersInOrder(void) {
+    uint32_t random = 12345;
+
+    for (uint32_t i = 0; i < CALENDAR_MAX; i++) {
+        random = random * 1103515245u + 12345u;
+        Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, (random >> 16) % 1000);
+    }
+
+    Simulation_Run(&simulation, SIMULATION_FOREVER);
+
+    TEST_ASSERT_EQUAL_UINT32(CALENDAR_MAX, logCount);
+    for (uint32_t i = 1; i < logCount; i++) TEST_ASSERT_LESS_OR_EQUAL(logTimes[i], logTimes[i - 1]);
+}
+
+void test_Simulation_Cancel(void) {
+    TSimulationTimer first = Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG, .payload = (void *) 1}, 10);
+    TSimulationTimer second = Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG, .payload = (void *) 2}, 20);
+
+    TEST_ASSERT_TRUE(Simulation_Cancel(&simulation, first));
+    TEST_ASSERT_FALSE(Simulation_Cancel(&simulation, first));
+    TEST_ASSERT_FALSE(Simulation_Cancel(&simulation, SIMULATION_INVALID_TIMER));
+    TEST_ASSERT_EQUAL_UINT32(1, simulation.pendingCount);
+
+    Simulation_Run(&simulation, SIMULATION_FOREVER);
+
+    TEST_ASSERT_EQUAL_UINT32(1, logCount);
+    TEST_ASSERT_EQUAL_UINT32(2, logValues[0]);
+
+    // Fired timer token is stale, even when its node is reused
+    TEST_ASSERT_FALSE(Simulation_Cancel(&simulation, second));
+    Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 10);
+    Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 10);
+    TEST_ASSERT_FALSE(Simulation_Cancel(&simulation, second));
+}
+
+void test_Simulation_Cancel_FreesNodeAndKeepsOrder(void) {
+    TSimulationTimer timers[CALENDAR_MAX];
+    uint32_t random = 12345;
+
+    for (uint32_t i = 0; i < CALENDAR_MAX; i++) {
+        random = random * 1103515245u + 12345u;
+        timers[i] = Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, (random >> 16) % 1000);
+    }
+
+    // Canceled nodes leave the calendar right away, from the root and from inside the heap
+    for (uint32_t i = 0; i < CALENDAR_MAX; i += 3) TEST_ASSERT_TRUE(Simulation_Cancel(&simulation, timers[i]));
+    for (uint32_t i = 0; i < CALENDAR_MAX; i += 3) {
+        TEST_ASSERT_NOT_EQUAL(SIMULATION_INVALID_TIMER, Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 1000 + i));
+    }
+    TEST_ASSERT_EQUAL(SIMULATION_INVALID_TIMER, Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 1000));
+
+    Simulation_Run(&simulation, SIMULATION_FOREVER);
+
+    TEST_ASSERT_EQUAL_UINT32(CALENDAR_MAX, logCount);
+    for (uint32_t i = 1; i < logCount; i++) TEST_ASSERT_LESS_OR_EQUAL(logTimes[i], logTimes[i - 1]);
+    TEST_ASSERT_EQUAL_UINT64(1000 + CALENDAR_MAX - 1, logTimes[logCount - 1]);
+}
+
+void test_Simulation_Cancel_TokenStaysStaleAndSaturatedNodeRetires(void) {
+    TSimulationEvent smallCalendar[1];
+
+    Simulation_Initialize(&simulation, smallCalendar, 1, objects, OBJECTS_MAX);
+    TSimulationTimer timer = Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 10);
+
+    // More reuses of the node than an 8-bit generation could tell apart
+    for (uint32_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(Simulation_Cancel(&simulation, timer));
+        TSimulationTimer reused = Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 10);
+
+        TEST_ASSERT_FALSE(Simulation_Cancel(&simulation, timer));
+        timer = reused;
+    }
+
+    smallCalendar[0].generation = HANDLE_GENERATION_LAST;
+    timer = Handle_Make(0, HANDLE_GENERATION_LAST);
+
+    TEST_ASSERT_TRUE(Simulation_Cancel(&simulation, timer));
+    TEST_ASSERT_EQUAL(SIMULATION_INVALID_TIMER, Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 10));
+}
+
+void test_Simulation_Run_EmptyCalendarMovesToHorizon(void) {
+    TEST_ASSERT_EQUAL_UINT64(0, Simulation_Run(&simulation, 100));
+    TEST_ASSERT_EQUAL_UINT64(100, Simulation_Now(&simulation));
+
+    Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 10);
+    Simulation_Run(&simulation, 200);
+    TEST_ASSERT_EQUAL_UINT64(200, Simulation_Now(&simulation));
+    TEST_ASSERT_EQUAL_UINT64(110, logTimes[0]);
+}
+
+void test_Simulation_Run_DispatchesBetweenObjectsAtCurrentTime(void) {
+    Simulation_Schedule(&simulation, &peer, (TEvent) {.sig = PING_SIG}, 100);
+
+    TEST_ASSERT_EQUAL_UINT64(3, Simulation_Run(&simulation, SIMULATION_FOREVER));
+
+    TEST_ASSERT_EQUAL_UINT32(2, logCount);
+    TEST_ASSERT_EQUAL_UINT32(1, logValues[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, logValues[1]);
+    TEST_ASSERT_EQUAL_UINT64(100, logTimes[1]);
+}
+
+void test_Simulation_Limits(void) {
+    TSimulationEvent smallCalendar[1];
+
+    Simulation_Initialize(&simulation, smallCalendar, 1, objects, 1);
+
+    TEST_ASSERT_TRUE(Simulation_AddObject(&simulation, &blinky, STATES_MAX, EVENTS_MAX, &transitionTable[0][0]));
+    TEST_ASSERT_FALSE(Simulation_AddObject(&simulation, &peer, STATES_MAX, EVENTS_MAX, &transitionTable[0][0]));
+    TEST_ASSERT_NOT_EQUAL(SIMULATION_INVALID_TIMER, Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 1));
+    TEST_ASSERT_EQUAL(SIMULATION_INVALID_TIMER, Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 1));
+    TEST_ASSERT_EQUAL(SIMULATION_INVALID_TIMER, Simulation_Schedule(&simulation, NULL, (TEvent) {.sig = PONG_SIG}, 1));
+}
+
+void test_Simulation_Run_DropsOnFullQueue(void) {
+    for (uint32_t i = 0; i <= QUEUE_MAX_SIZE; i++) {
+        Simulation_Schedule(&simulation, &blinky, (TEvent) {.sig = PONG_SIG}, 1);
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(QUEUE_MAX_SIZE, Simulation_Run(&simulation, SIMULATION_FOREVER));
+    TEST_ASSERT_EQUAL_UINT32(1, simulation.droppedCount);
+    TEST_ASSERT_EQUAL_UINT32(0, simulation.pendingCount);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Simulation_Run_JumpsToTimers);
+    RUN_TEST(test_Simulation_Run_EqualTimesInScheduleOrder);
+    RUN_TEST(test_Simulation_Run_ManyTimersInOrder);
+    RUN_TEST(test_Simulation_Cancel);
+    RUN_TEST(test_Simulation_Cancel_FreesNodeAndKeepsOrder);
+    RUN_TEST(test_Simulation_Cancel_TokenStaysStaleAndSaturatedNodeRetires);
+    RUN_TEST(test_Simulation_Run_EmptyCalendarMovesToHorizon);
+    RUN_TEST(test_Simulation_Run_DispatchesBetweenObjectsAtCurrentTime);
+    RUN_TEST(test_Simulation_Limits);
+    RUN_TEST(test_Simulation_Run_DropsOnFullQueue);
+    return UNITY_END();
+}
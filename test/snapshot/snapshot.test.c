@@ -0,0 +1,206 @@
+#include <string.h>
+
+#include "../../libraries/Unity/src/unity.h"
+#include "../../src/active_object/active_object.h"
+#include "../../src/registry/registry.h"
+#include "../../src/snapshot/snapshot.h"
+
+#define QUEUE_MAX_SIZE 4
+#define ACTIVE_OBJECTS_MAX 3
+
+typedef enum { NO_SIG, EVENT_SIG_1 = 1, EVENT_SIG_2 = 2, EVENTS_MAX } TEST_EVENT_SIG; // event signals names
+typedef enum { NO_STATE, STATE_1 = 1, STATE_2 = 2, STATES_MAX } TEST_STATE; // state names
+
+// sub Active Object with user fields
+typedef struct {
+    TActiveObject super;
+    uint32_t counter;
+} TSubActiveObject;
+
+const TState statesList[STATES_MAX] = {
+    [STATE_1] = {.name = STATE_1},
+    [STATE_2] = {.name = STATE_2},
+};
+
+TEvent eventArrays[ACTIVE_OBJECTS_MAX][QUEUE_MAX_SIZE];
+TEvent deferredEventArrays[ACTIVE_OBJECTS_MAX][QUEUE_MAX_SIZE];
+TSubActiveObject activeObjects[ACTIVE_OBJECTS_MAX];
+TRegistryShard shard;
+TRegistry registry;
+uint64_t image[256];
+
+TEvent restoredEvents[QUEUE_MAX_SIZE];
+TEvent restoredDeferredEvents[QUEUE_MAX_SIZE];
+TSubActiveObject restored;
+TSnapshot snapshot;
+
+size_t _saveCounter(const TActiveObject *const activeObject, uint8_t *buffer, size_t bufferSize, void *const ctx) {
+    const TSubActiveObject *subActiveObject = (const TSubActiveObject *) activeObject;
+
+    if (bufferSize >= sizeof(subActiveObject->counter)) memcpy(buffer, &subActiveObject->counter, sizeof(subActiveObject->counter));
+    return sizeof(subActiveObject->counter);
+}
+
+bool _loadCounter(TActiveObject *const activeObject, const uint8_t *fields, size_t size, void *const ctx) {
+    if (sizeof(uint32_t) != size) return false;
+
+    memcpy(&((TSubActiveObject *) activeObject)->counter, fields, size);
+    return true;
+}
+
+void setUp(void) {
+    Registry_Initialize(&registry);
+    Registry_AddShard(&registry, &shard);
+
+    // Registered in reverse id order, the image index is sorted anyway
+    for (uint32_t i = 0; i < ACTIVE_OBJECTS_MAX; i++) {
+        TSubActiveObject *subActiveObject = &activeObjects[i];
+
+        ActiveObject_Initialize(&subActiveObject->super, 100 - i, eventArrays[i], QUEUE_MAX_SIZE);
+        ActiveObject_InitializeDeferredQueue(&subActiveObject->super, deferredEventArrays[i], QUEUE_MAX_SIZE);
+        subActiveObject->counter = 10 + i;
+        Registry_Register(&registry, &subActiveObject->super);
+    }
+
+    memset(image, 0, sizeof(image));
+    memset(&restored, 0, sizeof(restored));
+}
+
+void tearDown(void) {
+    // Nothing to tear down in this case
+}
+
+void test_Snapshot_WriteRestore_StateQueuesAndFields(void) {
+    uint32_t payload = 0xBEEF;
+    TActiveObject *source = &activeObjects[1].super;
+
+    source->state = &statesList[STATE_2];
+    source->resume = 42;
+    ActiveObject_Dispatch(source, (TEvent){.sig = EVENT_SIG_1, .payload = &payload, .size = sizeof(payload)});
+    ActiveObject_Dispatch(source, (TEvent){.sig = EVENT_SIG_2});
+    ActiveObject_Defer(source, (TEvent){.sig = EVENT_SIG_2});
+
+    size_t imageSize = Snapshot_Write(&registry, image, sizeof(image), _saveCounter, NULL);
+    TEST_ASSERT_NOT_EQUAL(0, imageSize);
+    payload = 0;
+
+    TEST_ASSERT_TRUE(Snapshot_Open(&snapshot, image, imageSize));
+    TEST_ASSERT_EQUAL_UINT32(ACTIVE_OBJECTS_MAX, snapshot.count);
+
+    ActiveObject_Initialize(&restored.super, source->id, restoredEvents, QUEUE_MAX_SIZE);
+    ActiveObject_InitializeDeferredQueue(&restored.super, restoredDeferredEvents, QUEUE_MAX_SIZE);
+
+    TEST_ASSERT_TRUE(Snapshot_Restore(&snapshot, &restored.super, statesList, STATES_MAX, _loadCounter, NULL));
+    TEST_ASSERT_EQUAL_PTR(&statesList[STATE_2], restored.super.state);
+    TEST_ASSERT_EQUAL_UINT32(42, restored.super.resume);
+    TEST_ASSERT_EQUAL_UINT32(11, restored.counter);
+    TEST_ASSERT_EQUAL_UINT32(2, EventQueue_GetSize(&restored.super.queue));
+    TEST_ASSERT_EQUAL_UINT32(1, EventQueue_GetSize(&restored.super.deferredQueue));
+
+    TEvent event = ActiveObject_ProcessQueue(&restored.super);
+    TEST_ASSERT_EQUAL(EVENT_SIG_1, event.sig);
+    TEST_ASSERT_EQUAL_size_t(sizeof(payload), event.size);
+    TEST_ASSERT_EQUAL_UINT32(0xBEEF, *(uint32_t *) event.payload);
+
+    event = ActiveObject_ProcessQueue(&restored.super);
+    TEST_ASSERT_EQUAL(EVENT_SIG_2, event.sig);
+    TEST_ASSERT_NULL(event.payload);
+}
+
+void test_Snapshot_Restore_NoStateAndUnknownId(void) {
+    size_t imageSize = Snapshot_Write(&registry, image, sizeof(image), NULL, NULL);
+
+    TEST_ASSERT_TRUE(Snapshot_Open(&snapshot, image, imageSize));
+
+    ActiveObject_Initialize(&restored.super, 98, restoredEvents, QUEUE_MAX_SIZE);
+    restored.super.state = &statesList[STATE_1];
+    TEST_ASSERT_TRUE(Snapshot_Restore(&snapshot, &restored.super, statesList, STATES_MAX, NULL, NULL));
+    TEST_ASSERT_NULL(restored.super.state);
+
+    ActiveObject_Initialize(&restored.super, 7, restoredEvents, QUEUE_MAX_SIZE);
+    TEST_ASSERT_FALSE(Snapshot_Restore(&snapshot, &restored.super, statesList, STATES_MAX, NULL, NULL));
+}
+
+void test_Snapshot_Restore_QueueTooSmall(void) {
+    TActiveObject *source = &activeObjects[0].super;
+
+    ActiveObject_Dispatch(source, (TEvent){.sig = EVENT_SIG_1});
+    ActiveObject_Dispatch(source, (TEvent){.sig = EVENT_SIG_1});
+
+    size_t imageSize = Snapshot_Write(&registry, image, sizeof(image), NULL, NULL);
+    TEST_ASSERT_TRUE(Snapshot_Open(&snapshot, image, imageSize));
+
+    ActiveObject_Initialize(&restored.super, source->id, restoredEvents, 1);
+    TEST_ASSERT_FALSE(Snapshot_Restore(&snapshot, &restored.super, statesList, STATES_MAX, NULL, NULL));
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&restored.super.queue));
+}
+
+TEvent grownEvents[QUEUE_MAX_SIZE * 2];
+
+TEvent *_allocateEvents(uint32_t capacity, void *const ctx) {
+    return capacity <= QUEUE_MAX_SIZE * 2 ? grownEvents : NULL;
+}
+
+void _releaseEvents(TEvent *events, uint32_t capacity, void *const ctx) {
+    // Static ring, nothing to release
+}
+
+void test_Snapshot_Restore_GrowableQueue(void) {
+    TActiveObject *source = &activeObjects[0].super;
+    TEventQueueGrowth growth;
+
+    for (uint32_t i = 0; i < QUEUE_MAX_SIZE; i++) ActiveObject_Dispatch(source, (TEvent){.sig = EVENT_SIG_1});
+
+    size_t imageSize = Snapshot_Write(&registry, image, sizeof(image), NULL, NULL);
+    TEST_ASSERT_TRUE(Snapshot_Open(&snapshot, image, imageSize));
+
+    // The initial ring of a single event grows to hold the restored events
+    ActiveObject_Initialize(&restored.super, source->id, restoredEvents, 1);
+    EventQueue_SetGrowth(&restored.super.queue, &growth, _allocateEvents, _releaseEvents, QUEUE_MAX_SIZE * 2, NULL);
+
+    TEST_ASSERT_TRUE(Snapshot_Restore(&snapshot, &restored.super, statesList, STATES_MAX, NULL, NULL));
+    TEST_ASSERT_EQUAL_UINT32(QUEUE_MAX_SIZE, EventQueue_GetSize(&restored.super.queue));
+
+    // No room for the events in a queue which can't grow enough
+    memset(&restored, 0, sizeof(restored));
+    ActiveObject_Initialize(&restored.super, source->id, restoredEvents, 1);
+    EventQueue_SetGrowth(&restored.super.queue, &growth, _allocateEvents, _releaseEvents, QUEUE_MAX_SIZE - 2, NULL);
+
+    TEST_ASSERT_FALSE(Snapshot_Restore(&snapshot, &restored.super, statesList, STATES_MAX, NULL, NULL));
+    TEST_ASSERT_TRUE(EventQueue_IsEmpty(&restored.super.queue));
+}
+
+void test_Snapshot_Write_DuplicateIds(void) {
+    activeObjects[2].super.id = activeObjects[0].super.id;
+
+    TEST_ASSERT_EQUAL_size_t(0, Snapshot_Write(&registry, image, sizeof(image), NULL, NULL));
+}
+
+void test_Snapshot_Write_BufferTooSmall(void) {
+    TEST_ASSERT_EQUAL_size_t(0, Snapshot_Write(&registry, image, 32, NULL, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, Snapshot_Write(&registry, image, 80, _saveCounter, NULL));
+}
+
+void test_Snapshot_Open_InvalidImage(void) {
+    size_t imageSize = Snapshot_Write(&registry, image, sizeof(image), NULL, NULL);
+
+    TEST_ASSERT_FALSE(Snapshot_Open(&snapshot, image, imageSize - 1));
+
+    ((TSnapshotHeader *) image)->version = SNAPSHOT_VERSION + 1;
+    TEST_ASSERT_FALSE(Snapshot_Open(&snapshot, image, imageSize));
+
+    ((TSnapshotHeader *) image)->magic = 0;
+    TEST_ASSERT_FALSE(Snapshot_Open(&snapshot, image, imageSize));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_Snapshot_WriteRestore_StateQueuesAndFields);
+    RUN_TEST(test_Snapshot_Restore_NoStateAndUnknownId);
+    RUN_TEST(test_Snapshot_Restore_QueueTooSmall);
+    RUN_TEST(test_Snapshot_Restore_GrowableQueue);
+    RUN_TEST(test_Snapshot_Write_DuplicateIds);
+    RUN_TEST(test_Snapshot_Write_BufferTooSmall);
+    RUN_TEST(test_Snapshot_Open_InvalidImage);
+    return UNITY_END();
+}
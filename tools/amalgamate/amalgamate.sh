@@ -0,0 +1,83 @@
+#!/bin/sh
+# Generates a single-header amalgamation of src/: all module headers followed by all module sources,
+# public functions become AO_API (static inline by default) and module globals become static, so the
+# translation unit including the header can inline the queue and dispatch hot paths.
+# Include the header in one translation unit only: every other one gets its own copy of the module globals.
+#
+# Usage: tools/amalgamate/amalgamate.sh <src dir> <output header>
+#
+# Rewriting rules, relying on the repo naming conventions:
+# - local "..." includes are dropped, modules are concatenated in the dependency order;
+# - column 0 declarations and definitions of MODULE_PascalCase functions get the AO_API prefix,
+#   the "inline" of fsm.c definitions is dropped in favour of it;
+# - column 0 module globals in sources become static;
+# - private _camelCase helpers of a source get the module prefix, helpers of different modules share names.
+
+set -e
+
+SRC_DIR=${1:-src}
+OUTPUT=${2:-build/active_object_amalgamated.h}
+
+# Dependency order, the rest of the modules depend on these only
+CORE_MODULES="handle event_queue active_object fsm registry"
+
+MODULES=$CORE_MODULES
+for dir in "$SRC_DIR"/*/; do
+    module=$(basename "$dir")
+    case " $CORE_MODULES " in
+        *" $module "*) ;;
+        *) MODULES="$MODULES $module" ;;
+    esac
+done
+
+FUNCTION_PATTERN='^\(const \)\{0,1\}[A-Za-z_][A-Za-z0-9_]*[ *]\{1,3\}[A-Z][A-Za-z]*_[A-Za-z]*('
+
+mkdir -p "$(dirname "$OUTPUT")"
+
+{
+    echo "/**"
+    echo " * @file $(basename "$OUTPUT")"
+    echo " *"
+    echo " * @brief Single-header amalgamation of the Active Object library, generated by tools/amalgamate, do not edit"
+    echo " *"
+    echo " * @details Public functions are AO_API (static inline unless defined before the include),"
+    echo " * the compiler inlines the hot paths into the including translation unit."
+    echo " * Modules: $MODULES"
+    echo " * @warning Include in one translation unit only: module globals are static, every other"
+    echo " * translation unit gets its own FSM profiles list and sentinel states."
+    echo " */"
+    echo
+    echo "#ifndef ACTIVE_OBJECT_AMALGAMATED_H"
+    echo "#define ACTIVE_OBJECT_AMALGAMATED_H"
+    echo
+    echo "#ifndef AO_API"
+    echo "#define AO_API static inline"
+    echo "#endif"
+
+    for module in $MODULES; do
+        for header in "$SRC_DIR/$module"/*.h; do
+            echo
+            echo "/* ---- $module/$(basename "$header") ---- */"
+            sed -e '/^#include "/d' \
+                -e "s/$FUNCTION_PATTERN/AO_API &/" \
+                "$header"
+        done
+    done
+
+    for module in $MODULES; do
+        for source in "$SRC_DIR/$module"/*.c; do
+            [ -f "$source" ] || continue
+            echo
+            echo "/* ---- $module/$(basename "$source") ---- */"
+            sed -e '/^#include "/d' \
+                -e 's/^inline //' \
+                -e "s/$FUNCTION_PATTERN/AO_API &/" \
+                -e 's/^\(const \)\{0,1\}\(T[A-Za-z]* [a-z][A-Za-z]* =\)/static &/' \
+                -e "s/\\b_\\([A-Za-z][A-Za-z0-9]*\\)/_${module}_\\1/g" \
+                "$source"
+        done
+    done
+
+    echo
+    echo "#endif //ACTIVE_OBJECT_AMALGAMATED_H"
+} > "$OUTPUT"
@@ -0,0 +1,133 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "stdio.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "time.h"
+
+#ifdef BENCHMARK_AMALGAMATION
+#include "active_object_amalgamated.h"
+#else
+#include "../../src/active_object/active_object.h"
+#include "../../src/fsm/fsm.h"
+#include "../../src/dispatch_stage/dispatch_stage.h"
+#endif
+
+/* Hot path micro-benchmark: the same source is built against the -O0 sources, the -O3 LTO library
+ * and the single-header amalgamation, to compare the cost of cross translation unit calls.
+ * Prints ns per operation of every scenario as JSON. */
+
+#define QUEUE_CAPACITY      (16)
+#define STATES_MAX          (2)
+#define EVENTS_MAX          (2)
+#define STAGE_TARGETS       (4)
+#define STAGE_EVENTS        (8)
+
+enum { NO_SIG, TOGGLE_SIG };
+
+const TState states[STATES_MAX] = {{.name = 0}, {.name = 1}};
+TActiveObject activeObjects[STAGE_TARGETS];
+TEvent events[STAGE_TARGETS][QUEUE_CAPACITY];
+TDispatchStageEntry stageEntries[STAGE_EVENTS];
+TEvent stageScratch[STAGE_EVENTS];
+TDispatchStage stage;
+
+volatile uint64_t sink;
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static const TState *toggleHandler(TActiveObject *const activeObject, TEvent event) {
+    return &states[1 - activeObject->state->name];
+}
+
+const TEventHandler transitionTable[STATES_MAX][EVENTS_MAX] = {
+        {NULL, toggleHandler},
+        {NULL, toggleHandler},
+};
+
+static void reset(void) {
+    for (uint32_t i = 0; i < STAGE_TARGETS; i++) {
+        ActiveObject_Initialize(&activeObjects[i], i, events[i], QUEUE_CAPACITY);
+        activeObjects[i].state = &states[0];
+    }
+}
+
+/* Enqueue and dequeue of a single event */
+static double benchQueue(uint64_t iterations) {
+    TEventQueue *queue = &activeObjects[0].queue;
+    uint64_t sum = 0;
+    uint64_t start = nowNs();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        EventQueue_Enqueue(queue, (TEvent){.sig = TOGGLE_SIG});
+        sum += (uint64_t)EventQueue_Dequeue(queue).sig;
+    }
+
+    sink = sum;
+    return (double)(nowNs() - start) / (double)iterations;
+}
+
+/* Dispatch, dequeue, transition table lookup and traversal of a single event */
+static double benchDispatch(uint64_t iterations) {
+    TActiveObject *activeObject = &activeObjects[0];
+    uint64_t start = nowNs();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        ActiveObject_Dispatch(activeObject, (TEvent){.sig = TOGGLE_SIG});
+        TEvent event = ActiveObject_ProcessQueue(activeObject);
+        const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(
+                activeObject, event, STATES_MAX, EVENTS_MAX, transitionTable);
+        FSM_TraverseAOToNextState(activeObject, nextState);
+    }
+
+    sink = (uint64_t)activeObject->state->name;
+    return (double)(nowNs() - start) / (double)iterations;
+}
+
+/* Staged dispatch of STAGE_EVENTS events to STAGE_TARGETS objects, flush and drain, per event */
+static double benchStage(uint64_t iterations) {
+    uint64_t sum = 0;
+    uint64_t start = nowNs();
+
+    for (uint64_t i = 0; i < iterations; i += STAGE_EVENTS) {
+        for (uint32_t j = 0; j < STAGE_EVENTS; j++) {
+            DispatchStage_Dispatch(&stage, &activeObjects[j % STAGE_TARGETS], (TEvent){.sig = TOGGLE_SIG});
+        }
+        DispatchStage_Flush(&stage);
+
+        for (uint32_t j = 0; j < STAGE_TARGETS; j++) {
+            while (!EventQueue_IsEmpty(&activeObjects[j].queue)) {
+                sum += (uint64_t)ActiveObject_ProcessQueue(&activeObjects[j]).sig;
+            }
+        }
+    }
+
+    sink = sum;
+    return (double)(nowNs() - start) / (double)iterations;
+}
+
+int main(int argc, char **argv) {
+    uint64_t iterations = argc > 1 ? strtoull(argv[1], NULL, 10) : 20000000ull;
+
+    if (0 == iterations) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    DispatchStage_Initialize(&stage, stageEntries, stageScratch, STAGE_EVENTS);
+
+    reset();
+    double queueNs = benchQueue(iterations);
+    reset();
+    double dispatchNs = benchDispatch(iterations);
+    reset();
+    double stageNs = benchStage(iterations);
+
+    printf("{\"iterations\": %llu, \"queueNs\": %.2f, \"dispatchNs\": %.2f, \"stageNs\": %.2f}\n",
+           (unsigned long long)iterations, queueNs, dispatchNs, stageNs);
+    return 0;
+}
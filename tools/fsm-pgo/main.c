@@ -0,0 +1,186 @@
+#include "stdio.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Profile-guided transition table remapping: reads the per-cell lookup counts of a transition table
+ * (FSM_AttachProfile in an FSM_PROFILE build) and emits state and signal renumbering maps,
+ * hottest rows and columns first, so the hot cells of FSM_RemapTransitionTable output share a few cache lines.
+ *
+ * Input, a file or stdin, '#' comments allowed:
+ *     <statesMax> <eventsMax>
+ *     <state> <sig> <hits>     one line per counted cell, missing cells have no hits
+ * Output: a C header with <prefix>StateMap and <prefix>SigMap on stdout, cache lines report on stderr. */
+
+#define INDEX_LIMIT             (65535u)
+#define CACHE_LINE_SIZE         (64u)
+#define COVERAGE                (0.99)
+
+typedef struct {
+    uint32_t index;
+    uint64_t hits;
+} RANKED;
+
+typedef struct {
+    uint32_t cell;
+    uint64_t hits;
+} CELL;
+
+uint32_t statesMax;
+uint32_t eventsMax;
+uint64_t *hits;
+uint16_t *stateMap;
+uint16_t *sigMap;
+
+static void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [--prefix NAME] [--cell-size BYTES] [profile.txt]\n", name);
+    exit(1);
+}
+
+/* Hottest first, the enum order among equals keeps the output stable */
+static int compareRanked(const void *a, const void *b) {
+    const RANKED *x = (const RANKED *)a;
+    const RANKED *y = (const RANKED *)b;
+
+    if (x->hits != y->hits) return x->hits > y->hits ? -1 : 1;
+    return x->index < y->index ? -1 : (x->index > y->index);
+}
+
+static int compareCells(const void *a, const void *b) {
+    const CELL *x = (const CELL *)a;
+    const CELL *y = (const CELL *)b;
+
+    if (x->hits != y->hits) return x->hits > y->hits ? -1 : 1;
+    return x->cell < y->cell ? -1 : (x->cell > y->cell);
+}
+
+static int readLine(FILE *input, char *line, size_t size) {
+    while (fgets(line, (int)size, input)) {
+        char *text = line + strspn(line, " \t");
+
+        if ('#' != *text && '\n' != *text && '\0' != *text) return 1;
+    }
+
+    return 0;
+}
+
+static void rank(uint32_t count, uint32_t stride, uint32_t step, uint32_t length, uint16_t *map) {
+    RANKED *ranked = calloc(count, sizeof(RANKED));
+
+    for (uint32_t i = 0; i < count; i++) {
+        ranked[i].index = i;
+        for (uint32_t j = 0; j < length; j++) ranked[i].hits += hits[i * stride + j * step];
+    }
+
+    qsort(ranked, count, sizeof(RANKED), compareRanked);
+    for (uint32_t i = 0; i < count; i++) map[ranked[i].index] = (uint16_t)i;
+
+    free(ranked);
+}
+
+/* Cache lines holding the hottest cells which cover COVERAGE of all lookups */
+static uint32_t countHotLines(uint32_t cellSize, int isRemapped) {
+    uint32_t cellsCount = statesMax * eventsMax;
+    uint32_t linesCount = (cellsCount * cellSize + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE;
+    CELL *cells = calloc(cellsCount, sizeof(CELL));
+    uint8_t *isTouched = calloc(linesCount, 1);
+    uint64_t total = 0;
+    uint64_t covered = 0;
+    uint32_t hotLines = 0;
+
+    for (uint32_t state = 0; state < statesMax; state++) {
+        for (uint32_t sig = 0; sig < eventsMax; sig++) {
+            CELL *cell = &cells[state * eventsMax + sig];
+
+            cell->cell = isRemapped ? (uint32_t)stateMap[state] * eventsMax + sigMap[sig] : state * eventsMax + sig;
+            cell->hits = hits[state * eventsMax + sig];
+            total += cell->hits;
+        }
+    }
+
+    qsort(cells, cellsCount, sizeof(CELL), compareCells);
+
+    for (uint32_t i = 0; i < cellsCount && covered < total * COVERAGE; i++) {
+        uint32_t line = cells[i].cell * cellSize / CACHE_LINE_SIZE;
+
+        if (!isTouched[line]) {
+            isTouched[line] = 1;
+            hotLines++;
+        }
+        covered += cells[i].hits;
+    }
+
+    free(isTouched);
+    free(cells);
+    return hotLines;
+}
+
+static void printMap(const char *prefix, const char *name, const uint16_t *map, uint32_t count) {
+    printf("static const uint16_t %s%s[%u] = {", prefix, name, count);
+    for (uint32_t i = 0; i < count; i++) printf("%s%u", i ? ", " : "", map[i]);
+    printf("};\n");
+}
+
+int main(int argc, char **argv) {
+    const char *prefix = "fsm";
+    const char *path = NULL;
+    uint32_t cellSize = (uint32_t)sizeof(void *);
+    char line[256];
+
+    for (int i = 1; i < argc; i++) {
+        if (0 == strcmp(argv[i], "--prefix") && i + 1 < argc) prefix = argv[++i];
+        else if (0 == strcmp(argv[i], "--cell-size") && i + 1 < argc) cellSize = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if ('-' == argv[i][0] || path) usage(argv[0]);
+        else path = argv[i];
+    }
+
+    FILE *input = path ? fopen(path, "r") : stdin;
+
+    if (NULL == input || 0 == cellSize) usage(argv[0]);
+
+    if (!readLine(input, line, sizeof(line)) || 2 != sscanf(line, "%u %u", &statesMax, &eventsMax)
+        || 0 == statesMax || 0 == eventsMax || statesMax > INDEX_LIMIT || eventsMax > INDEX_LIMIT) {
+        fprintf(stderr, "Invalid table size, expected \"<statesMax> <eventsMax>\" up to %u\n", INDEX_LIMIT);
+        return 1;
+    }
+
+    hits = calloc((size_t)statesMax * eventsMax, sizeof(uint64_t));
+    stateMap = calloc(statesMax, sizeof(uint16_t));
+    sigMap = calloc(eventsMax, sizeof(uint16_t));
+
+    while (readLine(input, line, sizeof(line))) {
+        uint32_t state;
+        uint32_t sig;
+        unsigned long long count;
+
+        if (3 != sscanf(line, "%u %u %llu", &state, &sig, &count) || state >= statesMax || sig >= eventsMax) {
+            fprintf(stderr, "Invalid cell: %s", line);
+            return 1;
+        }
+
+        hits[state * eventsMax + sig] += count;
+    }
+
+    if (path) fclose(input);
+
+    rank(statesMax, eventsMax, 1, eventsMax, stateMap);
+    rank(eventsMax, 1, eventsMax, statesMax, sigMap);
+
+    uint32_t linesBefore = countHotLines(cellSize, 0);
+    uint32_t linesAfter = countHotLines(cellSize, 1);
+
+    printf("/* Generated by tools/fsm-pgo from a %u x %u transition table profile:\n", statesMax, eventsMax);
+    printf(" * %.0f%% of lookups hit %u cache lines of the remapped table, %u of the original one.\n", COVERAGE * 100, linesAfter, linesBefore);
+    printf(" * Use with FSM_RemapTransitionTable and FSM_ProcessEventToNextStateFromRemappedTable. */\n\n");
+    printf("#include <stdint.h>\n\n");
+    printMap(prefix, "StateMap", stateMap, statesMax);
+    printMap(prefix, "SigMap", sigMap, eventsMax);
+
+    fprintf(stderr, "{\"states\": %u, \"events\": %u, \"hotLinesBefore\": %u, \"hotLinesAfter\": %u}\n",
+            statesMax, eventsMax, linesBefore, linesAfter);
+
+    free(sigMap);
+    free(stateMap);
+    free(hits);
+    return 0;
+}
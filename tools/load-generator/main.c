@@ -0,0 +1,301 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "stdio.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+#include "../../src/active_object/active_object.h"
+#include "../../src/fsm/fsm.h"
+
+/* Open-loop load generator: drives a configurable topology of Active Objects at a target rate
+ * and reports throughput, latency percentiles and drops as JSON.
+ *
+ * Events are scheduled at fixed intervals regardless of the processing progress (open loop),
+ * latency is measured from the scheduled time, so a stalled consumer doesn't hide its own delay. */
+
+#define STATES_LIMIT            (64)
+#define EVENTS_LIMIT            (64)
+
+/* HDR-style log-linear histogram: values below 2^HISTOGRAM_SUB_BITS are exact,
+ * larger values keep HISTOGRAM_SUB_BITS - 1 significant bits (< 1.6% error) */
+#define HISTOGRAM_SUB_BITS      (7)
+#define HISTOGRAM_SUB_COUNT     (1u << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_HALF_COUNT    (HISTOGRAM_SUB_COUNT / 2)
+#define HISTOGRAM_VALUE_BITS    (48)
+#define HISTOGRAM_BUCKETS       (HISTOGRAM_SUB_COUNT + (HISTOGRAM_VALUE_BITS - HISTOGRAM_SUB_BITS) * HISTOGRAM_HALF_COUNT)
+
+typedef struct {
+    uint32_t objects;       /**< Active Objects number */
+    uint32_t states;        /**< States per machine, including the entry state */
+    uint32_t events;        /**< Event signals per machine, including NO_SIG */
+    uint32_t queue;         /**< Queue capacity per object */
+    uint32_t fanout;        /**< Events dispatched to other objects by every produced event */
+    uint64_t hookNs;        /**< Busy work of every onEnter/onTraverse hook */
+    uint64_t rate;          /**< Produced events per second */
+    double duration;        /**< Production time, seconds */
+} LOAD_CONFIG;
+
+typedef struct {
+    uint64_t scheduledNs;   /**< Intended send time of the originating event */
+    uint32_t hops;          /**< 0 for produced events, 1 for fan-out events */
+} EVENT_STAMP;
+
+typedef struct {
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t total;
+    uint64_t max;
+    double sum;
+} HISTOGRAM;
+
+LOAD_CONFIG config = {
+    .objects = 1000, .states = 8, .events = 16, .queue = 16, .fanout = 0, .hookNs = 0, .rate = 100000, .duration = 5.0,
+};
+
+TState statesList[STATES_LIMIT];
+TEventHandler transitionTable[STATES_LIMIT * EVENTS_LIMIT]; // [states][events], row stride config.events
+
+TActiveObject *activeObjects;
+TEvent *eventArrays;
+EVENT_STAMP *stamps;        // [objects][queue], stamp of the event in the same queue slot
+uint32_t *readyObjects;     // FIFO ring of objects with pending events
+uint8_t *isReady;
+uint32_t readyHead, readyCount;
+
+HISTOGRAM histogram;
+uint64_t produced, dropped, fanoutDropped, processed;
+uint64_t randomState = 0x9E3779B97F4A7C15ull;
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t nextRandom(uint32_t bound) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return (uint32_t)((randomState >> 32) * bound >> 32);
+}
+
+static uint32_t histogramIndex(uint64_t value) {
+    if (value < HISTOGRAM_SUB_COUNT) return (uint32_t)value;
+
+    uint32_t msb = 63u - (uint32_t)__builtin_clzll(value);
+    if (msb >= HISTOGRAM_VALUE_BITS) return HISTOGRAM_BUCKETS - 1;
+
+    uint32_t shift = msb - (HISTOGRAM_SUB_BITS - 1);
+    return HISTOGRAM_SUB_COUNT + (shift - 1) * HISTOGRAM_HALF_COUNT + (uint32_t)(value >> shift) - HISTOGRAM_HALF_COUNT;
+}
+
+/* Middle of the bucket value range */
+static uint64_t histogramValue(uint32_t index) {
+    if (index < HISTOGRAM_SUB_COUNT) return index;
+
+    uint32_t shift = (index - HISTOGRAM_SUB_COUNT) / HISTOGRAM_HALF_COUNT + 1;
+    uint64_t sub = (index - HISTOGRAM_SUB_COUNT) % HISTOGRAM_HALF_COUNT + HISTOGRAM_HALF_COUNT;
+    return (sub << shift) + (1ull << (shift - 1));
+}
+
+static void histogramRecord(HISTOGRAM *h, uint64_t value) {
+    h->counts[histogramIndex(value)]++;
+    h->total++;
+    h->sum += (double)value;
+    if (value > h->max) h->max = value;
+}
+
+static uint64_t histogramPercentile(const HISTOGRAM *h, double percentile) {
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)h->total + 0.5);
+    uint64_t seen = 0;
+
+    if (0 == rank) rank = 1;
+    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) return histogramValue(i) < h->max ? histogramValue(i) : h->max;
+    }
+    return h->max;
+}
+
+static void spin(uint64_t ns) {
+    if (0 == ns) return;
+
+    uint64_t until = nowNs() + ns;
+    while (nowNs() < until) {}
+}
+
+static bool workHook(TActiveObject *const activeObject, void *const ctx) {
+    spin(config.hookNs);
+    return true;
+}
+
+static void markReady(uint32_t object) {
+    if (isReady[object]) return;
+
+    isReady[object] = 1;
+    readyObjects[(readyHead + readyCount++) % config.objects] = object;
+}
+
+/* Stamps the event into the slot it will occupy, so the stamp lives exactly as long as the queued event */
+static bool dispatchStamped(uint32_t object, int sig, EVENT_STAMP stamp) {
+    TActiveObject *activeObject = &activeObjects[object];
+
+    if (EventQueue_IsFull(&activeObject->queue)) return false;
+
+    uint32_t slot = (uint32_t)(activeObject->queue.rear + 1) % activeObject->queue.capacity;
+    EVENT_STAMP *eventStamp = &stamps[(size_t)object * config.queue + slot];
+
+    *eventStamp = stamp;
+    ActiveObject_Dispatch(activeObject, (TEvent){.sig = sig, .payload = eventStamp, .size = sizeof(EVENT_STAMP)});
+    markReady(object);
+    return true;
+}
+
+/* Moves to a pseudo-random state, produced events fan out to other objects */
+static const TState *loadHandler(TActiveObject *const activeObject, TEvent event) {
+    EVENT_STAMP stamp = *(EVENT_STAMP *)event.payload;
+
+    if (0 == stamp.hops && config.objects > 1) {
+        stamp.hops = 1;
+        for (uint32_t i = 0; i < config.fanout; i++) {
+            uint32_t target = (activeObject->id + 1 + nextRandom(config.objects - 1)) % config.objects;
+            if (!dispatchStamped(target, 1 + (int)nextRandom(config.events - 1), stamp)) fanoutDropped++;
+        }
+    }
+
+    return &statesList[1 + (activeObject->state->name + event.sig) % (config.states - 1)];
+}
+
+static void buildTopology(void) {
+    for (uint32_t state = 0; state < config.states; state++) {
+        statesList[state] = (TState){.name = (int)state, .onEnter = workHook, .onTraverse = workHook};
+        for (uint32_t sig = 1; sig < config.events; sig++) {
+            transitionTable[state * config.events + sig] = loadHandler;
+        }
+    }
+
+    activeObjects = calloc(config.objects, sizeof(TActiveObject));
+    eventArrays = calloc((size_t)config.objects * config.queue, sizeof(TEvent));
+    stamps = calloc((size_t)config.objects * config.queue, sizeof(EVENT_STAMP));
+    readyObjects = calloc(config.objects, sizeof(uint32_t));
+    isReady = calloc(config.objects, sizeof(uint8_t));
+
+    if (!activeObjects || !eventArrays || !stamps || !readyObjects || !isReady) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    for (uint32_t i = 0; i < config.objects; i++) {
+        ActiveObject_Initialize(&activeObjects[i], i, &eventArrays[(size_t)i * config.queue], config.queue);
+        activeObjects[i].state = &statesList[1];
+    }
+}
+
+/* Processes one event of the next ready object */
+static void processNext(void) {
+    uint32_t object = readyObjects[readyHead];
+    TActiveObject *activeObject = &activeObjects[object];
+
+    readyHead = (readyHead + 1) % config.objects;
+    readyCount--;
+    isReady[object] = 0;
+
+    TEvent event = ActiveObject_ProcessQueue(activeObject);
+    uint64_t scheduledNs = ((EVENT_STAMP *)event.payload)->scheduledNs;
+
+    const TState *nextState = FSM_ProcessEventToNextStateFromTransitionTable(
+            activeObject, event, config.states, config.events,
+            (const TEventHandler (*)[config.events])transitionTable);
+
+    if (FSM_IsValidState(nextState)) FSM_TraverseAOToNextState(activeObject, nextState);
+
+    histogramRecord(&histogram, nowNs() - scheduledNs);
+    processed++;
+
+    if (!EventQueue_IsEmpty(&activeObject->queue)) markReady(object);
+}
+
+static void run(void) {
+    const double periodNs = 1e9 / (double)config.rate;
+    const uint64_t startNs = nowNs();
+    const uint64_t stopNs = startNs + (uint64_t)(config.duration * 1e9);
+    uint64_t nextScheduledNs = startNs;
+
+    for (;;) {
+        uint64_t now = nowNs();
+
+        // Open loop: produce everything due by now, late events keep their intended send time
+        while (nextScheduledNs <= now && nextScheduledNs < stopNs) {
+            EVENT_STAMP stamp = {.scheduledNs = nextScheduledNs, .hops = 0};
+
+            if (!dispatchStamped(nextRandom(config.objects), 1 + (int)nextRandom(config.events - 1), stamp)) dropped++;
+            produced++;
+            nextScheduledNs = startNs + (uint64_t)((double)produced * periodNs);
+        }
+
+        if (readyCount) {
+            processNext();
+        } else if (nextScheduledNs >= stopNs) {
+            break;
+        }
+    }
+
+    double elapsedSec = (double)(nowNs() - startNs) / 1e9;
+
+    printf("{\n");
+    printf("  \"config\": {\"objects\": %u, \"states\": %u, \"events\": %u, \"queue\": %u, \"fanout\": %u, "
+           "\"hookNs\": %llu, \"rate\": %llu, \"duration\": %.3f},\n",
+           config.objects, config.states, config.events, config.queue, config.fanout,
+           (unsigned long long)config.hookNs, (unsigned long long)config.rate, config.duration);
+    printf("  \"produced\": %llu,\n", (unsigned long long)produced);
+    printf("  \"dropped\": %llu,\n", (unsigned long long)dropped);
+    printf("  \"fanoutDropped\": %llu,\n", (unsigned long long)fanoutDropped);
+    printf("  \"processed\": %llu,\n", (unsigned long long)processed);
+    printf("  \"elapsedSec\": %.3f,\n", elapsedSec);
+    printf("  \"throughput\": %.0f,\n", (double)processed / elapsedSec);
+    printf("  \"latencyNs\": {\"mean\": %.0f, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}\n",
+           histogram.total ? histogram.sum / (double)histogram.total : 0.0,
+           (unsigned long long)histogramPercentile(&histogram, 50.0),
+           (unsigned long long)histogramPercentile(&histogram, 90.0),
+           (unsigned long long)histogramPercentile(&histogram, 99.0),
+           (unsigned long long)histogramPercentile(&histogram, 99.9),
+           (unsigned long long)histogram.max);
+    printf("}\n");
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [--objects N] [--states N] [--events N] [--queue N] [--fanout N] "
+                    "[--hook-ns NS] [--rate EVENTS_PER_SEC] [--duration SEC]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) usage(argv[0]);
+
+        const char *option = argv[i];
+        const char *value = argv[i + 1];
+
+        if (0 == strcmp(option, "--objects")) config.objects = (uint32_t)strtoul(value, NULL, 10);
+        else if (0 == strcmp(option, "--states")) config.states = (uint32_t)strtoul(value, NULL, 10);
+        else if (0 == strcmp(option, "--events")) config.events = (uint32_t)strtoul(value, NULL, 10);
+        else if (0 == strcmp(option, "--queue")) config.queue = (uint32_t)strtoul(value, NULL, 10);
+        else if (0 == strcmp(option, "--fanout")) config.fanout = (uint32_t)strtoul(value, NULL, 10);
+        else if (0 == strcmp(option, "--hook-ns")) config.hookNs = strtoull(value, NULL, 10);
+        else if (0 == strcmp(option, "--rate")) config.rate = strtoull(value, NULL, 10);
+        else if (0 == strcmp(option, "--duration")) config.duration = strtod(value, NULL);
+        else usage(argv[0]);
+    }
+
+    if (0 == config.objects || config.states < 2 || config.states > STATES_LIMIT
+        || config.events < 2 || config.events > EVENTS_LIMIT || 0 == config.queue
+        || 0 == config.rate || config.duration <= 0.0) {
+        usage(argv[0]);
+    }
+
+    buildTopology();
+    run();
+
+    return 0;
+}